@@ -0,0 +1,137 @@
+# CheckBestServer.py - Checks a best-server report against separate runs for each of its transmitters.
+#
+# The best-server input file is run once as it is and once for each transmitter TXn with the TXn parameters made the
+# single path transmitter (Path.L_tx, Path.txpower, TXAntFilePath, TXBearing and TXGOS). Each row of the best-server
+# report must then be the same, in every column other than TX and Margin, as the row for the same month, hour,
+# frequency and receiver in the run for its best server. This includes the dominant mode columns. The best server must
+# have the highest printed SNR of the transmitters and the margin must be its SNR above the next best, to within a
+# rounding of the printed values. Any ITURHFProp options after the work directory, e.g. -j 4, are given to every run.
+# On Linux from this directory
+#   python3 CheckBestServer.py ../Linux/ITURHFProp bestserver.in BestServer -j 4
+#
+# The exit status is 1 if any row fails.
+
+import sys
+import os
+import subprocess
+
+def ReadReport(filename):
+	# Returns the column names and the rows of the calculated parameters of a report
+	columns = []
+	rows = []
+	incalc = False
+	with open(filename, 'r', encoding='latin-1') as fp:
+		for line in fp:
+			line = line.strip()
+			if line.startswith('Column '):
+				columns.append(line.split(':', 1)[1].strip())
+			elif 'End Calculated Parameters' in line:
+				incalc = False
+			elif 'Calculated Parameters' in line:
+				incalc = True
+			elif incalc and line != '':
+				rows.append([v.strip() for v in line.split(',')])
+	return columns, rows
+
+def SingleInput(lines, n):
+	# Returns the input file lines for transmitter n alone
+	tx = {}
+	for line in lines:
+		words = line.split(None, 1)
+		if len(words) == 2 and words[0].startswith('TX%d.' % n):
+			tx[words[0][len('TX%d.' % n):]] = words[1].rstrip('\n')
+	single = {'lat': 'Path.L_tx.lat', 'lng': 'Path.L_tx.lng', 'txpower': 'Path.txpower', 'Name': 'PathTXName',
+		'AntFilePath': 'TXAntFilePath', 'Bearing': 'TXBearing', 'GOS': 'TXGOS'}
+	out = []
+	for line in lines:
+		words = line.split(None, 1)
+		if len(words) > 0 and words[0].startswith('TX') and words[0][2:3].isdigit():
+			continue
+		if len(words) > 0 and words[0] in [single[k] for k in tx if k in single]:
+			continue
+		out.append(line)
+	for k in tx:
+		if k in single:
+			out.append('%s %s\n' % (single[k], tx[k]))
+	return out
+
+def Run(program, options, infile, outfile):
+	# Runs ITURHFProp and returns its exit status
+	return subprocess.call([program, '-s'] + options + [infile, outfile], stdout=subprocess.DEVNULL)
+
+def LastDigit(value):
+	# One unit in the last printed digit of value, e.g. 0.01 for "45.45"
+	if '.' in value:
+		return 10.0**-len(value.split('.')[1])
+	return 1.0
+
+if len(sys.argv) < 4:
+	print('Usage: CheckBestServer.py ITURHFProp BestServerInput WorkDirectory [ITURHFProp options]')
+	sys.exit(2)
+
+program = os.path.abspath(sys.argv[1])
+infile = sys.argv[2]
+workdir = sys.argv[3]
+options = sys.argv[4:]
+
+with open(infile, 'r', encoding='latin-1') as fp:
+	lines = fp.readlines()
+
+ntx = 0
+for line in lines:
+	if line.startswith('TX') and line[2:3].isdigit():
+		ntx = max(ntx, int(line[2:].split('.')[0]))
+if ntx < 2:
+	print('%s has no best-server transmitters' % infile)
+	sys.exit(2)
+
+os.makedirs(workdir, exist_ok=True)
+name = os.path.splitext(os.path.basename(infile))[0]
+
+# The best-server run and one run for each transmitter
+bsout = os.path.join(workdir, name + '.out')
+if Run(program, options, infile, bsout) != 0:
+	print('%s: The best-server run failed' % name)
+	sys.exit(1)
+bscols, bsrows = ReadReport(bsout)
+
+txrows = []
+for n in range(1, ntx + 1):
+	txin = os.path.join(workdir, '%s_tx%d.in' % (name, n))
+	txout = os.path.join(workdir, '%s_tx%d.out' % (name, n))
+	with open(txin, 'w', encoding='latin-1') as fp:
+		fp.writelines(SingleInput(lines, n))
+	if Run(program, options, txin, txout) != 0:
+		print('%s: The run for TX%d failed' % (name, n))
+		sys.exit(1)
+	txcols, rows = ReadReport(txout)
+	if (txcols != bscols[:3] + bscols[5:]) or (len(rows) != len(bsrows)):
+		print('%s: The report for TX%d has different columns or rows' % (name, n))
+		sys.exit(1)
+	txrows.append(rows)
+
+snr = bscols.index('SNR - Median signal-to-noise ratio (dB)') - 2
+
+nfail = 0
+for r, bsrow in enumerate(bsrows):
+	tx = int(bsrow[3]) - 1
+	margin = float(bsrow[4])
+	row = bsrow[:3] + bsrow[5:]
+	fail = []
+	if row != txrows[tx][r]:
+		fail.append('differs from TX%d in columns %s' % (tx + 1,
+			' '.join('%02d' % (i + 3 if i >= 3 else i + 1) for i in range(len(row)) if row[i] != txrows[tx][r][i])))
+	best = float(row[snr])
+	nextbest = max((float(txrows[t][r][snr]), t) for t in range(ntx) if t != tx)
+	tol = 2.0*LastDigit(bsrow[4])*1.000001
+	if best < nextbest[0] - tol:
+		fail.append('TX%d has a lower SNR than TX%d' % (tx + 1, nextbest[1] + 1))
+	if abs(margin - (best - nextbest[0])) > tol:
+		fail.append('the margin %s is not the SNR above the next best %.2f' % (bsrow[4], best - nextbest[0]))
+	if len(fail) > 0:
+		nfail += 1
+		if nfail <= 20:
+			print('%s: Row %d (%s): %s' % (name, r + 1, ', '.join(bsrow[:3] + bsrow[5:7]), '; '.join(fail)))
+
+print('%s: %d rows of %d transmitters checked, %d fail' % (name, len(bsrows), ntx, nfail))
+sys.exit(1 if nfail > 0 else 0)
@@ -0,0 +1,70 @@
+#!/bin/bash
+# CompareFastDB.sh - Compares the reports of the exact build and the FASTDB build (See Common.h) for every *.in case here.
+#
+# The libraries and ITURHFProp are built from ../../Linux without FASTDB, every *.in file in this directory is run into
+# WorkDirectory/Exact, everything is built again with FASTDB=1 and the cases are run into WorkDirectory/Fast. The exact
+# build is then put back and CompareReports.py compares the two sets of reports. On Linux from this directory
+#   ./CompareFastDB.sh [DataFilePath [WorkDirectory]]
+#
+# DataFilePath replaces the DataFilePath of every case, e.g. for a directory that has the ionosXX.bin files. By default
+# the cases use their own. WorkDirectory is FastDB by default. "make fastdb-check" in ../../Linux runs this script with
+# DATADIR as the DataFilePath. The exit status is 1 if a case fails to run or if a report fails the comparison.
+
+bindir=$(cd "$(dirname "$0")" && pwd)
+linuxdir=$(cd "$bindir/../../Linux" && pwd)
+
+datadir=$1
+workdir=${2:-FastDB}
+
+if [ -n "$datadir" ]; then
+	datadir=$(cd "$datadir" && pwd)/ || exit 2
+fi
+
+cd "$bindir" || exit 2
+mkdir -p "$workdir" || exit 2
+workdir=$(cd "$workdir" && pwd)
+
+export LD_LIBRARY_PATH=$bindir/../../P533/Linux:$bindir/../../P372/Linux${LD_LIBRARY_PATH:+:$LD_LIBRARY_PATH}
+export DYLD_LIBRARY_PATH=$bindir/../../P533/Linux:$bindir/../../P372/Linux${DYLD_LIBRARY_PATH:+:$DYLD_LIBRARY_PATH}
+
+# Builds everything with FASTDB set to $1
+Build() {
+	echo "CompareFastDB: Building with FASTDB=$1"
+	(cd "$linuxdir" && make clean >/dev/null && make all FASTDB=$1 >/dev/null)
+}
+
+# Runs every case into the directory $1. The cases are run from this directory so that their antenna files are found.
+RunCases() {
+	local failed=0
+	local f n in
+
+	mkdir -p "$1"
+	for f in *.in; do
+		n=${f%.in}
+		in=$f
+		if [ -n "$datadir" ]; then
+			in=$workdir/$f
+			sed -E "s|^DataFilePath[[:space:]].*|DataFilePath \"$datadir\"|" "$f" > "$in"
+		fi
+		if ! ../Linux/ITURHFProp -s "$in" "$1/$n.out" > "$1/$n.log" 2>&1; then
+			echo "CompareFastDB: $f failed (See $1/$n.log)"
+			failed=1
+		fi
+	done
+	return $failed
+}
+
+status=0
+
+Build 0 || exit 1
+RunCases "$workdir/Exact" || status=1
+
+Build 1 || status=1
+[ $status -eq 0 ] && { RunCases "$workdir/Fast" || status=1; }
+
+# Put the exact build back whatever happened above
+Build 0 || exit 1
+
+[ $status -eq 0 ] || exit 1
+
+python3 CompareReports.py "$workdir/Exact" "$workdir/Fast"
@@ -0,0 +1,104 @@
+# CompareReports.py - Compares every output column of the ITURHFProp reports in two directories.
+#
+# This is the regression check for the FASTDB build (See Common.h). Run the *.in cases in this directory with the
+# exact build and with the FASTDB build, each into its own directory, then compare the two. CompareFastDB.sh, or
+# "make fastdb-check" in ../../Linux, does all of this. By hand on Linux from this directory
+#   (cd ../../Linux && make clean && make all)
+#   mkdir -p Exact && for f in *.in; do ../Linux/ITURHFProp -s $f Exact/${f%.in}.out; done
+#   (cd ../../Linux && make clean && make all FASTDB=1)
+#   mkdir -p Fast && for f in *.in; do ../Linux/ITURHFProp -s $f Fast/${f%.in}.out; done
+#   python3 CompareReports.py Exact Fast
+#
+# For each report both directories have, the calculated parameters are compared value by value. A value passes when
+# it is within one unit in the last printed digit of the exact value, i.e. the two builds differ by at most a rounding
+# of the printed value. The largest difference in each column of each report is printed. The exit status is 1 if any
+# value fails or if the reports do not have the same columns and rows.
+
+import sys
+import os
+import math
+
+def ReadReport(filename):
+	# Returns the column names and the rows of the calculated parameters of a report
+	columns = []
+	rows = []
+	incalc = False
+	with open(filename, 'r', encoding='latin-1') as fp:
+		for line in fp:
+			line = line.strip()
+			if line.startswith('Column '):
+				columns.append(line.split(':', 1)[1].strip())
+			elif 'End Calculated Parameters' in line:
+				incalc = False
+			elif 'Calculated Parameters' in line:
+				incalc = True
+			elif incalc and line != '':
+				rows.append([v.strip() for v in line.split(',')])
+	return columns, rows
+
+def LastDigit(value):
+	# One unit in the last printed digit of value, e.g. 0.01 for "45.45"
+	if '.' in value:
+		return 10.0**-len(value.split('.')[1])
+	return 1.0
+
+def CompareReports(exactfile, fastfile):
+	# Prints the largest difference in each column and returns the number of values that fail
+	excols, exrows = ReadReport(exactfile)
+	fscols, fsrows = ReadReport(fastfile)
+
+	name = os.path.basename(exactfile)
+	if (excols != fscols) or (len(exrows) != len(fsrows)):
+		print('%s: The reports have different columns or rows (%d and %d rows)' % (name, len(exrows), len(fsrows)))
+		return 1
+
+	maxdiff = [0.0]*len(excols)
+	ndiff = [0]*len(excols)
+	nfail = 0
+	for exrow, fsrow in zip(exrows, fsrows):
+		if len(exrow) != len(fsrow):
+			nfail += 1
+			continue
+		for i, (ex, fs) in enumerate(zip(exrow, fsrow)):
+			if ex == fs:
+				continue
+			col = min(i, len(excols) - 1)
+			ndiff[col] += 1
+			try:
+				x = float(ex)
+				y = float(fs)
+			except ValueError:
+				nfail += 1
+				continue
+			if math.isnan(x) or math.isnan(y) or math.isinf(x) or math.isinf(y):
+				nfail += 1
+				continue
+			d = abs(x - y)
+			maxdiff[col] = max(maxdiff[col], d)
+			if d > LastDigit(ex)*1.000001:
+				nfail += 1
+
+	print('%s: %d rows, %d values differ, %d fail' % (name, len(exrows), sum(ndiff), nfail))
+	for i in range(len(excols)):
+		if ndiff[i] > 0:
+			print('    %-60s %8d differ  max %g' % (excols[i][:60], ndiff[i], maxdiff[i]))
+	return nfail
+
+if len(sys.argv) != 3:
+	print('Usage: CompareReports.py ExactDirectory FastDirectory')
+	sys.exit(2)
+
+exactdir = sys.argv[1]
+fastdir = sys.argv[2]
+
+reports = sorted(f for f in os.listdir(exactdir) if f.endswith('.out') and os.path.isfile(os.path.join(fastdir, f)))
+if len(reports) == 0:
+	print('There are no reports to compare in %s and %s' % (exactdir, fastdir))
+	sys.exit(2)
+
+failed = 0
+for report in reports:
+	failed += CompareReports(os.path.join(exactdir, report), os.path.join(fastdir, report))
+
+print('%d reports compared, %d values fail' % (len(reports), failed))
+sys.exit(1 if failed > 0 else 0)
@@ -6,4 +6,6 @@ ITURHFProp.exe 164-1-78.in 164-1-78.out
 ITURHFProp.exe itu_old22012020.in itu_old22012020.out
 ITURHFProp.exe sydney_201805_10_31_B4.in sydney_201805_10_31_B4.out
 ITURHFProp.exe moscow_201805_10_31_B4.in moscow_201805_10_31_B4.out
-ITURHFProp.exe itu_old.in itu_old.out
\ No newline at end of file
+ITURHFProp.exe itu_old.in itu_old.out
+ITURHFProp.exe bestserver.in bestserver.out
+ITURHFProp.exe longpath_neartx.in longpath_neartx.out
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include <float.h>
+
 // #defines
 
 // Operating system preprocessor directives
@@ -23,16 +25,62 @@
 #define TINYDB DBL_MIN_10_EXP // Smallest number in dB
 #define TOOBIG DBL_MAX // Large number typically an error 
 
-// Double extreme
-#define DBL_MANT_DIG 53
-#define DBL_DIG 15
-#define DBL_MIN_EXP -1021
-#define DBL_MIN_10_EXP -307
-#define DBL_MAX_EXP 1024
-#define DBL_MAX_10_EXP 308
-#define DBL_MAX 1.7976931348623157E+308
-#define DBL_MIN 2.2250738585072014E-308
-#define DBL_EPSILON 2.2204460492503131E-016
+// The double extremes DBL_MAX, DBL_MIN, DBL_EPSILON, etc. are from float.h
+
+// dB and power ratio conversions
+// Build with FASTDB defined ("make FASTDB=1") to replace pow(10, dB/10), 10*log10(), exp() and log() in the power sums
+// with the inline approximations FastExp2() and FastLog2() below. These make no library calls for normal inputs so the
+// compiler can vectorise loops of them. The largest relative error of FastExp2() is 7E-9 (3E-8 dB in DB2RATIO()) and the
+// largest absolute error of FastLog2() is 3E-11 (1E-10 dB in RATIO2DB()). FastExp2() clamps its result to 2^-1022 to
+// 2^1023 (about -3077 to 3079 dB). Otherwise the macros are the exact library calls.
+// ITURHFProp/Bin/CompareReports.py compares the reports of the two builds.
+#define LOG2_10 3.32192809488736234787	// log2(10)
+#define LOG2_E 1.44269504088896340736	// log2(e)
+#define LN_2 0.69314718055994530942		// ln(2)
+#ifdef FASTDB
+	#include <math.h>
+	#include <stdint.h>
+
+	#define DB2RATIO(dB) FastExp2((dB)*(LOG2_10/10.0))	// pow(10.0, dB/10.0)
+	#define RATIO2DB(r) ((10.0/LOG2_10)*FastLog2(r))	// 10.0*log10(r)
+	#define EXPDB(x) FastExp2((x)*LOG2_E)				// exp(x)
+	#define LOGDB(x) (LN_2*FastLog2(x))				// log(x)
+
+	static inline double FastExp2(double x) {
+		// 2^x as 2^n times a polynomial for 2^f with n the nearest integer to x and |f| <= 0.5
+		union {double d; int64_t i;} u;
+		double n, f;
+
+		x = (x < -1022.0) ? -1022.0 : ((x > 1023.0) ? 1023.0 : x);
+		n = (x + 6755399441055744.0) - 6755399441055744.0; // Round to the nearest integer (1.5*2^52)
+		f = (x - n)*LN_2;
+		u.i = ((int64_t)n + 1023) << 52;
+		return u.d*(1.0 + f*(1.0 + f*(1.0/2.0 + f*(1.0/6.0 + f*(1.0/24.0 + f*(1.0/120.0 + f*(1.0/720.0 + f*(1.0/5040.0))))))));
+	}
+
+	static inline double FastLog2(double x) {
+		// log2(x) as the exponent e plus 2*atanh(s)/ln(2) with s = (m - 1)/(m + 1) for the mantissa sqrt(1/2) <= m < sqrt(2)
+		union {double d; int64_t i;} u;
+		double e, s, s2;
+
+		if(!((x >= DBL_MIN) && (x <= DBL_MAX))) return log2(x); // Zero, negative, subnormal, infinite or NaN
+		u.d = x;
+		e = (double)((u.i >> 52) - 1023);
+		u.i = (u.i & 0x000FFFFFFFFFFFFFLL) | 0x3FF0000000000000LL;
+		if(u.d > 1.41421356237309504880) {
+			u.d *= 0.5;
+			e += 1.0;
+		}
+		s = (u.d - 1.0)/(u.d + 1.0);
+		s2 = s*s;
+		return e + (2.0/LN_2)*s*(1.0 + s2*(1.0/3.0 + s2*(1.0/5.0 + s2*(1.0/7.0 + s2*(1.0/9.0 + s2*(1.0/11.0))))));
+	}
+#else
+	#define DB2RATIO(dB) pow(10.0, (dB)/10.0)
+	#define RATIO2DB(r) (10.0*log10(r))
+	#define EXPDB(x) exp(x)
+	#define LOGDB(x) log(x)
+#endif
 
 //////////////////////////////////////////////////////////////////////////////
 //      Copyright  International Telecommunication Union (ITU) 2018         //
@@ -24,6 +24,8 @@ char mod[512];
 	cP533Info dllP533Version;
 	cP533Info dllP533CompileTime;
 	iP533 dllP533;
+	iP533 dllP533Prepare;
+	iP533Frequency dllP533Frequency;
 	iPathMemory dllAllocatePathMemory;
 	iPathMemory dllFreePathMemory;
 	dBearing dllBearing;
@@ -34,6 +36,8 @@ char mod[512];
 	char * (*dllP533Version)();
 	char * (*dllP533CompileTime)();
 	int (*dllP533)(struct PathData *);
+	int (*dllP533Prepare)(struct PathData *);
+	int (*dllP533Frequency)(struct PathData *, struct PathData const *, double);
 	int (*dllAllocatePathMemory)(struct PathData *);
 	int (*dllFreePathMemory)(struct PathData *);
 	double (*dllBearing)(struct Location,struct Location,int direction);
@@ -75,6 +79,7 @@ int main(int argc, char *argv[]) {
 	 */
 
 	int retval;	// Return value
+	int i;
 
 	struct PathData path;		// The structure that describes the path to calculate in P533().
 	struct ITURHFProp ITURHFP;	// The structure that describes the number and types of runs of P533() in the user defined analysis.
@@ -89,6 +94,11 @@ int main(int argc, char *argv[]) {
 	ITURHFP.silent = FALSE;
 	ITURHFP.header = TRUE;
 	ITURHFP.csvRFC4180 = FALSE;
+	ITURHFP.threads = 1;
+	ITURHFP.resident = FALSE;
+	ITURHFP.antcache = FALSE;
+	ITURHFP.prepared = NULL;
+	ITURHFP.pool = NULL;
 	InFilePath[0] = EMPTY;
 	OutFileName[0] = EMPTY;
 	OutFilePath[0] = EMPTY;
@@ -114,6 +124,9 @@ int main(int argc, char *argv[]) {
 	dllP533CompileTime = (cP533Info)GetProcAddress((HMODULE)hLib, "P533CompileTime");
 	// Get the function P533() from the DLL.
 	dllP533 = (iP533)GetProcAddress((HMODULE)hLib, "P533");
+	// Get the functions P533Prepare() and P533Frequency() from the DLL.
+	dllP533Prepare = (iP533)GetProcAddress((HMODULE)hLib, "P533Prepare");
+	dllP533Frequency = (iP533Frequency)GetProcAddress((HMODULE)hLib, "P533Frequency");
 	// Get the function AllocatePathMemory() from the DLL.
 	dllAllocatePathMemory = (iPathMemory)GetProcAddress((HMODULE)hLib, "AllocatePathMemory");
 	// Get the function FreePathMemory() from the DLL.
@@ -127,9 +140,17 @@ int main(int argc, char *argv[]) {
 	dllReadType13Func = (iReadType13Func)GetProcAddress((HMODULE)hLib,"ReadType13");
 	dllReadType14Func = (iReadType14Func)GetProcAddress((HMODULE)hLib,"ReadType14");
 	dllIsotropicPatternFunc = (vIsotropicPatternFunc)GetProcAddress((HMODULE)hLib,"IsotropicPattern");
+	dllRegisterAntennaFunc = (iRegisterAntennaFunc)GetProcAddress((HMODULE)hLib,"RegisterAntenna");
+	dllFreeAntennaRegistryFunc = (vFreeAntennaRegistryFunc)GetProcAddress((HMODULE)hLib,"FreeAntennaRegistry");
 //	dllReadFamDudFunc = (ReadFamDudFunc)GetProcAddress((HMODULE)hLib,"ReadFamDud");
 	dllReadIonParametersBinFunc = (iReadIonParametersBinFunc)GetProcAddress((HMODULE)hLib,"ReadIonParametersBin");
 	dllReadIonParametersTxtFunc = (iReadIonParametersTxtFunc)GetProcAddress((HMODULE)hLib,"ReadIonParametersTxt");
+	dllMapIonParametersFunc = (iMapIonParametersFunc)GetProcAddress((HMODULE)hLib,"MapIonParameters");
+	dllLoadDatasetCache = (iLoadDatasetCache)GetProcAddress((HMODULE)hLib,"LoadDatasetCache");
+	dllSelectMonth = (iSelectMonth)GetProcAddress((HMODULE)hLib,"SelectMonth");
+	dllFreeDatasetCache = (iFreeDatasetCache)GetProcAddress((HMODULE)hLib,"FreeDatasetCache");
+	dllGetDataset = (vGetDataset)GetProcAddress((HMODULE)hLib,"GetDataset");
+	dllAttachDataset = (vAttachDataset)GetProcAddress((HMODULE)hLib,"AttachDataset");
 	dllReadP1239Func = (iReadP1239Func)GetProcAddress((HMODULE)hLib,"ReadP1239");
 
 #elif __linux__ || __APPLE__
@@ -142,6 +163,8 @@ int main(int argc, char *argv[]) {
 	dllP533Version = dlsym(hLib,"P533Version");
 	dllP533CompileTime = dlsym(hLib,"P533CompileTime");
 	dllP533 = dlsym(hLib,"P533");
+	dllP533Prepare = dlsym(hLib,"P533Prepare");
+	dllP533Frequency = dlsym(hLib,"P533Frequency");
 	dllAllocatePathMemory = dlsym(hLib,"AllocatePathMemory");
 	dllFreePathMemory = dlsym(hLib,"FreePathMemory");
 	dllInputDump = dlsym(hLib, "InputDump");
@@ -150,8 +173,16 @@ int main(int argc, char *argv[]) {
 	dllReadType13Func = dlsym(hLib,"ReadType13");
 	dllReadType14Func = dlsym(hLib,"ReadType14");
 	dllIsotropicPatternFunc = dlsym(hLib,"IsotropicPattern");
+	dllRegisterAntennaFunc = dlsym(hLib,"RegisterAntenna");
+	dllFreeAntennaRegistryFunc = dlsym(hLib,"FreeAntennaRegistry");
 	dllReadIonParametersBinFunc = dlsym(hLib,"ReadIonParametersBin");
 	dllReadIonParametersTxtFunc = dlsym(hLib,"ReadIonParametersTxt");
+	dllMapIonParametersFunc = dlsym(hLib,"MapIonParameters");
+	dllLoadDatasetCache = dlsym(hLib,"LoadDatasetCache");
+	dllSelectMonth = dlsym(hLib,"SelectMonth");
+	dllFreeDatasetCache = dlsym(hLib,"FreeDatasetCache");
+	dllGetDataset = dlsym(hLib,"GetDataset");
+	dllAttachDataset = dlsym(hLib,"AttachDataset");
 	dllReadP1239Func = dlsym(hLib,"ReadP1239");
 	//printf("%s\n",dllP533Version());
 #endif
@@ -172,6 +203,9 @@ int main(int argc, char *argv[]) {
 	// Determine the desired user options on the command line
 	while ((argc > 1) && (argv[1][0] == '-')) {
 		switch (argv[1][1]) {
+			case 'a': // Antenna cache - Load and save the antenna patterns in cache files
+				ITURHFP.antcache = TRUE;
+				break;
 			case 'c': //CSV OUTPUT
 				ITURHFP.csvRFC4180 = TRUE;
 				ITURHFP.header = FALSE;
@@ -187,6 +221,24 @@ int main(int argc, char *argv[]) {
 				printf("P533 Version: %s\n", ITURHFP.P533ver);
 				return RTN_MAINOK;
 				break;
+			case 'j': // Threads - Number of threads for area coverage
+				if(argv[1][2] != '\0') {
+					ITURHFP.threads = atoi(&argv[1][2]);
+				}
+				else if(argc > 2) {
+					ITURHFP.threads = atoi(argv[2]);
+					++argv;
+					--argc;
+				}
+				if(ITURHFP.threads < 1) {
+					printf("Main: Error %d Invalid Number of Threads\n", RTN_ERRCOMMANDLINEARG);
+					help();
+					return RTN_ERRCOMMANDLINEARG;
+				}
+				break;
+			case 'r': // Resident - Load the data for all 12 months once
+				ITURHFP.resident = TRUE;
+				break;
 			case 'h': // Help - Display Help and Exit
 				help();
 				return RTN_MAINOK;
@@ -248,6 +300,10 @@ int main(int argc, char *argv[]) {
 	if(ITURHFP.AntennaOrientation == TX2RX) {
 		ITURHFP.TXBearing = dllBearing(path.L_tx, path.L_rx, path.SorL); // Point the transmitter at the receiver.
 		ITURHFP.RXBearing = dllBearing(path.L_rx, path.L_tx, path.SorL); // Point the receiver at the transmitter.
+		// Point each of the best-server transmitters at the receiver.
+		for(i=0; i<ITURHFP.ntx; i++) {
+			ITURHFP.tx[i].Bearing = dllBearing(ITURHFP.tx[i].L_tx, path.L_rx, path.SorL);
+		}
 	}
 
     retval = ValidateITURHFP(ITURHFP);
@@ -323,6 +379,8 @@ int main(int argc, char *argv[]) {
 		printf("Main: Error %d from dllFreePathMemory\n", retval);
 		return retval;
 	}
+	dllFreeAntennaRegistryFunc();
+	free(ITURHFP.tx);
 
     return RTN_MAINOK;
 }
@@ -353,9 +411,14 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 
 	 */
 
+	struct DatasetCache cache;	// Data for all 12 months when ITURHFP->resident is TRUE
+	struct Dataset own;			// The path's own data while it is pointed at the cache
+
 	int i;
 	int retval; // Return value
 	int count;
+	int npts;	// Number of grid points
+	int nprep;	// Number of prepared paths
 
 	// Initialize the output record counter.
 	count = 1;
@@ -386,6 +449,16 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 	ITURHFP->ilngend = abs((int)(INTTWEEK+(ITURHFP->L_LR.lng - ITURHFP->L_LL.lng)/ITURHFP->lnginc)); // Push the double a little to avoid (int) casting errors.
 	++ITURHFP->ilngend;
 
+	// When there is more than one frequency the part of P533() that doesn't depend on the frequency is done once
+	// for each grid point and hour with P533Prepare() and kept. If the area is too large to keep the prepared
+	// paths, or the memory isn't available, P533() is run in full for each frequency. For best-server coverage
+	// there is a prepared path for each grid point and transmitter.
+	npts = ITURHFP->ilatend*ITURHFP->ilngend;
+	nprep = npts*MAX(ITURHFP->ntx, 1);
+	if((ITURHFP->ifrqend > 1) && ((double)nprep*sizeof(struct PathData) <= MAXPREPAREDMEMORY)) {
+		ITURHFP->prepared = (struct PathData *) malloc(nprep*sizeof(struct PathData));
+	}
+
 	// Read in the MUF decile values for the entire year.
 	retval = dllReadP1239Func(path, ITURHFP->DataFilePath);
 	if(retval != RTN_READP1239OK) {
@@ -411,32 +484,62 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 	dllReadFamDud = (iReadFamDud)GetProcAddress((HMODULE)hLib, "ReadFamDud");
 #elif __linux__ || __APPLE__
 	void * hLib;
-	hLib = dlopen("libp372.so", RTLD_NOW);
-	if (!hLib) {
-		printf("Couldn't load libp372.so, exiting.\n");
-		exit(1);
+	// A libp533.so built with P372STATIC=1 contains the P372 routines so look there first.
+	hLib = dlopen("libp533.so", RTLD_NOW);
+	if (hLib) {
+		dllReadFamDud = dlsym(hLib, "ReadFamDud");
+	}
+	if (dllReadFamDud == NULL) {
+		hLib = dlopen("libp372.so", RTLD_NOW);
+		if (!hLib) {
+			printf("Couldn't load libp372.so, exiting.\n");
+			exit(1);
+		}
+		dllReadFamDud = dlsym(hLib, "ReadFamDud");
 	}
-	dllReadFamDud = dlsym(hLib, "ReadFamDud");
 #endif
 	// End P372.DLL Load ************************************************
 
+	// Load all of the months at once if it was requested
+	if(ITURHFP->resident == TRUE) {
+		retval = dllLoadDatasetCache(&cache, ITURHFP->DataFilePath, ITURHFP->silent);
+		if(retval != RTN_ALLOCATEP533OK) {
+			dllFreeDatasetCache(&cache);
+			return retval;
+		}
+		dllGetDataset(path, &own);
+	}
+
 	// ********************** Month Loop **********************************************************
 	for(ITURHFP->imnth=0; ITURHFP->imnth<ITURHFP->imnthend; ITURHFP->imnth++) { // months
 		// Save the month of interest to the path structure for processing.
 		path->month = ITURHFP->months[ITURHFP->imnth];
 
 
-		// Read in the ionospheric parameters for the particular month for the call to P533.
-		retval = dllReadIonParametersBinFunc(path->month, path->foF2, path->M3kF2, ITURHFP->DataFilePath, ITURHFP->silent);
-		if(retval != RTN_READIONPARAOK) {
-			return retval;
+		if(ITURHFP->resident == TRUE) {
+			// Point the path at the month in the cache
+			retval = dllSelectMonth(path, &cache, path->month);
+			if(retval != RTN_ALLOCATEP533OK) {
+				return retval;
+			}
 		}
-
-        // Read in the atmospheric coefficients for the particular month.
-		// The subroutine dllReadFamDud() is from P372.dll
-		retval = dllReadFamDud(&path->noiseP, ITURHFP->DataFilePath, path->month);
-		if(retval != RTN_READFAMDUDOK) {
-			return retval;
+		else {
+			// Read in the ionospheric parameters for the particular month for the call to P533.
+			// Use the native map file made by IonMapConvert if there is one, otherwise read the binary file.
+			retval = dllMapIonParametersFunc(path->month, path->ionmap, ITURHFP->DataFilePath, ITURHFP->silent);
+			if(retval != RTN_READIONPARAOK) {
+				retval = dllReadIonParametersBinFunc(path->month, path->foF2, path->M3kF2, ITURHFP->DataFilePath, ITURHFP->silent);
+				if(retval != RTN_READIONPARAOK) {
+					return retval;
+				}
+			}
+
+			// Read in the atmospheric coefficients for the particular month.
+			// The subroutine dllReadFamDud() is from P372.dll
+			retval = dllReadFamDud(&path->noiseP, ITURHFP->DataFilePath, path->month);
+			if(retval != RTN_READFAMDUDOK) {
+				return retval;
+			}
 		}
 
         // Before you enter the remaining loops for the analysis give the user feedback.
@@ -448,10 +551,30 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 		for(ITURHFP->ihr=0; ITURHFP->ihr<ITURHFP->ihrend; ITURHFP->ihr++) { // hours
 			path->hour = ITURHFP->hrs[ITURHFP->ihr];
 
+			// Do the frequency independent part of the calculation for each grid point. P533Prepare() validates
+			// the frequency as well so use the first one.
+			if(ITURHFP->prepared != NULL) {
+				path->frequency = ITURHFP->frqs[0];
+				retval = PrepareArea(path, ITURHFP);
+				if(retval != RTN_ITURHFPropOK) {
+					return retval;
+				}
+			}
+
 			// **************** Frequency loop *************************************************
 			for(ITURHFP->ifrq=0; ITURHFP->ifrq<ITURHFP->ifrqend; ITURHFP->ifrq++) { // freqs
 				path->frequency = ITURHFP->frqs[ITURHFP->ifrq];
 
+				// Spread the area over the threads if more than one was requested. Best-server coverage is always
+				// done this way, with one or more threads.
+				if((ITURHFP->threads > 1) || (ITURHFP->ntx > 0)) {
+					retval = ParallelArea(path, ITURHFP, &count);
+					if(retval != RTN_ITURHFPropOK) {
+						return retval;
+					}
+					continue;
+				}
+
 				// ********************* Latitude loop *****************************************
 				for(ITURHFP->ilat=0; ITURHFP->ilat<ITURHFP->ilatend; ITURHFP->ilat++) {
 					// Increment the latitude
@@ -468,7 +591,13 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 						}
 
                         // Run the model
-						retval = dllP533(path); // Run P533()
+						if(ITURHFP->prepared != NULL) {
+							// Finish P533() for this frequency from the prepared grid point
+							retval = dllP533Frequency(path, &ITURHFP->prepared[ITURHFP->ilat*ITURHFP->ilngend + ITURHFP->ilng], path->frequency);
+						}
+						else {
+							retval = dllP533(path); // Run P533()
+						}
 						if(retval != RTN_P533OK) {
 							return retval;
 						}
@@ -496,6 +625,21 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 		}
     } // ***************************** End Months loop ******************************************
 
+	free(ITURHFP->prepared);
+	ITURHFP->prepared = NULL;
+
+	// Stop the area worker threads
+	StopAreaPool(ITURHFP);
+
+	// Give the path back its own data before the cache is freed
+	if(ITURHFP->resident == TRUE) {
+		dllAttachDataset(path, &own);
+		retval = dllFreeDatasetCache(&cache);
+		if(retval != RTN_PATHFREED) {
+			return retval;
+		}
+	}
+
 	return RTN_ITURHFPropOK;
 }
 
@@ -504,8 +648,14 @@ void help(void)
 	printf("\n");
 	printf("ITUFHProp [Options] [Input File] [Output File]\n");
 	printf("\tOptions\n");
+	printf("\t\t-a Antenna Cache: Load the antenna patterns from cache files\n");
+	printf("\t\t   made from them on an earlier run\n");
 	printf("\t\t-c CSV: Create an RFC4180 compliant CSV output file.\n");
 	printf("\t\t-h Help: Displays help\n");
+	printf("\t\t-j N Threads: Calculate the area with N threads. The output\n");
+	printf("\t\t   is identical to a single thread run\n");
+	printf("\t\t-r Resident: Load the ionospheric maps and noise data for all\n");
+	printf("\t\t   12 months once at the start\n");
 	printf("\t\t-s Silent Mode: Supresses display output except for error\n");
 	printf("\t\t   messages\n");
 	printf("\t\t-t Table: Print only the CSV table to the output file.\n");
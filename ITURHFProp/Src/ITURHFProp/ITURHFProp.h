@@ -9,14 +9,23 @@
 	// P533 functions
 	typedef const char * (__cdecl *cP533Info)(void);
 	typedef int(__cdecl * iP533)(struct PathData * path);
+	typedef int(__cdecl * iP533Frequency)(struct PathData * path, struct PathData const * prepared, double frequency);
 	typedef int(__cdecl * iPathMemory)(struct PathData * path);
 	typedef int(__cdecl* iReadType11Func)(struct Antenna* Ant, FILE* DataFilePath, int silent);
 	typedef int(__cdecl* iReadType13Func)(struct Antenna* Ant, FILE* DataFilePath, double bearing, int silent);
 	typedef int(__cdecl* iReadType14Func)(struct Antenna* Ant, FILE* DataFilePath, int silent);
 	typedef void(__cdecl * vIsotropicPatternFunc)(struct Antenna *Ant, double G, int silent);
+	typedef int(__cdecl * iRegisterAntennaFunc)(struct Antenna *Ant, char const *AntFilePath, double bearing, int cache, int silent);
+	typedef void(__cdecl * vFreeAntennaRegistryFunc)(void);
 	typedef int(__cdecl * iReadFamDudFunc)(struct PathData *path, char * DataFilePath);
 	typedef int(__cdecl * iReadIonParametersBinFunc)(int month, float ****foF2, float ****M3kF2, char DataFilePath[256], int silent);
 	typedef int(__cdecl * iReadIonParametersTxtFunc)(struct PathData *path, char DataFilePath[256], int silent);
+	typedef int(__cdecl * iMapIonParametersFunc)(int month, float *ionmap, char DataFilePath[256], int silent);
+	typedef int(__cdecl * iLoadDatasetCache)(struct DatasetCache *dc, char DataFilePath[256], int silent);
+	typedef int(__cdecl * iSelectMonth)(struct PathData *path, struct DatasetCache const *dc, int month);
+	typedef int(__cdecl * iFreeDatasetCache)(struct DatasetCache *dc);
+	typedef void(__cdecl * vGetDataset)(struct PathData const *path, struct Dataset *ds);
+	typedef void(__cdecl * vAttachDataset)(struct PathData *path, struct Dataset const *ds);
 	typedef int(__cdecl * iReadP1239Func)(struct PathData *path, char * DataFilePath);
 	typedef int(__cdecl * iInputDump)(struct PathData *path);
 
@@ -38,6 +47,8 @@
 	cP533Info dllP533Version;
 	cP533Info dllP533CompileTime;
 	iP533 dllP533;
+	iP533 dllP533Prepare;
+	iP533Frequency dllP533Frequency;
 	iPathMemory dllAllocatePathMemory;
 	iPathMemory dllFreePathMemory;
 	iPathMemory dllAllocateAntennaMemory;
@@ -46,8 +57,16 @@
 	iReadType13Func dllReadType13Func;
 	iReadType14Func dllReadType14Func;
 	vIsotropicPatternFunc dllIsotropicPatternFunc;
+	iRegisterAntennaFunc dllRegisterAntennaFunc;
+	vFreeAntennaRegistryFunc dllFreeAntennaRegistryFunc;
 	iReadIonParametersBinFunc dllReadIonParametersBinFunc;
 	iReadIonParametersTxtFunc dllReadIonParametersTxtFunc;
+	iMapIonParametersFunc dllMapIonParametersFunc;
+	iLoadDatasetCache dllLoadDatasetCache;
+	iSelectMonth dllSelectMonth;
+	iFreeDatasetCache dllFreeDatasetCache;
+	vGetDataset dllGetDataset;
+	vAttachDataset dllAttachDataset;
 	iReadP1239Func dllReadP1239Func;
 #elif __linux__ || __APPLE__
 	#include <dlfcn.h>
@@ -55,6 +74,8 @@
 	char * (*dllP533Version)();
 	char * (*dllP533CompileTime)();
 	int (*dllP533)(struct PathData *);
+	int (*dllP533Prepare)(struct PathData *);
+	int (*dllP533Frequency)(struct PathData *, struct PathData const *, double);
 	int (*dllAllocatePathMemory)(struct PathData *);
 	int (*dllFreePathMemory)(struct PathData *);
 	int (*dllAllocateAntennaMemory)(struct Antenna *Ant, int freqn, int azin, int elen);
@@ -63,8 +84,16 @@
 	int  (*dllReadType13Func)(struct Antenna *Ant, FILE *fp, double bearing, int silent);
 	int  (*dllReadType14Func)(struct Antenna *Ant, FILE *fp, int silent);
 	void (*dllIsotropicPatternFunc)(struct Antenna *Ant, double G, int silent);
+	int  (*dllRegisterAntennaFunc)(struct Antenna *Ant, char const *AntFilePath, double bearing, int cache, int silent);
+	void (*dllFreeAntennaRegistryFunc)(void);
 	int  (*dllReadIonParametersTxtFunc)(struct PathData *path, char DataFilePath[256], int silent);
         int  (*dllReadIonParametersBinFunc)(int month, float ****foF2, float ****M3kF2, char DataFilePath[256], int silent);
+	int  (*dllMapIonParametersFunc)(int month, float *ionmap, char DataFilePath[256], int silent);
+	int  (*dllLoadDatasetCache)(struct DatasetCache *dc, char DataFilePath[256], int silent);
+	int  (*dllSelectMonth)(struct PathData *path, struct DatasetCache const *dc, int month);
+	int  (*dllFreeDatasetCache)(struct DatasetCache *dc);
+	void (*dllGetDataset)(struct PathData const *path, struct Dataset *ds);
+	void (*dllAttachDataset)(struct PathData *path, struct Dataset const *ds);
 	int  (*dllReadP1239Func)(struct PathData *path, const char * DataFilePath);
 #endif
 
@@ -130,6 +159,10 @@
 #define	RPT_DUMPPATH		4294967295
 // End Report output options **********************************************************************
 
+// The most memory (bytes) that ITURHFProp() will use to keep the prepared path for each grid point
+// when there is more than one frequency. Larger areas run the whole of P533() for each frequency.
+#define MAXPREPAREDMEMORY	268435456	// 256 MB
+
 // Return values **********************************************************************************
 
 // Note: All return values from the driver program ITURHFProp >= 1000 and < 2000
@@ -173,6 +206,12 @@
 #define RTN_ERRCOMMANDLINEARG		75 // ERROR: Invalid Command Line
 #define RTN_ERRNOINPUTFILE			76// ERROR: Missing Input File
 
+// Returns ERROR for ParallelArea()
+#define RTN_ERRALLOCATEWORKERS		77 // ERROR: Allocating Memory for the Worker Threads
+
+// Returns ERROR for ReadInputConfiguration() and ValidateITURHFP()
+#define RTN_ERRTXLIST				78 // ERROR: Invalid Best Server Transmitter List
+
 // Returns OKAY numbers Returns > 30 and <= 40
 #define RTN_ITURHFPropOK			32 // ITURHFProp()
 #define RTN_VALIDATEITURHFPOK		32 // ValidateITURHFP()
@@ -187,6 +226,9 @@
 #define NMBOFFREQS		32
 #define NMBOFMONTHS		12
 
+// The most transmitters that can be compared for best-server coverage (TX1 to TX16 in the input file)
+#define MAXTX			16
+
 // End returns for ITURHFProp Demonstration Program - main()
 
 // End returns values *****************************************************************************
@@ -211,6 +253,19 @@
 
 // Structures *************************************************************************************
 
+// One of the transmitters that are compared for best-server coverage. Each is read from the TXn.* lines in the input
+// file. Any parameter that isn't given is taken from the single path input (See ReadInputConfiguration()).
+struct Transmitter {
+	char Name[256];
+	struct Location L_tx;
+	double txpower;			// Transmit power (dB(kW))
+
+	char AntFilePath[256];
+	double Bearing;			// This is where the main beam of the tx antenna is pointing.
+	double GOS;				// The pattern gain offset
+	struct Antenna A_tx;	// The antenna pattern (See ReadAntennaPatterns())
+};
+
 // ITURHFProp structure are the input parameters to run p533().
 struct ITURHFProp {
 
@@ -268,6 +323,13 @@ struct ITURHFProp {
 
 	int AntennaOrientation;
 
+	// Best-server coverage. When there are transmitters each grid point is reported for the transmitter with the
+	// highest median SNR (See ParallelArea()).
+	int ntx;					// Number of transmitters, 0 for the single path
+	struct Transmitter *tx;		// [MAXTX]
+	int server;					// The best server at the grid point being reported
+	double margin;				// SNR of the best server above the next best (dB)
+
 	struct tm *time;
 
 	char DataFilePath[256];
@@ -276,6 +338,11 @@ struct ITURHFProp {
 	char const *P533compt;		// P533() Compile time
 
 	int silent;				// Silent flag
+	int threads;			// Number of threads for area coverage (-j option)
+	int resident;			// Load the data for all 12 months once (-r option)
+	int antcache;			// Load and save the antenna patterns in cache files (-a option)
+	struct PathData *prepared;	// Frequency independent part of the calculation for each grid point (See PrepareArea())
+	struct AreaPool *pool;		// Worker threads for the area, started on first use (See ParallelArea.c)
 	int header;					// Print header flag
 	int csvRFC4180;			// Create an RFC4180 formatted output csv file.
 };
@@ -308,6 +375,12 @@ int hrs(double time);
 int mns(double time);
 void PrintITUHeader(FILE * fp, char * time, char const * P533Version, char const * P533CompT, char const * P372Version, char const * P372CompT);
 
+// ParallelArea.c Prototype
+int ParallelArea(struct PathData *path, struct ITURHFProp *ITURHFP, int *count);
+int PrepareArea(struct PathData *path, struct ITURHFProp *ITURHFP);
+void SetTransmitter(struct PathData *path, struct ITURHFProp const *ITURHFP, int t);
+void StopAreaPool(struct ITURHFProp *ITURHFP);
+
 // Report.c Prototype
 void Report(struct PathData path, struct ITURHFProp ITURHFP);
 
@@ -81,9 +81,10 @@
 #define RTN_ERRALLOCATEFOF2VAR			133 // ERROR: Allocating Memory for foF2 Variability
 #define RTN_ERRALLOCATETX				134 // ERROR: Allocating Memory for Tx Antenna Pattern
 #define RTN_ERRALLOCATERX				135 // ERROR: Allocating Memory for Rx Antenna Pattern
+#define RTN_ERRALLOCATELPGRID			136 // ERROR: Allocating Memory for the Long Path Control Point Grid
 #define RTN_ERRALLOCATEANT			    137 // ERROR: Allocating Memory for Antenna Pattern
 
-// Return ERROR from ReadAntennaPatterns() ReadType13()
+// Return ERROR from ReadAntennaPatterns() ReadType13() ReadAntennaFile() RegisterAntenna()
 #define	RTN_ERRCANTOPENANTFILE	        138 // ERROR: Can Not Open Recieve Antenna File
 
 // Return ERROR from ReadP1239()
@@ -92,6 +93,20 @@
 
 // Return ERROR from ReadIonParametersTxt()
 #define RTN_ERRREADIONPARAMETERS		141 // ERROR: Can Not Open Ionospheric Parameters File
+#define RTN_ERRPARSEIONPARAMETERS		145 // ERROR: Invalid Value in Ionospheric Parameters Text File
+
+// Return ERROR from WriteIonParametersBin()
+#define RTN_ERRWRITEIONPARAMETERS		146 // ERROR: Can Not Write Ionospheric Parameters File
+
+// Return ERROR from MapIonParameters() and WriteIonMap()
+#define RTN_ERRMAPIONPARAMETERS			142 // ERROR: Can Not Map Native Ionospheric Parameters File
+#define RTN_ERRWRITEIONMAP				143 // ERROR: Can Not Write Native Ionospheric Parameters File
+
+// Return ERROR from LoadDatasetCache()
+#define RTN_ERRIONMAPDATA				144 // ERROR: Ionospheric Map Data Out of Range
+
+// Return ERROR from ReadAntennaCache() and WriteAntennaCache()
+#define RTN_ERRANTENNACACHE				147 // ERROR: No Usable Antenna Cache File
 
 
 // Return OKAY > 10 and <= 20
@@ -102,6 +117,7 @@
 #define RTN_READP1239OK					15 // ReadP1239()
 #define RTN_READANTENNAPATTERNSOK		16 // ReadAntennaPatterns()
 #define	RTN_VALIDDATAOK					17 // ValidPath()
+#define	RTN_P372BOUNDOK					18 // BindP372()
 
 #define	RTN_P533OK						10 // P533()
 
@@ -122,6 +138,35 @@
 #define	R1k		4	// R - 1000 (km)
 // Note: Alternative use in long model at last penetration point, 2*nL, at current hour
 
+// Ionospheric map layout
+// The foF2 and M(3000)F2 maps for the month are held in one contiguous block of floats ordered [hour][longitude][latitude].
+// Each grid cell holds four floats, so both SSNs of both parameters for a cell are in the same cache line:
+//		foF2 (SSN = 0), foF2 (SSN = 100), M(3000)F2 (SSN = 0), M(3000)F2 (SSN = 100)
+#define IONMAPHRS		24	// 24 hours
+#define IONMAPLNGS		241	// 241 longitudes at 1.5 degree increments
+#define IONMAPLATS		121	// 121 latitudes at 1.5 degree increments
+#define IONMAPCELL		4	// Floats in each grid cell
+#define IONMAPFOF2		0	// Offset of foF2 in the grid cell
+#define IONMAPM3KF2		2	// Offset of M(3000)F2 in the grid cell
+#define IONMAPSIZE		(IONMAPHRS*IONMAPLNGS*IONMAPLATS*IONMAPCELL) // Floats in the block
+#define IONMAPALIGN		64	// Alignment of the block (bytes)
+// Pointer to the grid cell for the hour, longitude index and latitude index
+#define IONMAPCELLPTR(map, hour, lng, lat)	((map) + ((((hour)*IONMAPLNGS + (lng))*IONMAPLATS + (lat))*IONMAPCELL))
+
+// foF2 variability layout
+// The foF2 variability from ITU-R P.1239 is one contiguous block of doubles ordered [season][hour][latitude][SSN][decile].
+// path->foF2var is a pointer to the [hour][latitude][SSN][decile] array for each season, so every value is a single
+// indexed load.
+#define FOF2VARSEASONS	3	// Seasons
+#define FOF2VARHRS		24	// 24 hours
+#define FOF2VARLATS		19	// 19 latitudes at 5 degree increments
+#define FOF2VARSSNS		3	// 3 SSN ranges
+#define FOF2VARDECILES	2	// Lower and upper decile
+#define FOF2VARSIZE		(FOF2VARSEASONS*FOF2VARHRS*FOF2VARLATS*FOF2VARSSNS*FOF2VARDECILES) // Doubles in the block
+// Version of the layout of the foF2 variability and the ionospheric maps. It changes whenever the layout does. A caller that
+// indexes the arrays in struct PathData itself checks it against P533DataLayout().
+#define P533DATALAYOUT	2
+
 // foF2 variability index names for readability
 #define WINTER	0
 #define EQUINOX 1
@@ -169,6 +214,10 @@
 #define SHORTPATH	0
 #define LONGPATH	1
 
+// Magnetic field flags (See MagGrid.c)
+#define MAGFIELDEXACT	0	// magfit() at each control point
+#define MAGFIELDGRID	1	// Interpolated from the magnetic field grid
+
 // Minimum Elevation Angle (degrees) for the Short model
 #define MINELEANGLES 3.0
 // Minimum Elevation Angle (degree) for the Long model
@@ -293,6 +342,25 @@ struct Antenna {
 	//		i) The orientation is correct. The antenna pattern is in the orientation as it would be on the Earth.
 	//		ii) The data is valid. It is the responsibility of the calling program to ensure this.
 	double ***pattern;
+
+	// Azimuth (degrees) of the main beam of a pattern that is stored unrotated. AntennaGain() looks up the bearing B
+	// in the row (B - rotation) mod 360, so paths with different bearings can share one pattern. Only type 13 files
+	// have a rotation (See ReadType13()).
+	int rotation;
+
+	// TRUE if the pattern belongs to the antenna registry (See RegisterAntenna()). It is read only and is not freed
+	// with the path.
+	int shared;
+};
+
+// The lookup of one antenna's gain towards the other end of the path. The bearing only depends on the path geometry so it
+// is found once in InitializePath(). PlanAntenna() then resolves the pattern frequency and the two azimuth columns either
+// side of the bearing for the operating frequency, so AntennaPlanGain() only has to interpolate in elevation.
+struct AntennaPlan {
+	double B;			// Bearing (degrees) of the other end of the path
+	double c;			// Fractional part of the bearing between the columns L and R
+	double *L;			// Gains (dB) by elevation in the azimuth column at or below the bearing
+	double *R;			// Gains (dB) by elevation in the azimuth column at or above the bearing
 };
 
 // Any "adjustment" to the contents of the structure PathData to make indices out of some of the variables, such as month and hour
@@ -316,6 +384,8 @@ struct PathData {
 
 	int SorL;			//  Short or long path switch
 
+	int MagField;		// Magnetic field flag MAGFIELDEXACT or MAGFIELDGRID
+
 	double frequency;	// Frequency (MHz)
 	double BW;			// Bandwidth (Hz)
 
@@ -347,14 +417,23 @@ struct PathData {
 	// current month. If the month changes foF2 and M3kF2 will have to be reloaded, while the pointer
 	// foF2var does not since it is for the entire year
 	// Pointers to array extracted from the coefficients in ~/IonMap directory
+	// foF2 and M3kF2 are [hour][longitude][latitude][SSN] views into the block ionmap (See IONMAPCELLPTR())
 	float ****foF2;			// foF2
 	float ****M3kF2;		// M(3000)F2
+	float *ionmap;			// foF2 and M(3000)F2 in one contiguous block
 	// Pointer to array extracted from the file "P1239-2 Decile Factors.txt"
-	double *****foF2var;	// foF2 Variablity from ITU-R P.1239-2 TABLE 2 and TABLE 3
+	// foF2 Variablity from ITU-R P.1239-2 TABLE 2 and TABLE 3 [season][hour][latitude][SSN][decile] (See FOF2VARSIZE)
+	double (*foF2var)[FOF2VARHRS][FOF2VARLATS][FOF2VARSSNS][FOF2VARDECILES];
+	// The 24-hour control point grid of the last long path, kept so that the hour and frequency loops on a long path find
+	// it once (See MedianSkywaveFieldStrengthLong.c). It belongs to the path it was allocated for by AllocatePathMemory().
+	// A copy of the path made by assignment shares the pointer but doesn't use the grid, so copies can run in other threads.
+	// Call ForgetLongPathGrid() after changing the ionospheric maps in place.
+	struct LongPathGrid *LPgrid;
 
  	// End Array Pointers *************************************************************************
 
 	// Calculated Parameters **********************************************************************
+	struct SolarParameters Sun;	// Only Sun.decl and Sun.eot, which are the same at every control point (See InitializeCircuit())
 	int season;			// This is used for MUF calculations
 	double distance;	// This is the great circle distance (km) between the rx and tx
 	double ptick;		// Slant range
@@ -362,6 +441,10 @@ struct PathData {
 	double B;			// Intermediate value when calculating dmax also determined at midpoint of the path
 	double ele;			// For paths that are longer than 9000 km this is the composite elevation angle
 
+	// Antenna lookups (See struct AntennaPlan)
+	struct AntennaPlan AP_tx;	// Transmitter antenna towards the receiver
+	struct AntennaPlan AP_rx;	// Receiver antenna towards the transmitter
+
 	// MUFs
 	double BMUF;	// Basic MUF (MHz)
 	double MUF50;	// MUF exceeded for 50% of the days of the month (MHz)
@@ -462,6 +545,72 @@ struct PathData {
 	// End Calculated Parameters *****************************************************************************
 };
 
+/*
+ *	The structure Dataset holds the read-only data that P533() uses for a month: the ionospheric maps, the foF2 variability,
+ *	the P372 noise coefficients and the antenna patterns. The arrays are large, so a dataset is allocated once with
+ *	AllocateDataset() and shared by any number of PathData structures with AttachDataset(). A PathData then only carries
+ *	the inputs and calculated parameters for one evaluation.
+ *
+ *	P533() reads the dataset and writes only to its own PathData. So P533() can run in several threads at once, each on its
+ *	own PathData, once AllocateDataset() or AllocatePathMemory() has been called and the data has been read in.
+ */
+struct Dataset {
+	// Ionospheric maps [hour][longitude][latitude][SSN]
+	// foF2 and M3kF2 are views into the block ionmap (See IONMAPCELLPTR())
+	float ****foF2;
+	float ****M3kF2;
+	float *ionmap;
+
+	// foF2 variability [season][hour][latitude][SSN][decile]
+	double (*foF2var)[FOF2VARHRS][FOF2VARLATS][FOF2VARSSNS][FOF2VARDECILES];
+
+	// P372 noise coefficients (See struct NoiseParams)
+	double (*fakp)[FAKPROWS][FAKPCOLS];
+	double (*fakabp)[FAKABPCOLS];
+	double (*fam)[FAMCOLS];
+	double (*dud)[DUDROWS][DUDCOLS];
+
+	// Antenna patterns
+	struct Antenna A_tx;
+	struct Antenna A_rx;
+};
+
+/*
+ *	The structure DatasetCache holds the month dependent data for all 12 months, the ionospheric maps and the P372 noise
+ *	coefficients, together with the foF2 variability for the year. It is loaded and validated once with LoadDatasetCache().
+ *	SelectMonth() then points a path at any month without reading a file, so a run over several months, or a long lived
+ *	process, only pays for the file I/O once. The antenna patterns are not part of the cache.
+ */
+struct DatasetCache {
+	int loaded;				// TRUE once all 12 months have been loaded and validated
+	struct Dataset year;	// foF2 variability for the year and the workspace used to read the months
+
+	// Month dependent data [month]
+	float *ionmap[12];		// Ionospheric maps (See IONMAPCELLPTR())
+	double (*fakp[12])[FAKPROWS][FAKPCOLS];	// P372 noise coefficients (See struct NoiseParams)
+	double (*fakabp[12])[FAKABPCOLS];
+	double (*fam[12])[FAMCOLS];
+	double (*dud[12])[DUDROWS][DUDCOLS];
+};
+
+/*
+ *	The structure BatchResults holds the results of P533Batch() as one array for each parameter with one element for each
+ *	receiver. The caller allocates the arrays. Any array that is NULL is not filled.
+ */
+struct BatchResults {
+	int *rtn;			// RTN_P533OK or the error for each receiver
+	double *distance;	// Path distance (km)
+	double *BMUF;		// Basic MUF (MHz)
+	double *MUF50;		// Median MUF (MHz)
+	double *OPMUF;		// Operational MUF (MHz)
+	double *Ep;			// Median field strength (dB(1 uV/m))
+	double *Pr;			// Median available receiver power (dBW)
+	double *SNR;		// Median signal-to-noise ratio (dB)
+	double *SNRXX;		// Signal-to-noise ratio for the required % of the time (dB)
+	double *BCR;		// Basic circuit reliability (%)
+	double *OCR;		// Overall circuit reliability (%)
+};
+
 // End Structures *********************************************************************************
 
 // Prototypes *************************************************************************************
@@ -477,19 +626,35 @@ struct PathData {
 
 // CalculateCPParameters.c Prototype
 void CalculateCPParameters(struct PathData *path, struct ControlPt *here);
+void CalculateCPIonosphere(struct PathData *path, struct ControlPt *here);
+void CalculateCPIonosphereBatch(struct PathData *path, struct ControlPt *here[], int n);
 void SolarParameters(struct ControlPt *here, int month, double hour);
+void SolarTime(struct SolarParameters *Sun, int month, double hour);
+void SolarPosition(struct ControlPt *here, double hour);
 double BilinearInterpolation(double LL, double LR, double UL, double UR, double r, double c);
-void IonosphericParameters(struct ControlPt *here, float ****foF2, float ****M3kF2, int hour, int SSN);
+void IonosphericParameters(struct ControlPt *here, float const *ionmap, int hour, int SSN);
+void IonosphericParametersBatch(struct ControlPt *here[], int n, float const *ionmap, int hour, int SSN);
 void FindfoE(struct ControlPt *here, int month, int hour, int SSN);
 
 // Initialize.c Prototypes
 //	Only three of the five control points are determined in InitializePath() T + 1000, M and R - 1000.
 //	The control points T + d0/2 and R - d0/2  are determined in MUFBasic()
+void InitializeCircuit(struct PathData *path);
 void InitializePath(struct PathData *path);
 
 // P533.c Prototype for the P533 propagation model engine
 DLLEXPORT int P533(struct PathData *path);
+DLLEXPORT int P533Batch(struct PathData *path, struct Location const *L_rx, int n, struct BatchResults *res);
+DLLEXPORT int P533Prepare(struct PathData *path);
+DLLEXPORT int P533Frequency(struct PathData *path, struct PathData const *prepared, double frequency);
 DLLEXPORT char const * P533Version(void);
+DLLEXPORT int P533DataLayout(void);
+int P533Engine(struct PathData *path);
+void FrequencyIndependent(struct PathData *path);
+int FrequencyDependent(struct PathData *path);
+
+// BindP372.c Prototype
+DLLEXPORT int BindP372(void);
 
 // Geometry.c Prototypes
 DLLEXPORT void GreatCirclePoint(struct Location here, struct Location there, struct ControlPt *midpnt, double distance, double fraction);
@@ -499,9 +664,15 @@ DLLEXPORT double Bearing(struct Location here, struct Location there, int direct
 
 // ValidataPath.c Prototypes
 int ValidatePath(struct PathData *path);
+int ValidateCircuit(struct PathData *path);
+int ValidateReceiver(struct Location L_rx);
 
 // magfit.c Prototype
 void magfit(struct ControlPt *here, double height);
+void MagfitBatch(struct ControlPt *here[], int n);
+
+// MagGrid.c Prototype
+void MagGridBatch(struct ControlPt *here[], int n);
 
 // MUFBasic Prototype
 //	Note MUFBasic() determines the control points T + d0/2 and R - d0/2
@@ -513,7 +684,8 @@ double CalcB(struct ControlPt *CP);
 
 // MUFVariability.c Prototype
 void MUFVariability(struct PathData *path);
-double FindfoF2var(struct PathData path, double hour, double lat, int decile);
+void MUFProbability(struct PathData *path);
+double FindfoF2var(struct PathData const *path, double hour, double lat, int decile);
 
 // MUFOperational.c Prototype
 void MUFOperational(struct PathData *path);
@@ -525,12 +697,15 @@ double IncidenceAngle(double deltaf, double hr);
 
 // MedianSkywaveFieldStrengthShort.c Prototype
 void MedianSkywaveFieldStrengthShort(struct PathData *path);
-double AntennaGain(struct PathData path, struct Antenna Ant, double delta, int direction);
+double AntennaGain(struct PathData const *path, struct Antenna const *Ant, double delta, int direction);
+double AntennaPlanGain(struct AntennaPlan const *AP, double delta);
+void PlanAntenna(struct AntennaPlan *AP, struct Antenna const *Ant, double frequency);
+void PlanAntennas(struct PathData *path);
 void ZeroCP(struct ControlPt *CP);
 
 // MedianSkywaveFieldStrengthLong.c Prototype
 void MedianSkywaveFieldStrengthLong(struct PathData *path);
-double AntennaGain08(struct PathData path, struct Antenna Ant, int direction, double * elevation);
+double AntennaGain08(struct AntennaPlan const *AP, double * elevation);
 
 // Between7000kmand9000km.c Prototypes
 void Between7000kmand9000km(struct PathData *path);
@@ -544,8 +719,33 @@ void CircuitReliability(struct PathData *path);
 // PathMemory.c prototype
 DLLEXPORT int AllocatePathMemory(struct PathData *path);
 DLLEXPORT int FreePathMemory(struct PathData *path);
+
+// MedianSkywaveFieldStrengthLong.c prototypes
+int AllocateLongPathGrid(struct PathData *path);
+void FreeLongPathGrid(struct PathData *path);
+DLLEXPORT void ForgetLongPathGrid(struct PathData *path);
 DLLEXPORT int AllocateAntennaMemory(struct Antenna *ant, int freqn, int azin, int elen);
 
+// Dataset.c prototypes
+DLLEXPORT int AllocateDataset(struct Dataset *ds);
+DLLEXPORT int FreeDataset(struct Dataset *ds);
+DLLEXPORT void AttachDataset(struct PathData *path, struct Dataset const *ds);
+DLLEXPORT void GetDataset(struct PathData const *path, struct Dataset *ds);
+DLLEXPORT int LoadDatasetCache(struct DatasetCache *dc, char DataFilePath[256], int silent);
+DLLEXPORT int SelectMonth(struct PathData *path, struct DatasetCache const *dc, int month);
+DLLEXPORT int FreeDatasetCache(struct DatasetCache *dc);
+void FreeAntenna(struct Antenna *ant);
+
+// IonMap.c prototypes
+DLLEXPORT int MapIonParameters(int month, float *ionmap, char DataFilePath[256], int silent);
+DLLEXPORT int WriteIonMap(int month, float const *ionmap, char DataFilePath[256], int silent);
+float *AllocateIonMap(void);
+void FreeIonMap(float *ionmap);
+
+// EmbeddedData.c prototypes
+FILE *OpenEmbeddedData(char const *name);
+int EmbeddedData(void);
+
 // InputDump. c Prototype
 DLLEXPORT int InputDump(struct PathData *path);
 
@@ -554,8 +754,15 @@ DLLEXPORT int ReadType11(struct Antenna *Ant, FILE *fp, int silent);
 DLLEXPORT int ReadType13(struct Antenna *Ant, FILE *fp, double bearing, int silent);
 DLLEXPORT int ReadType14(struct Antenna *Ant, FILE *fp, int silent);
 DLLEXPORT void IsotropicPattern(struct Antenna *Ant, double G, int silent);
+DLLEXPORT int ReadAntennaCache(struct Antenna *Ant, char const *AntFilePath, double bearing, int *type, int silent);
+DLLEXPORT int WriteAntennaCache(struct Antenna const *Ant, char const *AntFilePath, int type, int silent);
+DLLEXPORT int ReadAntennaFile(struct Antenna *Ant, char const *AntFilePath, double bearing, int *type, int silent);
+DLLEXPORT int RegisterAntenna(struct Antenna *Ant, char const *AntFilePath, double bearing, int cache, int silent);
+DLLEXPORT void FreeAntennaRegistry(void);
 DLLEXPORT int ReadIonParametersBin(int month, float ****foF2, float ****M3kF2, char DataFilePath[256], int silent);
 DLLEXPORT int ReadIonParametersTxt(struct PathData *path, char DataFilePath[256], int silent) ;
+DLLEXPORT int ReadIonParametersTxtFile(char const *InFilePath, float ****foF2, float ****M3kF2, int silent);
+DLLEXPORT int WriteIonParametersBin(int month, float ****foF2, float ****M3kF2, char DataFilePath[256], int silent);
 DLLEXPORT int ReadP1239(struct PathData *path, const char * DataFilePath);
 DLLEXPORT void SetAntennaPatternVal(struct PathData * path, int TXorRX, int azimuth, int elevation, double value);
 
@@ -0,0 +1,935 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+	#include <pthread.h>
+#endif
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+#include "ITURHFProp.h"
+// End local includes
+
+// Local defines
+#define POINTSPERTHREAD		64	// Number of grid points per thread in each block
+// End local defines
+
+// Local structures
+struct ServerPick {
+	int tx;			// Index of the best server
+	double margin;	// SNR of the best server above the next best (dB)
+};
+
+struct AreaBlock {
+	struct PathData const *path;		// Path with the month, hour and frequency set
+	struct ITURHFProp const *ITURHFP;	// Area definition
+	struct PathData *slot;				// One path workspace for each grid point in the block
+	int *rtn;							// The return value for each grid point in the block
+	struct ServerPick *pick;			// The best server for each grid point in the block when ITURHFP->ntx > 0
+	int first;							// Grid index of the first point in the block
+	int n;								// Number of grid points in the block
+	int prepare;						// TRUE to run P533Prepare() on the points rather than the full calculation
+	volatile long next;					// Index of the next point in the block that no thread has claimed
+};
+
+// The worker threads are started the first time they are needed and kept until the end of the run (See StopAreaPool()).
+// The pool works on one block at a time. SubmitBlock() makes a block the current one and wakes the workers and
+// FinishBlock() has the calling thread help with the block and then waits until no worker is in it.
+struct AreaPool {
+#ifdef _WIN32
+	HANDLE *hThread;
+	CRITICAL_SECTION lock;
+	CONDITION_VARIABLE work;	// Signalled when there is a new block or the pool is stopping
+	CONDITION_VARIABLE idle;	// Signalled when the last worker leaves a block
+#else
+	pthread_t *hThread;
+	pthread_mutex_t lock;
+	pthread_cond_t work;
+	pthread_cond_t idle;
+#endif
+	int nworkers;				// Number of worker threads, not counting the calling thread
+	struct AreaBlock *blk;		// The current block
+	long generation;			// Incremented for each block submitted
+	int inside;					// Number of workers in a block
+	int quit;					// TRUE when the workers are to exit
+};
+// End local structures
+
+// Local prototypes
+#ifdef _WIN32
+	DWORD WINAPI PoolWorker(LPVOID arg);
+#else
+	void *PoolWorker(void *arg);
+#endif
+int StartAreaPool(struct ITURHFProp *ITURHFP);
+void SubmitBlock(struct AreaPool *pool, struct AreaBlock *blk);
+void FinishBlock(struct AreaPool *pool, struct AreaBlock *blk);
+void AreaWorker(struct AreaBlock *blk);
+int AllocateBlock(struct AreaBlock *blk, struct PathData const *path, struct ITURHFProp const *ITURHFP, int nslot);
+void FreeBlock(struct AreaBlock *blk);
+int WriteBlock(struct AreaBlock *blk, struct PathData *path, struct ITURHFProp *ITURHFP, int *count);
+int PrepareBlock(struct PathData *path, struct ITURHFProp *ITURHFP, struct PathData *prepared);
+int ServePoint(struct AreaBlock *blk, long i);
+long ClaimPoint(volatile long *next);
+void CopyPath(struct PathData *to, struct PathData const *from);
+// End local prototypes
+
+int ParallelArea(struct PathData *path, struct ITURHFProp *ITURHFP, int *count) {
+
+	/*
+	   ParallelArea() - Runs P533() for every receiver grid point in the area for the current month, hour and frequency using
+			ITURHFP->threads threads. This replaces the latitude and longitude loops in ITURHFProp() when more than one thread is
+			requested with the -j option.
+
+			Each grid point is calculated in its own copy of the path. All of the copies share the ionospheric maps, foF2
+			variability, noise coefficients and antenna patterns (See struct Dataset in P533.h). The threads take grid
+			points from a shared counter, so a thread that finishes its points early simply takes more. The grid is done in blocks
+			of POINTSPERTHREAD points per thread to bound the memory. There are two blocks. While the calling thread writes the
+			records of one block, in the same order as the serial loops, the worker threads calculate the next one. The calling
+			thread then helps to finish it. The output file is identical to a serial run.
+
+			The worker threads are started on the first call and kept for the rest of the run (See StopAreaPool()).
+
+			If the grid points have been prepared with PrepareArea() only the frequency dependent part of the calculation is done.
+
+			When there are transmitters for best-server coverage (ITURHFP->ntx > 0) every grid point is calculated for each
+			of them and the record is written for the best server (See ServePoint()). ITURHFProp() uses this routine for
+			best-server coverage with any number of threads.
+
+			INPUT
+				struct PathData *path - With the month, hour and frequency set
+				struct ITURHFProp *ITURHFP
+				int *count - The output record counter
+
+			OUTPUT
+				Writes the records for each grid point with Report() or DumpPathData()
+				path - Is left as the last grid point calculated as it would be for the serial loops
+				returns RTN_ITURHFPropOK or the error from P533()
+
+			SUBROUTINES
+				StartAreaPool()
+				AllocateBlock()
+				SubmitBlock()
+				FinishBlock()
+				WriteBlock()
+				FreeBlock()
+
+	 */
+
+	struct AreaBlock blk[2];	// The block being written and the block being calculated
+	struct AreaBlock *cur, *nxt;
+
+	int retval;
+	int npts;		// Number of grid points
+	int nslot;		// Number of grid points in a block
+	int b;
+
+	npts = ITURHFP->ilatend*ITURHFP->ilngend;
+
+	nslot = MIN(npts, ITURHFP->threads*POINTSPERTHREAD);
+
+	retval = StartAreaPool(ITURHFP);
+	if(retval != RTN_ITURHFPropOK) return retval;
+
+	retval = AllocateBlock(&blk[0], path, ITURHFP, nslot);
+	if(AllocateBlock(&blk[1], path, ITURHFP, nslot) != RTN_ITURHFPropOK) retval = RTN_ERRALLOCATEWORKERS;
+	if(retval != RTN_ITURHFPropOK) {
+		FreeBlock(&blk[0]);
+		FreeBlock(&blk[1]);
+		return retval;
+	}
+
+	// Calculate the first block
+	cur = &blk[0];
+	cur->first = 0;
+	cur->n = nslot;
+	SubmitBlock(ITURHFP->pool, cur);
+	FinishBlock(ITURHFP->pool, cur);
+
+	for(b=0; cur != NULL; b++) {
+		// Start the next block before this one is written
+		nxt = NULL;
+		if(cur->first + cur->n < npts) {
+			nxt = &blk[(b+1)%2];
+			nxt->first = cur->first + cur->n;
+			nxt->n = MIN(nslot, npts - nxt->first);
+			SubmitBlock(ITURHFP->pool, nxt);
+		}
+
+		retval = WriteBlock(cur, path, ITURHFP, count);
+
+		if(nxt != NULL) FinishBlock(ITURHFP->pool, nxt);
+
+		if(retval != RTN_ITURHFPropOK) {
+			FreeBlock(&blk[0]);
+			FreeBlock(&blk[1]);
+			return retval;
+		}
+
+		if(nxt == NULL) {
+			// Leave the path and indices as the serial loops would
+			CopyPath(path, &cur->slot[cur->n-1]);
+			ITURHFP->ilat = ITURHFP->ilatend;
+			ITURHFP->ilng = ITURHFP->ilngend;
+		}
+
+		cur = nxt;
+	}
+
+	FreeBlock(&blk[0]);
+	FreeBlock(&blk[1]);
+
+	return RTN_ITURHFPropOK;
+
+}
+
+int WriteBlock(struct AreaBlock *blk, struct PathData *path, struct ITURHFProp *ITURHFP, int *count) {
+
+	/*
+	   WriteBlock() - Writes the records of the block in the order of the serial latitude and longitude loops
+
+			INPUT
+				struct AreaBlock *blk - A finished block
+				struct PathData *path
+				struct ITURHFProp *ITURHFP
+				int *count - The output record counter
+
+			OUTPUT
+				Writes the records for each grid point with Report() or DumpPathData()
+				returns RTN_ITURHFPropOK or the error from P533() and then path is the grid point that failed
+
+			SUBROUTINES
+				Report()
+				DumpPathData()
+
+	 */
+
+	int i, k;
+
+	for(i=0; i<blk->n; i++) {
+		k = blk->first + i;
+		ITURHFP->ilat = k/ITURHFP->ilngend;
+		ITURHFP->ilng = k%ITURHFP->ilngend;
+
+		// User feedback
+		if(ITURHFP->silent != TRUE) {
+			printf("\r%d", (*count)++);
+		}
+
+		if(blk->rtn[i] != RTN_P533OK) {
+			CopyPath(path, &blk->slot[i]);
+			return blk->rtn[i];
+		}
+
+		if(blk->pick != NULL) {
+			ITURHFP->server = blk->pick[i].tx;
+			ITURHFP->margin = blk->pick[i].margin;
+		}
+
+		// Write the output
+		if((ITURHFP->RptFileFormat & RPT_DUMPPATH) == RPT_DUMPPATH) {
+			DumpPathData(blk->slot[i], *ITURHFP);
+		}
+		else {
+			Report(blk->slot[i], *ITURHFP);
+		}
+	}
+
+	return RTN_ITURHFPropOK;
+
+}
+
+int AllocateBlock(struct AreaBlock *blk, struct PathData const *path, struct ITURHFProp const *ITURHFP, int nslot) {
+
+	/*
+	   AllocateBlock() - Sets up a block of nslot grid points for ParallelArea()
+
+			INPUT
+				struct AreaBlock *blk
+				struct PathData const *path
+				struct ITURHFProp const *ITURHFP
+				int nslot - Number of grid points in the block
+
+			OUTPUT
+				blk
+				returns RTN_ITURHFPropOK or RTN_ERRALLOCATEWORKERS
+
+			SUBROUTINES
+				None
+
+	 */
+
+	blk->path = path;
+	blk->ITURHFP = ITURHFP;
+	blk->prepare = FALSE;
+	blk->first = 0;
+	blk->n = 0;
+	blk->slot = (struct PathData *) malloc(nslot*sizeof(struct PathData));
+	blk->rtn = (int *) malloc(nslot*sizeof(int));
+	blk->pick = NULL;
+	if(ITURHFP->ntx > 0) blk->pick = (struct ServerPick *) malloc(nslot*sizeof(struct ServerPick));
+	if((blk->slot == NULL) || (blk->rtn == NULL) || ((ITURHFP->ntx > 0) && (blk->pick == NULL))) {
+		return RTN_ERRALLOCATEWORKERS;
+	}
+
+	return RTN_ITURHFPropOK;
+
+}
+
+void FreeBlock(struct AreaBlock *blk) {
+
+	/*
+	   FreeBlock() - Frees the memory of a block from AllocateBlock()
+
+			INPUT
+				struct AreaBlock *blk
+
+			OUTPUT
+				blk->slot, blk->rtn and blk->pick are freed and set to NULL
+
+			SUBROUTINES
+				None
+
+	 */
+
+	free(blk->slot);
+	free(blk->rtn);
+	free(blk->pick);
+	blk->slot = NULL;
+	blk->rtn = NULL;
+	blk->pick = NULL;
+
+}
+
+int PrepareArea(struct PathData *path, struct ITURHFProp *ITURHFP) {
+
+	/*
+	   PrepareArea() - Runs P533Prepare() for every receiver grid point in the area for the current month and hour. The
+			result for each point is saved in ITURHFP->prepared, which has one path for each point in the order of the
+			latitude and longitude loops. P533Frequency() then finishes the calculation for each frequency from the prepared
+			path without repeating the control points and the MUFs. When more than one thread is requested with the -j option
+			the points are spread over the threads as they are in ParallelArea().
+
+			For best-server coverage the area is prepared for each transmitter in turn. The points for transmitter t start
+			at ITURHFP->prepared[t*npts], where npts is the number of grid points.
+
+			INPUT
+				struct PathData *path - With the month and hour set
+				struct ITURHFProp *ITURHFP
+
+			OUTPUT
+				ITURHFP->prepared[]
+				returns RTN_ITURHFPropOK or the error from P533Prepare()
+
+			SUBROUTINES
+				SetTransmitter()
+				PrepareBlock()
+
+	 */
+
+	struct PathData txpath;	// The path for one of the transmitters
+
+	int retval;
+	int npts;		// Number of grid points
+	int t;
+
+	if(ITURHFP->ntx == 0) {
+		return PrepareBlock(path, ITURHFP, ITURHFP->prepared);
+	}
+
+	npts = ITURHFP->ilatend*ITURHFP->ilngend;
+
+	for(t=0; t<ITURHFP->ntx; t++) {
+		txpath = *path;
+		SetTransmitter(&txpath, ITURHFP, t);
+		retval = PrepareBlock(&txpath, ITURHFP, &ITURHFP->prepared[t*npts]);
+		if(retval != RTN_ITURHFPropOK) {
+			*path = txpath;
+			return retval;
+		}
+	}
+
+	return RTN_ITURHFPropOK;
+
+}
+
+int PrepareBlock(struct PathData *path, struct ITURHFProp *ITURHFP, struct PathData *prepared) {
+
+	/*
+	   PrepareBlock() - Runs P533Prepare() for every receiver grid point in the area for the path and saves the result for
+			each point in prepared[] (See PrepareArea()).
+
+			INPUT
+				struct PathData *path - With the month, hour and transmitter set
+				struct ITURHFProp *ITURHFP
+				struct PathData *prepared - One path for each grid point
+
+			OUTPUT
+				prepared[]
+				returns RTN_ITURHFPropOK or the error from P533Prepare()
+
+			SUBROUTINES
+				StartAreaPool()
+				SubmitBlock()
+				FinishBlock()
+				P533Prepare()
+
+	 */
+
+	struct AreaBlock blk;
+
+	int retval;
+	int npts;		// Number of grid points
+	int k;
+
+	npts = ITURHFP->ilatend*ITURHFP->ilngend;
+
+	if(ITURHFP->threads == 1) {
+		for(k=0; k<npts; k++) {
+			prepared[k] = *path;
+			prepared[k].L_rx.lat = ITURHFP->L_LL.lat + (k/ITURHFP->ilngend)*ITURHFP->latinc;
+			prepared[k].L_rx.lng = ITURHFP->L_LL.lng + (k%ITURHFP->ilngend)*ITURHFP->lnginc;
+			retval = dllP533Prepare(&prepared[k]);
+			if(retval != RTN_P533OK) {
+				*path = prepared[k];
+				return retval;
+			}
+		}
+
+		return RTN_ITURHFPropOK;
+	}
+
+	// All of the points are done in one block directly into the prepared paths
+	blk.path = path;
+	blk.ITURHFP = ITURHFP;
+	blk.prepare = TRUE;
+	blk.slot = prepared;
+	blk.pick = NULL;
+	blk.first = 0;
+	blk.n = npts;
+	blk.rtn = (int *) malloc(npts*sizeof(int));
+	if(blk.rtn == NULL) return RTN_ERRALLOCATEWORKERS;
+
+	retval = StartAreaPool(ITURHFP);
+	if(retval != RTN_ITURHFPropOK) {
+		free(blk.rtn);
+		return retval;
+	}
+
+	SubmitBlock(ITURHFP->pool, &blk);
+	FinishBlock(ITURHFP->pool, &blk);
+
+	for(k=0; k<npts; k++) {
+		if(blk.rtn[k] != RTN_P533OK) {
+			retval = blk.rtn[k];
+			*path = prepared[k];
+			free(blk.rtn);
+			return retval;
+		}
+	}
+
+	free(blk.rtn);
+
+	return RTN_ITURHFPropOK;
+
+}
+
+void SetTransmitter(struct PathData *path, struct ITURHFProp const *ITURHFP, int t) {
+
+	/*
+	   SetTransmitter() - Sets the path up for transmitter t of the best-server transmitters
+
+			INPUT
+				struct PathData *path
+				struct ITURHFProp const *ITURHFP
+				int t - Index of the transmitter in ITURHFP->tx[]
+
+			OUTPUT
+				path->txname, path->L_tx, path->txpower and path->A_tx
+
+			SUBROUTINES
+				None
+
+	 */
+
+	struct Transmitter const *tx = &ITURHFP->tx[t];
+
+	strcpy(path->txname, tx->Name);
+	path->L_tx = tx->L_tx;
+	path->txpower = tx->txpower;
+	path->A_tx = tx->A_tx;
+
+}
+
+int StartAreaPool(struct ITURHFProp *ITURHFP) {
+
+	/*
+	   StartAreaPool() - Starts ITURHFP->threads - 1 worker threads for ParallelArea() and PrepareArea() if they haven't
+			been started yet in this run. The calling thread is the last thread. If a thread can't be started the pool
+			has fewer workers and the blocks are still completed.
+
+			INPUT
+				struct ITURHFProp *ITURHFP
+
+			OUTPUT
+				ITURHFP->pool
+				returns RTN_ITURHFPropOK or RTN_ERRALLOCATEWORKERS
+
+			SUBROUTINES
+				PoolWorker()
+
+	 */
+
+	struct AreaPool *pool;
+
+	int t;
+
+	if(ITURHFP->pool != NULL) return RTN_ITURHFPropOK;
+
+	pool = (struct AreaPool *) malloc(sizeof(struct AreaPool));
+	if(pool == NULL) return RTN_ERRALLOCATEWORKERS;
+
+	pool->nworkers = 0;
+	pool->blk = NULL;
+	pool->generation = 0;
+	pool->inside = 0;
+	pool->quit = FALSE;
+
+#ifdef _WIN32
+	pool->hThread = (HANDLE *) malloc(MAX(ITURHFP->threads - 1, 1)*sizeof(HANDLE));
+#else
+	pool->hThread = (pthread_t *) malloc(MAX(ITURHFP->threads - 1, 1)*sizeof(pthread_t));
+#endif
+	if(pool->hThread == NULL) {
+		free(pool);
+		return RTN_ERRALLOCATEWORKERS;
+	}
+
+#ifdef _WIN32
+	InitializeCriticalSection(&pool->lock);
+	InitializeConditionVariable(&pool->work);
+	InitializeConditionVariable(&pool->idle);
+#else
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->work, NULL);
+	pthread_cond_init(&pool->idle, NULL);
+#endif
+
+	for(t=1; t<ITURHFP->threads; t++) {
+#ifdef _WIN32
+		pool->hThread[pool->nworkers] = CreateThread(NULL, 0, PoolWorker, pool, 0, NULL);
+		if(pool->hThread[pool->nworkers] != NULL) pool->nworkers++;
+#else
+		if(pthread_create(&pool->hThread[pool->nworkers], NULL, PoolWorker, pool) == 0) pool->nworkers++;
+#endif
+	}
+
+	ITURHFP->pool = pool;
+
+	return RTN_ITURHFPropOK;
+
+}
+
+void StopAreaPool(struct ITURHFProp *ITURHFP) {
+
+	/*
+	   StopAreaPool() - Stops the worker threads of ParallelArea() and PrepareArea() at the end of the run
+
+			INPUT
+				struct ITURHFProp *ITURHFP
+
+			OUTPUT
+				ITURHFP->pool is freed and set to NULL
+
+			SUBROUTINES
+				None
+
+	 */
+
+	struct AreaPool *pool = ITURHFP->pool;
+
+	int t;
+
+	if(pool == NULL) return;
+
+#ifdef _WIN32
+	EnterCriticalSection(&pool->lock);
+	pool->quit = TRUE;
+	WakeAllConditionVariable(&pool->work);
+	LeaveCriticalSection(&pool->lock);
+
+	for(t=0; t<pool->nworkers; t++) {
+		WaitForSingleObject(pool->hThread[t], INFINITE);
+		CloseHandle(pool->hThread[t]);
+	}
+
+	DeleteCriticalSection(&pool->lock);
+#else
+	pthread_mutex_lock(&pool->lock);
+	pool->quit = TRUE;
+	pthread_cond_broadcast(&pool->work);
+	pthread_mutex_unlock(&pool->lock);
+
+	for(t=0; t<pool->nworkers; t++) {
+		pthread_join(pool->hThread[t], NULL);
+	}
+
+	pthread_cond_destroy(&pool->work);
+	pthread_cond_destroy(&pool->idle);
+	pthread_mutex_destroy(&pool->lock);
+#endif
+
+	free(pool->hThread);
+	free(pool);
+	ITURHFP->pool = NULL;
+
+}
+
+void SubmitBlock(struct AreaPool *pool, struct AreaBlock *blk) {
+
+	/*
+	   SubmitBlock() - Makes the block the current block of the pool and wakes the workers to start on it. The previous
+			block must have been finished with FinishBlock().
+
+			INPUT
+				struct AreaPool *pool
+				struct AreaBlock *blk
+
+			OUTPUT
+				None
+
+			SUBROUTINES
+				None
+
+	 */
+
+	blk->next = 0;
+
+#ifdef _WIN32
+	EnterCriticalSection(&pool->lock);
+	pool->blk = blk;
+	pool->generation++;
+	WakeAllConditionVariable(&pool->work);
+	LeaveCriticalSection(&pool->lock);
+#else
+	pthread_mutex_lock(&pool->lock);
+	pool->blk = blk;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->work);
+	pthread_mutex_unlock(&pool->lock);
+#endif
+
+}
+
+void FinishBlock(struct AreaPool *pool, struct AreaBlock *blk) {
+
+	/*
+	   FinishBlock() - The calling thread calculates points of the current block until none are left and then waits until
+			no worker is in the block. Every point of the block has then been calculated. The block is then no longer the
+			current block, so a worker that wakes late doesn't go into it after the caller has reused or freed it.
+
+			INPUT
+				struct AreaPool *pool
+				struct AreaBlock *blk - The current block
+
+			OUTPUT
+				blk->slot[] - The calculated path for each point
+				blk->rtn[] - The return value for each point
+
+			SUBROUTINES
+				AreaWorker()
+
+	 */
+
+	AreaWorker(blk);
+
+#ifdef _WIN32
+	EnterCriticalSection(&pool->lock);
+	while(pool->inside > 0) SleepConditionVariableCS(&pool->idle, &pool->lock, INFINITE);
+	pool->blk = NULL;
+	LeaveCriticalSection(&pool->lock);
+#else
+	pthread_mutex_lock(&pool->lock);
+	while(pool->inside > 0) pthread_cond_wait(&pool->idle, &pool->lock);
+	pool->blk = NULL;
+	pthread_mutex_unlock(&pool->lock);
+#endif
+
+}
+
+#ifdef _WIN32
+DWORD WINAPI PoolWorker(LPVOID arg) {
+#else
+void *PoolWorker(void *arg) {
+#endif
+
+	/*
+	   PoolWorker() - A worker thread of the pool. It waits for a block to be submitted, calculates points of it until none
+			are left and waits for the next block, until the pool is stopped. A worker that wakes after a later block has been
+			submitted goes straight to the latest block.
+
+			INPUT
+				struct AreaPool *arg
+
+			OUTPUT
+				The points of the blocks the worker calculates
+
+			SUBROUTINES
+				AreaWorker()
+
+	 */
+
+	struct AreaPool *pool = (struct AreaPool *)arg;
+	struct AreaBlock *blk;
+
+	long seen = 0;	// The generation of the last block this worker was in
+
+	for(;;) {
+#ifdef _WIN32
+		EnterCriticalSection(&pool->lock);
+		while((pool->generation == seen) && (pool->quit != TRUE)) SleepConditionVariableCS(&pool->work, &pool->lock, INFINITE);
+		if(pool->quit == TRUE) {
+			LeaveCriticalSection(&pool->lock);
+			return 0;
+		}
+		seen = pool->generation;
+		blk = pool->blk;
+		if(blk == NULL) { // The block was finished without this worker
+			LeaveCriticalSection(&pool->lock);
+			continue;
+		}
+		pool->inside++;
+		LeaveCriticalSection(&pool->lock);
+#else
+		pthread_mutex_lock(&pool->lock);
+		while((pool->generation == seen) && (pool->quit != TRUE)) pthread_cond_wait(&pool->work, &pool->lock);
+		if(pool->quit == TRUE) {
+			pthread_mutex_unlock(&pool->lock);
+			return NULL;
+		}
+		seen = pool->generation;
+		blk = pool->blk;
+		if(blk == NULL) { // The block was finished without this worker
+			pthread_mutex_unlock(&pool->lock);
+			continue;
+		}
+		pool->inside++;
+		pthread_mutex_unlock(&pool->lock);
+#endif
+
+		AreaWorker(blk);
+
+#ifdef _WIN32
+		EnterCriticalSection(&pool->lock);
+		if(--pool->inside == 0) WakeAllConditionVariable(&pool->idle);
+		LeaveCriticalSection(&pool->lock);
+#else
+		pthread_mutex_lock(&pool->lock);
+		if(--pool->inside == 0) pthread_cond_broadcast(&pool->idle);
+		pthread_mutex_unlock(&pool->lock);
+#endif
+	}
+
+}
+
+void AreaWorker(struct AreaBlock *blk) {
+
+	/*
+	   AreaWorker() - Claims grid points from the block one at a time and calculates each of them in the point's own path
+			workspace until no points are left. The point is either prepared with P533Prepare(), finished from the prepared
+			path with P533Frequency() or fully calculated with P533().
+
+			INPUT
+				struct AreaBlock *blk
+
+			OUTPUT
+				blk->slot[] - The calculated path for each claimed point
+				blk->rtn[] - The return value for each claimed point
+
+			SUBROUTINES
+				ClaimPoint()
+				ServePoint()
+				P533()
+				P533Prepare()
+				P533Frequency()
+
+	 */
+
+	struct PathData *wrk;
+
+	long i;
+	int k;
+
+	while((i = ClaimPoint(&blk->next)) < blk->n) {
+		k = blk->first + (int)i;
+		wrk = &blk->slot[i];
+
+		if(blk->pick != NULL) {
+			blk->rtn[i] = ServePoint(blk, i);
+			continue;
+		}
+
+		if((blk->prepare != TRUE) && (blk->ITURHFP->prepared != NULL)) {
+			blk->rtn[i] = dllP533Frequency(wrk, &blk->ITURHFP->prepared[k], blk->path->frequency);
+			continue;
+		}
+
+		*wrk = *blk->path;
+		// The same expressions as the serial latitude and longitude loops
+		wrk->L_rx.lat = blk->ITURHFP->L_LL.lat + (k/blk->ITURHFP->ilngend)*blk->ITURHFP->latinc;
+		wrk->L_rx.lng = blk->ITURHFP->L_LL.lng + (k%blk->ITURHFP->ilngend)*blk->ITURHFP->lnginc;
+
+		if(blk->prepare == TRUE) {
+			blk->rtn[i] = dllP533Prepare(wrk);
+		}
+		else {
+			blk->rtn[i] = dllP533(wrk);
+		}
+	}
+
+}
+
+int ServePoint(struct AreaBlock *blk, long i) {
+
+	/*
+	   ServePoint() - Calculates the grid point for every best-server transmitter and keeps the path of the transmitter with
+			the highest median SNR. The noise at the receiver doesn't depend on the transmitter, so it is found for the
+			first transmitter and given to the others, whose calls to dllNoise() in P533() then return at once (See
+			struct NoiseMemo in Noise.h). If two transmitters have the same SNR the first of them is the best server.
+
+			INPUT
+				struct AreaBlock *blk
+				long i - Index of the point in the block
+
+			OUTPUT
+				blk->slot[i] - The calculated path for the best server
+				blk->pick[i] - The best server and its margin over the next best
+				returns RTN_P533OK or the error from P533() or P533Frequency() and then blk->slot[i] is the path
+					that failed
+
+			SUBROUTINES
+				SetTransmitter()
+				P533()
+				P533Frequency()
+
+	 */
+
+	struct ITURHFProp const *ITURHFP = blk->ITURHFP;
+	struct PathData *best = &blk->slot[i];
+	struct PathData cand;		// The path for the transmitter being tried
+	struct NoiseParams noise;	// The noise at the receiver from the first transmitter
+
+	double runner;				// SNR of the next best server (dB)
+
+	int retval;
+	int npts;					// Number of grid points
+	int k;
+	int t;
+
+	npts = ITURHFP->ilatend*ITURHFP->ilngend;
+	k = blk->first + (int)i;
+
+	runner = -TOOBIG;
+
+	for(t=0; t<ITURHFP->ntx; t++) {
+		if(ITURHFP->prepared != NULL) {
+			cand = ITURHFP->prepared[t*npts + k];
+		}
+		else {
+			cand = *blk->path;
+			SetTransmitter(&cand, ITURHFP, t);
+			// The same expressions as the serial latitude and longitude loops
+			cand.L_rx.lat = ITURHFP->L_LL.lat + (k/ITURHFP->ilngend)*ITURHFP->latinc;
+			cand.L_rx.lng = ITURHFP->L_LL.lng + (k%ITURHFP->ilngend)*ITURHFP->lnginc;
+		}
+
+		if(t > 0) cand.noiseP = noise;
+
+		if(ITURHFP->prepared != NULL) {
+			// Finish the prepared path in place
+			retval = dllP533Frequency(&cand, &cand, blk->path->frequency);
+		}
+		else {
+			retval = dllP533(&cand);
+		}
+		if(retval != RTN_P533OK) {
+			CopyPath(best, &cand);
+			return retval;
+		}
+
+		if(t == 0) noise = cand.noiseP;
+
+		if((t == 0) || (cand.SNR > best->SNR)) {
+			if(t > 0) runner = best->SNR;
+			CopyPath(best, &cand);
+			blk->pick[i].tx = t;
+		}
+		else if(cand.SNR > runner) {
+			runner = cand.SNR;
+		}
+	}
+
+	blk->pick[i].margin = best->SNR - runner;
+
+	return RTN_P533OK;
+
+}
+
+long ClaimPoint(volatile long *next) {
+
+	/*
+	   ClaimPoint() - Atomically takes the next unclaimed point in the block
+
+			INPUT
+				volatile long *next
+
+			OUTPUT
+				returns the index of the claimed point
+
+			SUBROUTINES
+				None
+
+	 */
+
+#ifdef _WIN32
+	return InterlockedIncrement(next) - 1;
+#else
+	return __sync_fetch_and_add(next, 1);
+#endif
+
+}
+
+void CopyPath(struct PathData *to, struct PathData const *from) {
+
+	/*
+	   CopyPath() - Copies a calculated path. to->DMptr is pointed at the dominant mode in to, not in from, so the
+			copy can still be reported after from has gone.
+
+			INPUT
+				struct PathData *to
+				struct PathData const *from
+
+			OUTPUT
+				*to - A copy of *from
+
+			SUBROUTINES
+				None
+
+	 */
+
+	*to = *from;
+
+	if(from->DMptr == NULL) return;
+
+	if(from->DMidx < MAXEMDS) { // E mode dominant
+		to->DMptr = &to->Md_E[from->DMidx];
+	}
+	else if(from->DMidx < MAXMDS) { // F2 mode dominant
+		to->DMptr = &to->Md_F2[from->DMidx - MAXEMDS];
+	}
+
+	return;
+
+}
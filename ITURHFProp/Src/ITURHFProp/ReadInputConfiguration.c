@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 
 // Local includes
 #include "Common.h"
@@ -12,6 +13,9 @@
 void substrbtwnchar(char instr[256], char searchchar, char * outstr);
 unsigned long OutputOption(char optstr[256]);
 void InitializeInput(struct ITURHFProp *ITURHFP, struct PathData *path);
+int ReadTransmitter(char line[256], struct ITURHFProp *ITURHFP);
+void CompleteTransmitters(struct ITURHFProp *ITURHFP, struct PathData *path);
+int ReadTXAntenna(struct Antenna *Ant, char const *AntFilePath, double bearing, double GOS, struct ITURHFProp ITURHFP);
 // End local prototypes
 
 int ReadInputConfiguration(char InFilePath[256], struct ITURHFProp *ITURHFP, struct PathData *path) {
@@ -263,6 +267,16 @@ int ReadInputConfiguration(char InFilePath[256], struct ITURHFProp *ITURHFP, str
 					path->SorL = LONGPATH;
 				}
             }
+            if (strncmp("Path.MagField", line, 13) == 0) {
+				// The name is between two quotes-find them.
+				substrbtwnchar(line, '\"', instr);
+				if (strcmp(instr, "EXACT") == 0) {
+					path->MagField = MAGFIELDEXACT;
+				}
+				else if (strcmp(instr, "GRID") == 0) {
+					path->MagField = MAGFIELDGRID;
+				}
+            }
             if (strncmp("RptFilePath", line, 11) == 0) {
 				// The name is between two quotes-find them.
 				substrbtwnchar(line, '\"', ITURHFP->RptFilePath);
@@ -356,6 +370,14 @@ int ReadInputConfiguration(char InFilePath[256], struct ITURHFProp *ITURHFP, str
 				// The name is between two quotes-find them.
 				substrbtwnchar(line, '\"', ITURHFP->DataFilePath);
 			}
+            // Best-server transmitters TX1.* to TX16.*
+			if ((strncmp("TX", line, 2) == 0) && isdigit((unsigned char)line[2])) {
+				retval = ReadTransmitter(line, ITURHFP);
+				if (retval != RTN_RICOK) {
+					fclose(fp);
+					return retval;
+				}
+			}
         }
         // Read the next line.
 		fgets(line, 256, fp);
@@ -375,6 +397,9 @@ int ReadInputConfiguration(char InFilePath[256], struct ITURHFProp *ITURHFP, str
 		ITURHFP->L_UR.lng = ITURHFP->L_LR.lng; // East
 	}
 
+    // Fill in anything that wasn't given for the best-server transmitters
+	CompleteTransmitters(ITURHFP, path);
+
     fclose(fp);
 
 	return RTN_RICOK;
@@ -575,6 +600,7 @@ void InitializeInput(struct ITURHFProp *ITURHFP, struct PathData *path) {
 	path->T0 = 0.0;
 	path->F0 = 0.0;
 	path->SorL= SHORTPATH;
+	path->MagField = MAGFIELDEXACT;
 
 	ITURHFP->TXGOS = 0.0;
 	ITURHFP->RXGOS = 0.0;
@@ -601,27 +627,144 @@ void InitializeInput(struct ITURHFProp *ITURHFP, struct PathData *path) {
 	ITURHFP->latinc = 1.0;
 	ITURHFP->lnginc = 1.0;
 	sprintf(ITURHFP->DataFilePath, ".");
+	ITURHFP->ntx = 0;
+	ITURHFP->tx = NULL;
+	ITURHFP->server = 0;
+	ITURHFP->margin = 0.0;
 
 	return;
 
 }
 
+int ReadTransmitter(char line[256], struct ITURHFProp *ITURHFP) {
 
-int ReadAntennaPatterns(struct PathData *path, struct ITURHFProp ITURHFP) {
+	/*
+		ReadTransmitter() - Reads one parameter of a best-server transmitter from a line of the input file. The line is
+			TXn.<parameter> <value> where n is from 1 to MAXTX and the parameters are
+				TXn.Name "Text name of the transmitting site"
+				TXn.lat Transmit antenna latitude (deg)
+				TXn.lng Transmit antenna longitude (deg)
+				TXn.txpower Transmit power (dB(kW))
+				TXn.AntFilePath "Path and filename of the transmit antenna pattern or ISOTROPIC"
+				TXn.Bearing Main beam bearing (deg)
+				TXn.GOS Transmit antenna gain offset (dB)
+			The number of transmitters is the largest n in the file.
+
+			INPUT
+				char line[256]
+				struct ITURHFProp *ITURHFP
+
+			OUTPUT
+				ITURHFP->tx[n-1]
+				ITURHFP->ntx
+				returns RTN_RICOK or RTN_ERRTXLIST if n is out of range
+	*/
 
 	#ifdef __GNUC__
 	#pragma GCC diagnostic push
 	#pragma GCC diagnostic ignored "-Wunused-result"
 	#endif
 
-	int retval;
-    int antType;
-    int lineCtr;
+	struct Transmitter *tx;
 
-    FILE *fp;
-	
-	char line[256];		// Read input line
-	char instr[256];	// String temp
+	char field[32];
+
+	int n;
+	int i;
+
+	if ((sscanf(line, "TX%d.%31[A-Za-z]", &n, field) != 2) || (n < 1) || (n > MAXTX)) {
+		printf("ReadingInputConfiguration: ERROR Invalid transmitter - %s", line);
+		return RTN_ERRTXLIST;
+	}
+
+	// The transmitters are allocated when the first one is found
+	if (ITURHFP->tx == NULL) {
+		ITURHFP->tx = (struct Transmitter *) malloc(MAXTX*sizeof(struct Transmitter));
+		if (ITURHFP->tx == NULL) return RTN_ERRTXLIST;
+		for (i = 0; i < MAXTX; i++) {
+			ITURHFP->tx[i].Name[0] = '\0';
+			ITURHFP->tx[i].L_tx.lat = TOOBIG;
+			ITURHFP->tx[i].L_tx.lng = TOOBIG;
+			ITURHFP->tx[i].txpower = TOOBIG;
+			ITURHFP->tx[i].AntFilePath[0] = '\0';
+			ITURHFP->tx[i].Bearing = TOOBIG;
+			ITURHFP->tx[i].GOS = TOOBIG;
+		}
+	}
+
+	ITURHFP->ntx = MAX(ITURHFP->ntx, n);
+	tx = &ITURHFP->tx[n-1];
+
+	if (strcmp(field, "Name") == 0) {
+		// The name is between two quotes-find them.
+		substrbtwnchar(line, '\"', tx->Name);
+	}
+	else if (strcmp(field, "lat") == 0) {
+		sscanf(line, "%*s %lf", &tx->L_tx.lat);
+		tx->L_tx.lat = tx->L_tx.lat*D2R;
+	}
+	else if (strcmp(field, "lng") == 0) {
+		sscanf(line, "%*s %lf", &tx->L_tx.lng);
+		tx->L_tx.lng = tx->L_tx.lng*D2R;
+	}
+	else if (strcmp(field, "txpower") == 0) {
+		sscanf(line, "%*s %lf", &tx->txpower);
+	}
+	else if (strcmp(field, "AntFilePath") == 0) {
+		// The name is between two quotes-find them.
+		substrbtwnchar(line, '\"', tx->AntFilePath);
+	}
+	else if (strcmp(field, "Bearing") == 0) {
+		sscanf(line, "%*s %lf", &tx->Bearing);
+		tx->Bearing = tx->Bearing*D2R;
+	}
+	else if (strcmp(field, "GOS") == 0) {
+		sscanf(line, "%*s %lf", &tx->GOS);
+	}
+
+	return RTN_RICOK;
+
+	#ifdef __GNUC__
+	#pragma GCC diagnostic pop
+	#endif
+}
+
+void CompleteTransmitters(struct ITURHFProp *ITURHFP, struct PathData *path) {
+
+	/*
+		CompleteTransmitters() - Gives each best-server transmitter the single path value of any parameter that wasn't in
+			the input file. The location has no default and is checked by ValidateITURHFP().
+
+			INPUT
+				struct ITURHFProp *ITURHFP
+				struct PathData *path
+
+			OUTPUT
+				ITURHFP->tx[]
+	*/
+
+	struct Transmitter *tx;
+
+	int i;
+
+	for (i = 0; i < ITURHFP->ntx; i++) {
+		tx = &ITURHFP->tx[i];
+		if (tx->Name[0] == '\0') sprintf(tx->Name, "Transmitter %d", i + 1);
+		if (tx->txpower == TOOBIG) tx->txpower = path->txpower;
+		if (tx->AntFilePath[0] == '\0') strcpy(tx->AntFilePath, ITURHFP->TXAntFilePath);
+		if (tx->Bearing == TOOBIG) tx->Bearing = ITURHFP->TXBearing;
+		if (tx->GOS == TOOBIG) tx->GOS = ITURHFP->TXGOS;
+	}
+
+	return;
+
+}
+
+
+int ReadAntennaPatterns(struct PathData *path, struct ITURHFProp ITURHFP) {
+
+	int retval;
+	int i;
 
 	// User feedback
 	if(ITURHFP.silent != TRUE) {
@@ -638,51 +781,31 @@ int ReadAntennaPatterns(struct PathData *path, struct ITURHFProp ITURHFP) {
 		// Store the name of the antenna to the path structure.
 		strcpy(path->A_rx.Name, "ISOTROPIC");
 	} else {
-	    //If it's not an ISOTROPIC, open the file and take a look...
-	    /* VOACAP type antennas identify the antenna type on the forth
-	     * line; e.g;
-         *   14    [ 2] Antenna Type..: 30 x (efficiency + 91 gain values) follow
-         */
-	    fp = fopen(ITURHFP.RXAntFilePath, "r");
-
-	    if (fp == NULL) {
-            if(ITURHFP.silent != TRUE) {
+		// Antennas that are used more than once share one pattern (See RegisterAntenna())
+		retval = dllRegisterAntennaFunc(&path->A_rx, ITURHFP.RXAntFilePath, ITURHFP.RXBearing, ITURHFP.antcache, ITURHFP.silent);
+		if(retval == RTN_ERRCANTOPENANTFILE) {
+			if(ITURHFP.silent != TRUE) {
 				printf("Error opening Rx. antenna file %.65s\n", ITURHFP.RXAntFilePath);
 			}
-            return RTN_ERRCANTOPENRXANTFILE;
-	    }
-
-        for (lineCtr = 0 ; lineCtr<4 ; ++lineCtr) {
-		    fgets(line, sizeof(line), fp);		// Scroll to line 3, Antenna type
-	    }
-
-	    sscanf(line, " %d %s\n", &antType, instr);
-        rewind(fp);
-
-	    if(antType == 11) {
-		    retval = dllReadType11Func(&path->A_rx, fp, ITURHFP.silent);
-            fclose(fp);
-		    if(retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-            }
-		} else if(antType == 13) {
-		    retval = dllReadType13Func(&path->A_rx, fp, ITURHFP.RXBearing, ITURHFP.silent);
-            fclose(fp);
-		    if (retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-		    }
-        } else if (antType == 14) {
-		    retval = dllReadType14Func(&path->A_rx, fp, ITURHFP.silent);
-            fclose(fp);
-		    if (retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-		    }
-        } else {
-            printf("Unsuppported antenna type: %d\n",antType);
-            return RTN_ERRCANTOPENRXANTFILE;
-        }
+			return RTN_ERRCANTOPENRXANTFILE;
+		}
+		else if(retval != RTN_READANTENNAPATTERNSOK) {
+			return retval;
+		}
     } // end of the rx antenna type
 
+	// For best-server coverage each transmitter has its own antenna and the path takes the first
+	if(ITURHFP.ntx > 0) {
+		for(i=0; i<ITURHFP.ntx; i++) {
+			retval = ReadTXAntenna(&ITURHFP.tx[i].A_tx, ITURHFP.tx[i].AntFilePath, ITURHFP.tx[i].Bearing, ITURHFP.tx[i].GOS, ITURHFP);
+			if(retval != RTN_READANTENNAPATTERNSOK) {
+				return retval;
+			}
+		}
+		path->A_tx = ITURHFP.tx[0].A_tx;
+		return RTN_READANTENNAPATTERNSOK;
+	}
+
 	// Determine the type of transmitter antenna file.
 	if(strcmp(ITURHFP.TXAntFilePath, "ISOTROPIC") == 0) { // Isotropic Antenna
 		ITURHFP.txantfp = NULL;
@@ -690,48 +813,59 @@ int ReadAntennaPatterns(struct PathData *path, struct ITURHFProp ITURHFP) {
 		// Store the name of the antenna to the path structure.
 		strcpy(path->A_tx.Name, "ISOTROPIC");
 	} else {
-        fp = fopen(ITURHFP.TXAntFilePath, "r");
-
-	    if (fp == NULL) {
+		// Antennas that are used more than once share one pattern (See RegisterAntenna())
+		retval = dllRegisterAntennaFunc(&path->A_tx, ITURHFP.TXAntFilePath, ITURHFP.TXBearing, ITURHFP.antcache, ITURHFP.silent);
+		if(retval == RTN_ERRCANTOPENANTFILE) {
 			if(ITURHFP.silent != TRUE) {
 				printf("Error opening Tx. antenna file %.65s\n", ITURHFP.TXAntFilePath);
 			}
-            return RTN_ERRCANTOPENTXANTFILE;
-	    }
-        for (lineCtr = 0 ; lineCtr<4 ; ++lineCtr) {
-		    fgets(line, sizeof(line), fp);		// Antenna type
-	    }
-	    sscanf(line, " %d %s\n", &antType, instr);
-
-        rewind(fp);
-
-	    if(antType == 11) {
-		    retval = dllReadType11Func(&path->A_tx, fp, ITURHFP.silent);
-            fclose(fp);
-		    if(retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-            }
-		} else if(antType == 13) {
-		    retval = dllReadType13Func(&path->A_tx, fp, ITURHFP.TXBearing, ITURHFP.silent);
-            fclose(fp);
-		    if(retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-            }
-		} else if (antType == 14) {
-		    retval = dllReadType14Func(&path->A_tx, fp, ITURHFP.silent);
-            fclose(fp);
-		    if (retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-		    }
-        } else {
-			printf("Unsuppported antenna type: %d\n",antType);
-            return RTN_ERRCANTOPENTXANTFILE;
-	    }
+			return RTN_ERRCANTOPENTXANTFILE;
+		}
+		else if(retval != RTN_READANTENNAPATTERNSOK) {
+			return retval;
+		}
     }
 	return RTN_READANTENNAPATTERNSOK;
 
-	#ifdef __GNUC__
-	#pragma GCC diagnostic pop
-	#endif
+}
+
+int ReadTXAntenna(struct Antenna *Ant, char const *AntFilePath, double bearing, double GOS, struct ITURHFProp ITURHFP) {
+
+	/*
+		ReadTXAntenna() - Reads the antenna of a best-server transmitter as ReadAntennaPatterns() reads the transmit
+			antenna of the single path
+
+			INPUT
+				struct Antenna *Ant
+				char const *AntFilePath - Path and filename of the antenna pattern or "ISOTROPIC"
+				double bearing - Main beam bearing (rad)
+				double GOS - Gain offset (dB) of an isotropic antenna
+				struct ITURHFProp ITURHFP
+
+			OUTPUT
+				Ant - The antenna pattern
+				returns RTN_READANTENNAPATTERNSOK, RTN_ERRCANTOPENTXANTFILE or the error from RegisterAntenna()
+	*/
+
+	int retval;
+
+	if(strcmp(AntFilePath, "ISOTROPIC") == 0) { // Isotropic Antenna
+		dllIsotropicPatternFunc(Ant, GOS, ITURHFP.silent);
+		// Store the name of the antenna to the path structure.
+		strcpy(Ant->Name, "ISOTROPIC");
+		return RTN_READANTENNAPATTERNSOK;
+	}
+
+	// Antennas that are used more than once share one pattern (See RegisterAntenna())
+	retval = dllRegisterAntennaFunc(Ant, AntFilePath, bearing, ITURHFP.antcache, ITURHFP.silent);
+	if(retval == RTN_ERRCANTOPENANTFILE) {
+		if(ITURHFP.silent != TRUE) {
+			printf("Error opening Tx. antenna file %.65s\n", AntFilePath);
+		}
+		return RTN_ERRCANTOPENTXANTFILE;
+	}
+
+	return retval;
+
 }
 
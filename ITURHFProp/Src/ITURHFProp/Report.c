@@ -65,6 +65,8 @@ void function_RPT_DOMMODE(struct PathData path, int option, int *col);
 void function_RPT_RXLOCATION(struct PathData path, int option, int *col);
 void function_RPT_ESL(struct PathData path, int option, int *col);
 void function_RPT_LONG(struct PathData path, int option, int *col);
+void function_BESTSERVER(struct ITURHFProp ITURHFP, int option, int *col);
+void PrintTransmitters(struct ITURHFProp ITURHFP);
 // End local prototypes
 
 // Local globals
@@ -190,6 +192,10 @@ void PrintRecord(struct PathData path, struct ITURHFProp ITURHFP, int option) {
 			break;
 	}
 
+    // Best-server coverage always reports the best server
+	if(ITURHFP.ntx > 0) {
+		function_BESTSERVER(ITURHFP, option, &col);
+	}
     if((ITURHFP.RptFileFormat & RPT_RXLOCATION) == RPT_RXLOCATION) {
 		function_RPT_RXLOCATION(path, option, &col);
 	}
@@ -310,15 +316,20 @@ void PrintHeader(struct PathData path, struct ITURHFProp ITURHFP) {
 	fprintf(fp, "\tSSN (R12)     : %d\n", path.SSN);
 	fprintf(fp, "\tDistance      : %lf (km)\n", path.distance);
 	fprintf(fp, "\tdmax          : %lf (km)\n", path.dmax);
-	fprintf(fp, "\tTx power      : %lf\n", path.txpower);
-	fprintf(fp, "\tTx Location     %s\n", path.txname);
-	fprintf(fp, "\tTx latitude   : %10.6lf %c\n", fabs(path.L_tx.lat*R2D), NS(path.L_tx.lat));
-	fprintf(fp, "\tTx longitude  : %10.6lf %c\n", fabs(path.L_tx.lng*R2D), EW(path.L_tx.lng));
+	// The best-server transmitters are listed below
+	if(ITURHFP.ntx == 0) {
+		fprintf(fp, "\tTx power      : %lf\n", path.txpower);
+		fprintf(fp, "\tTx Location     %s\n", path.txname);
+		fprintf(fp, "\tTx latitude   : %10.6lf %c\n", fabs(path.L_tx.lat*R2D), NS(path.L_tx.lat));
+		fprintf(fp, "\tTx longitude  : %10.6lf %c\n", fabs(path.L_tx.lng*R2D), EW(path.L_tx.lng));
+	}
 	fprintf(fp, "\tRx Location     %s\n", path.rxname);
 	fprintf(fp, "\tRx latitude   : %10.6lf %c\n", fabs(path.L_rx.lat*R2D), NS(path.L_rx.lat));
 	fprintf(fp, "\tRx longitude  : %10.6lf %c\n", fabs(path.L_rx.lng*R2D), EW(path.L_rx.lng));
 	fprintf(fp, "\tlocal time Rx : %d (hour UTC)\n", (int)fmod((path.hour + 1 + (int)(path.L_rx.lng/(15.0*D2R)))+24,24.0));
-	fprintf(fp, "\tlocal time Tx : %d (hour UTC)\n", (int)fmod((path.hour + 1 + (int)(path.L_tx.lng/(15.0*D2R)))+24,24.0));
+	if(ITURHFP.ntx == 0) {
+		fprintf(fp, "\tlocal time Tx : %d (hour UTC)\n", (int)fmod((path.hour + 1 + (int)(path.L_tx.lng/(15.0*D2R)))+24,24.0));
+	}
 	fprintf(fp, "\tFrequency     : %lf\n", path.frequency);
 	fprintf(fp, "\tBandwidth     : %lf\n", path.BW);
 
@@ -391,13 +402,22 @@ void PrintHeader(struct PathData path, struct ITURHFProp ITURHFP) {
 		strcpy(outstr, "ERROR");
 	}
     fprintf(fp, "\tPath Direction : %s\n", outstr);
+	// The magnetic field grid is only reported when it is used so the default report is unchanged
+	if (path.MagField == MAGFIELDGRID) {
+		fprintf(fp, "\tMagnetic field : GRID\n");
+	}
 
-	fprintf(fp, "\tTransmit antenna               %.40s\n", path.A_tx.Name);
-	fprintf(fp, "\tTransmit antenna bearing     : %lf\n", ITURHFP.TXBearing*R2D);
-	fprintf(fp, "\tTransmit antenna gain offset : %lf\n", ITURHFP.TXGOS);
+	if(ITURHFP.ntx == 0) {
+		fprintf(fp, "\tTransmit antenna               %.40s\n", path.A_tx.Name);
+		fprintf(fp, "\tTransmit antenna bearing     : %lf\n", ITURHFP.TXBearing*R2D);
+		fprintf(fp, "\tTransmit antenna gain offset : %lf\n", ITURHFP.TXGOS);
+	}
 	fprintf(fp, "\tReceive antenna                %.40s\n", path.A_rx.Name);
 	fprintf(fp, "\tReceive antenna bearing      : %lf\n", ITURHFP.RXBearing*R2D);
 	fprintf(fp, "\tReceive antenna gain offset  : %lf\n", ITURHFP.RXGOS);
+	if(ITURHFP.ntx > 0) {
+		PrintTransmitters(ITURHFP);
+	}
 
 	fprintf(fp, "\n");
 	fprintf(fp, "************************ End P533 Input Parameters *****************************\n");
@@ -1369,3 +1389,53 @@ char NS(double lat) {
 
 }
 
+void PrintTransmitters(struct ITURHFProp ITURHFP) {
+
+	/*
+	 * PrintTransmitters() Lists the transmitters that are compared for best-server coverage in the report header
+	 */
+
+	int i;
+
+	fprintf(fp, "\n");
+	fprintf(fp, "\tBest server of %d transmitters (highest median SNR)\n", ITURHFP.ntx);
+	for(i=0; i<ITURHFP.ntx; i++) {
+		fprintf(fp, "\tTx %2d           %s\n", i + 1, ITURHFP.tx[i].Name);
+		fprintf(fp, "\t  Tx power      : %lf\n", ITURHFP.tx[i].txpower);
+		fprintf(fp, "\t  Tx latitude   : %10.6lf %c\n", fabs(ITURHFP.tx[i].L_tx.lat*R2D), NS(ITURHFP.tx[i].L_tx.lat));
+		fprintf(fp, "\t  Tx longitude  : %10.6lf %c\n", fabs(ITURHFP.tx[i].L_tx.lng*R2D), EW(ITURHFP.tx[i].L_tx.lng));
+		fprintf(fp, "\t  Transmit antenna               %.40s\n", ITURHFP.tx[i].A_tx.Name);
+		fprintf(fp, "\t  Transmit antenna bearing     : %lf\n", ITURHFP.tx[i].Bearing*R2D);
+		fprintf(fp, "\t  Transmit antenna gain offset : %lf\n", ITURHFP.tx[i].GOS);
+	}
+
+	return;
+
+}
+
+void function_BESTSERVER(struct ITURHFProp ITURHFP, int option, int *col) {
+	switch(option) {
+		case PRINT_HEADER:
+			fprintf(fp, "Column %02d: TX - Best server (Tx number above)\n", ++*col);
+			fprintf(fp, "Column %02d: Margin - Median SNR of the best server above the next best (dB)\n", ++*col);
+			break;
+		case PRINT_RFC4180_HEADER:
+			fprintf(fp, ",tx,margin");
+			*col = *col+2;
+			break;
+		case PRINT_DATA:
+			fprintf(fp,",");
+			fprintf(fp, "%3d", ITURHFP.server + 1);
+			fprintf(fp,",");
+			fprintf(fp, DBLFIELD, ITURHFP.margin);
+			break;
+		case PRINT_RFC4180_DATA:
+			fprintf(fp,",");
+			fprintf(fp, "%d", ITURHFP.server + 1);
+			fprintf(fp,",");
+			fprintf(fp, RFC4180_DBLFIELD, ITURHFP.margin);
+			break;
+	}
+    return;
+}
+
@@ -10,6 +10,8 @@
 
 
 int ValidateITURHFP(struct ITURHFProp ITURHFP) {
+
+	int i;
 	
 	if((ITURHFP.TXBearing > 2.0*PI) || (ITURHFP.TXBearing < 0.0))							return RTN_ERRTXBEARING;
 	if((ITURHFP.RXBearing > 2.0*PI) || (ITURHFP.RXBearing < 0.0))							return RTN_ERRRXBEARING;
@@ -46,6 +48,15 @@ int ValidateITURHFP(struct ITURHFProp ITURHFP) {
 
 	if ((ITURHFP.AntennaOrientation != MANUAL) && (ITURHFP.AntennaOrientation != TX2RX))		return RTN_ERRANTENNAORN;
 
+	// Best-server coverage compares at least two transmitters, each of which must have a location
+	if(ITURHFP.ntx == 1)																		return RTN_ERRTXLIST;
+	for(i=0; i<ITURHFP.ntx; i++) {
+		if((ITURHFP.tx[i].L_tx.lat < -PI/2.0) || (ITURHFP.tx[i].L_tx.lat > PI/2.0))				return RTN_ERRTXLIST;
+		if((ITURHFP.tx[i].L_tx.lng < -PI) || (ITURHFP.tx[i].L_tx.lng > PI))						return RTN_ERRTXLIST;
+		if((ITURHFP.tx[i].Bearing > 2.0*PI) || (ITURHFP.tx[i].Bearing < 0.0))					return RTN_ERRTXBEARING;
+		if((ITURHFP.tx[i].GOS < TINYDB) || (ITURHFP.tx[i].GOS > 60.0))							return RTN_ERRTXGOS;
+	}
+
 	return RTN_VALIDATEITURHFPOK;
 }
 
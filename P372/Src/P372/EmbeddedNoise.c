@@ -0,0 +1,100 @@
+#if !defined(_WIN32) && defined(EMBEDDATA)
+    #define _POSIX_C_SOURCE 200809L // fmemopen()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Common.h"
+#include "Noise.h"
+
+/*
+    When libp372.so is built with "make EMBEDDATA=1" the atmospheric noise
+    coefficient files COEFF01W.txt to COEFF12W.txt are linked into the
+    library by EmbeddedNoiseFiles.S. ReadFamDud() then reads them from memory
+    rather than from DataFilePath. In any other build OpenEmbeddedNoise()
+    always returns NULL and the files are read from DataFilePath as before.
+ */
+
+#ifdef EMBEDDATA
+
+#define EMBEDDED(sym, name) { name, sym, sym##_end }
+
+// Symbols defined in EmbeddedNoiseFiles.S
+extern char const P372Data_COEFF01W[], P372Data_COEFF01W_end[];
+extern char const P372Data_COEFF02W[], P372Data_COEFF02W_end[];
+extern char const P372Data_COEFF03W[], P372Data_COEFF03W_end[];
+extern char const P372Data_COEFF04W[], P372Data_COEFF04W_end[];
+extern char const P372Data_COEFF05W[], P372Data_COEFF05W_end[];
+extern char const P372Data_COEFF06W[], P372Data_COEFF06W_end[];
+extern char const P372Data_COEFF07W[], P372Data_COEFF07W_end[];
+extern char const P372Data_COEFF08W[], P372Data_COEFF08W_end[];
+extern char const P372Data_COEFF09W[], P372Data_COEFF09W_end[];
+extern char const P372Data_COEFF10W[], P372Data_COEFF10W_end[];
+extern char const P372Data_COEFF11W[], P372Data_COEFF11W_end[];
+extern char const P372Data_COEFF12W[], P372Data_COEFF12W_end[];
+
+struct EmbeddedFile {
+    char const *name;   // File name as it would be in DataFilePath
+    char const *start;  // First byte of the file
+    char const *end;    // One past the last byte of the file
+};
+
+static struct EmbeddedFile const embedded[] = {
+    EMBEDDED(P372Data_COEFF01W, "COEFF01W.txt"),
+    EMBEDDED(P372Data_COEFF02W, "COEFF02W.txt"),
+    EMBEDDED(P372Data_COEFF03W, "COEFF03W.txt"),
+    EMBEDDED(P372Data_COEFF04W, "COEFF04W.txt"),
+    EMBEDDED(P372Data_COEFF05W, "COEFF05W.txt"),
+    EMBEDDED(P372Data_COEFF06W, "COEFF06W.txt"),
+    EMBEDDED(P372Data_COEFF07W, "COEFF07W.txt"),
+    EMBEDDED(P372Data_COEFF08W, "COEFF08W.txt"),
+    EMBEDDED(P372Data_COEFF09W, "COEFF09W.txt"),
+    EMBEDDED(P372Data_COEFF10W, "COEFF10W.txt"),
+    EMBEDDED(P372Data_COEFF11W, "COEFF11W.txt"),
+    EMBEDDED(P372Data_COEFF12W, "COEFF12W.txt")
+};
+
+#endif
+
+FILE *OpenEmbeddedNoise(
+    const char *name
+) {
+    /*
+    Open a coefficient file that was compiled into the library as a read
+    only stream in memory. The caller reads it with the usual stdio routines
+    and closes it with fclose().
+
+        INPUT
+            const char *name - The file name without a directory
+
+        OUTPUT
+            returns the stream or NULL if the file was not compiled in
+     */
+
+#ifdef EMBEDDATA
+    size_t i;
+
+    for (i = 0; i < sizeof(embedded) / sizeof(embedded[0]); i++) {
+        if (strcmp(name, embedded[i].name) == 0) {
+            return fmemopen((void *)embedded[i].start, (size_t)(embedded[i].end - embedded[i].start), "rb");
+        }
+    }
+#else
+    (void)name;
+#endif
+
+    return NULL;
+}
+
+int EmbeddedNoise(void) {
+    /*
+    Return TRUE if the coefficient files were compiled into the library.
+     */
+
+#ifdef EMBEDDATA
+    return TRUE;
+#else
+    return FALSE;
+#endif
+}
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Common.h"
+#include "Noise.h"
+
+/*
+    FamDudConvert - Converts the atmospheric noise coefficient files
+    COEFF01W.txt to COEFF12W.txt into the binary files FamDud01.bin to
+    FamDud12.bin that ReadFamDud() loads with a single read. The binary files
+    are written in the same directory. This only needs to be done once on each
+    machine, since the binary files are in the machine's own double format.
+
+    This is not part of the libp372.so build. On Linux or macOS build and run
+    it from P372/Linux with
+        make FamDudConvert
+        LD_LIBRARY_PATH=. ./FamDudConvert DataFilePath
+
+    where DataFilePath is the directory of the data files, ending in a '/', as
+    in the ITURHFProp input file.
+ */
+
+int main(int argc, char *argv[]) {
+    struct NoiseParams noiseP;
+    int retval;
+    int month;
+
+    if ((argc != 2) || (strlen(argv[1]) >= 256)) {
+        printf("Usage: FamDudConvert DataFilePath\n");
+        return EXIT_FAILURE;
+    }
+
+    retval = AllocateNoiseMemory(&noiseP);
+    if (retval != RTN_ALLOCATEP372OK) {
+        printf("FamDudConvert: Error %d allocating the coefficients\n", retval);
+        return retval;
+    }
+
+    for (month = 0; month < 12; month++) {
+        retval = ReadFamDudTxt(&noiseP, argv[1], month);
+        if (retval != RTN_READFAMDUDOK) break;
+
+        retval = WriteFamDudBin(&noiseP, argv[1], month);
+        if (retval != RTN_READFAMDUDOK) break;
+    }
+
+    FreeNoiseMemory(&noiseP);
+
+    if (retval != RTN_READFAMDUDOK) {
+        printf("FamDudConvert: Error %d\n", retval);
+        return retval;
+    }
+
+    return EXIT_SUCCESS;
+}
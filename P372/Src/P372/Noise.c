@@ -8,7 +8,42 @@
 #include "Common.h"
 #include "Noise.h"
 
+// Local defines
+// Binary coefficient file FamDudXX.bin (See ReadFamDudBin())
+#define FAMDUDMAGIC "P372FDUD"
+#define FAMDUDVERSION 1
+#define FAMDUDCHECK 1234.5 // Detects a file that was made on a machine with a different double format
+// End Local defines
+
+// Local structures
+struct FamDudHeader {
+    char magic[8];  // FAMDUDMAGIC
+    int version;    // FAMDUDVERSION
+    int nfakp;      // NFAKP
+    int nfakabp;    // NFAKABP
+    int ndud;       // NDUD
+    int nfam;       // NFAM
+    double check;   // FAMDUDCHECK
+};
+// End Local structures
+
+// Local variables
+// Number of times coefficients have been read into a block. It is part of
+// the key of struct FamCache so an entry is not used after the block it
+// was made from has been read again.
+static unsigned int FamDudReads = 0;
+// End Local variables
+
 // Local prototypes
+// EmbeddedNoise.c
+FILE *OpenEmbeddedNoise(
+    const char *name
+);
+int EmbeddedNoise(void);
+// Noise.c
+void MakeFamDudHeader(
+    struct FamDudHeader *header
+);
 void GalacticNoise(
     struct NoiseParams *noiseP,
     double frequency
@@ -24,6 +59,26 @@ void GetFamParameters(
     double lat,
     double frequency
 );
+double FindFam1MHz(
+    struct NoiseParams *noiseP,
+    int tmblk,
+    double lng,
+    double lat
+);
+void NoteFamDudRead(
+    struct NoiseParams *noiseP
+);
+void MemoNoise(
+    struct NoiseParams *noiseP
+);
+void RecallNoise(
+    struct NoiseParams *noiseP
+);
+void SineHarmonics(
+    double q,
+    int n,
+    double s[]
+);
 // End Local prototypes
 
 int Noise(
@@ -69,10 +124,17 @@ int Noise(
             noiseP->DuM - Upper decile deviation of man-made noise
             noiseP->DlM - Lower decile deviation of man-made noise
 
+            noiseP->memo
+
+        If the inputs and the coefficients are the same as for the last
+        call the outputs are copied from noiseP->memo (See RecallNoise()).
+
         SUBROUTINES
             AtmosphericNoise()
             GalacticNoise()
             ManMadeNoise()
+            MemoNoise()
+            RecallNoise()
 
             ******************************************************************
             These software methods for the prediction of the performance of HF
@@ -106,6 +168,17 @@ int Noise(
     double sigmaT;
     double FamTu, FamTl;
 
+    struct NoiseMemo *nm = &noiseP->memo;
+
+    if ((nm->valid != 0) && (nm->fakp == noiseP->fakp) &&
+        (nm->reads == FamDudReads) && (nm->hour == hour) &&
+        (nm->lng == rlng) && (nm->lat == rlat) &&
+        (nm->frequency == frequency) &&
+        (nm->ManMadeNoise == noiseP->ManMadeNoise)) {
+        RecallNoise(noiseP);
+        return RTN_NOISEOK;
+    }
+
     // ******************************************************************* //
     // **************** Noise Calulation Override ************************ //
     // ******************************************************************* //
@@ -136,6 +209,8 @@ int Noise(
 
         noiseP->FamT = -noiseP->ManMadeNoise;
 
+        nm->valid = 0;
+
         return RTN_NOISEOK;
     }
     // ********************************************************************* //
@@ -171,26 +246,26 @@ int Noise(
 
     c = 10.0 / log(10.0);
 
-    alphaT = exp((noiseP->FaA / c) + (pow(sigmaA, 2) / (2.0 * pow(c, 2)))) +
-        exp((noiseP->FaG / c) + (pow(sigmaG, 2) / (2.0 * pow(c, 2)))) +
-        exp((noiseP->FaM / c) + (pow(sigmaM, 2) / (2.0 * pow(c, 2))));
+    alphaT = EXPDB((noiseP->FaA / c) + (pow(sigmaA, 2) / (2.0 * pow(c, 2)))) +
+        EXPDB((noiseP->FaG / c) + (pow(sigmaG, 2) / (2.0 * pow(c, 2)))) +
+        EXPDB((noiseP->FaM / c) + (pow(sigmaM, 2) / (2.0 * pow(c, 2))));
 
-    betaT = pow(exp((noiseP->FaA / c) + (pow(sigmaA, 2) / (2.0 * pow(c, 2)))), 2) * (exp(pow(sigmaA / c, 2)) - 1.0) +
-        pow(exp((noiseP->FaG / c) + (pow(sigmaG, 2) / (2.0 * pow(c, 2)))), 2) * (exp(pow(sigmaG / c, 2)) - 1.0) +
-        pow(exp((noiseP->FaM / c) + (pow(sigmaM, 2) / (2.0 * pow(c, 2)))), 2) * (exp(pow(sigmaM / c, 2)) - 1.0);
+    betaT = pow(EXPDB((noiseP->FaA / c) + (pow(sigmaA, 2) / (2.0 * pow(c, 2)))), 2) * (EXPDB(pow(sigmaA / c, 2)) - 1.0) +
+        pow(EXPDB((noiseP->FaG / c) + (pow(sigmaG, 2) / (2.0 * pow(c, 2)))), 2) * (EXPDB(pow(sigmaG / c, 2)) - 1.0) +
+        pow(EXPDB((noiseP->FaM / c) + (pow(sigmaM, 2) / (2.0 * pow(c, 2)))), 2) * (EXPDB(pow(sigmaM / c, 2)) - 1.0);
 
-    gammaT = exp(noiseP->FaA / c) + exp(noiseP->FaG / c) + exp(noiseP->FaM / c);
+    gammaT = EXPDB(noiseP->FaA / c) + EXPDB(noiseP->FaG / c) + EXPDB(noiseP->FaM / c);
 
     if ((noiseP->DuA > 12.0)
         || (noiseP->DuG > 12.0)
         || (noiseP->DuM > 12.0))
     {
-        sigmaT = c * sqrt(2.0 * log(alphaT / gammaT));
+        sigmaT = c * sqrt(2.0 * LOGDB(alphaT / gammaT));
     } else {
-        sigmaT = c * sqrt(log(1.0 + (betaT / pow(alphaT, 2))));
+        sigmaT = c * sqrt(LOGDB(1.0 + (betaT / pow(alphaT, 2))));
     }
 
-    FamTu = c * (log(alphaT) - (pow(sigmaT, 2) / (2.0 * pow(c, 2))));
+    FamTu = c * (LOGDB(alphaT) - (pow(sigmaT, 2) / (2.0 * pow(c, 2))));
 
     noiseP->DuT = 1.282 * sigmaT;
 
@@ -201,34 +276,108 @@ int Noise(
 
     c = 10.0 / log(10.0);
 
-    alphaT = exp((noiseP->FaA / c) + (pow(sigmaA, 2) / (2.0 * pow(c, 2)))) +
-        exp((noiseP->FaG / c) + (pow(sigmaG, 2) / (2.0 * pow(c, 2)))) +
-        exp((noiseP->FaM / c) + (pow(sigmaM, 2) / (2.0 * pow(c, 2))));
+    alphaT = EXPDB((noiseP->FaA / c) + (pow(sigmaA, 2) / (2.0 * pow(c, 2)))) +
+        EXPDB((noiseP->FaG / c) + (pow(sigmaG, 2) / (2.0 * pow(c, 2)))) +
+        EXPDB((noiseP->FaM / c) + (pow(sigmaM, 2) / (2.0 * pow(c, 2))));
 
-    betaT = pow(exp((noiseP->FaA / c) + (pow(sigmaA, 2) / (2.0 * pow(c, 2)))), 2) * (exp(pow(sigmaA / c, 2)) - 1.0) +
-        pow(exp((noiseP->FaG / c) + (pow(sigmaG, 2) / (2.0 * pow(c, 2)))), 2) * (exp(pow(sigmaG / c, 2)) - 1.0) +
-        pow(exp((noiseP->FaM / c) + (pow(sigmaM, 2) / (2.0 * pow(c, 2)))), 2) * (exp(pow(sigmaM / c, 2)) - 1.0);
+    betaT = pow(EXPDB((noiseP->FaA / c) + (pow(sigmaA, 2) / (2.0 * pow(c, 2)))), 2) * (EXPDB(pow(sigmaA / c, 2)) - 1.0) +
+        pow(EXPDB((noiseP->FaG / c) + (pow(sigmaG, 2) / (2.0 * pow(c, 2)))), 2) * (EXPDB(pow(sigmaG / c, 2)) - 1.0) +
+        pow(EXPDB((noiseP->FaM / c) + (pow(sigmaM, 2) / (2.0 * pow(c, 2)))), 2) * (EXPDB(pow(sigmaM / c, 2)) - 1.0);
 
-    gammaT = exp(noiseP->FaA / c) + exp(noiseP->FaG / c) + exp(noiseP->FaM / c);
+    gammaT = EXPDB(noiseP->FaA / c) + EXPDB(noiseP->FaG / c) + EXPDB(noiseP->FaM / c);
 
     if ((noiseP->DlA > 12.0)
         || (noiseP->DlG > 12.0)
         || (noiseP->DlM > 12.0))
     {
-        sigmaT = c * sqrt(2.0 * log(alphaT / gammaT));
+        sigmaT = c * sqrt(2.0 * LOGDB(alphaT / gammaT));
     } else {
-        sigmaT = c * sqrt(log(1.0 + (betaT / pow(alphaT, 2))));
+        sigmaT = c * sqrt(LOGDB(1.0 + (betaT / pow(alphaT, 2))));
     }
 
-    FamTl = c * (log(alphaT) - (pow(sigmaT, 2) / (2.0 * pow(c, 2))));
+    FamTl = c * (LOGDB(alphaT) - (pow(sigmaT, 2) / (2.0 * pow(c, 2))));
 
     noiseP->DlT = 1.282 * sigmaT;
 
     noiseP->FamT = min(FamTu, FamTl); // Worst-case noise.
 
+    nm->fakp = noiseP->fakp;
+    nm->reads = FamDudReads;
+    nm->hour = hour;
+    nm->lng = rlng;
+    nm->lat = rlat;
+    nm->frequency = frequency;
+    nm->ManMadeNoise = noiseP->ManMadeNoise;
+    nm->valid = 1;
+    MemoNoise(noiseP);
+
     return RTN_NOISEOK;
 }
 
+void MemoNoise(
+    struct NoiseParams *noiseP
+) {
+    /*
+    Keep the outputs of Noise() in noiseP->memo with the inputs they are for.
+
+        INPUT
+            struct NoiseParams *noiseP
+
+        OUTPUT
+            noiseP->memo
+
+        SUBROUTINES
+            None
+     */
+
+    struct NoiseMemo *nm = &noiseP->memo;
+
+    nm->FaA = noiseP->FaA;
+    nm->DuA = noiseP->DuA;
+    nm->DlA = noiseP->DlA;
+    nm->FaM = noiseP->FaM;
+    nm->DuM = noiseP->DuM;
+    nm->DlM = noiseP->DlM;
+    nm->FaG = noiseP->FaG;
+    nm->DuG = noiseP->DuG;
+    nm->DlG = noiseP->DlG;
+    nm->DuT = noiseP->DuT;
+    nm->DlT = noiseP->DlT;
+    nm->FamT = noiseP->FamT;
+}
+
+void RecallNoise(
+    struct NoiseParams *noiseP
+) {
+    /*
+    Copy the outputs kept by MemoNoise() back to noiseP.
+
+        INPUT
+            noiseP->memo
+
+        OUTPUT
+            The noise outputs in noiseP
+
+        SUBROUTINES
+            None
+     */
+
+    struct NoiseMemo *nm = &noiseP->memo;
+
+    noiseP->FaA = nm->FaA;
+    noiseP->DuA = nm->DuA;
+    noiseP->DlA = nm->DlA;
+    noiseP->FaM = nm->FaM;
+    noiseP->DuM = nm->DuM;
+    noiseP->DlM = nm->DlM;
+    noiseP->FaG = nm->FaG;
+    noiseP->DuG = nm->DuG;
+    noiseP->DlG = nm->DlG;
+    noiseP->DuT = nm->DuT;
+    noiseP->DlT = nm->DlT;
+    noiseP->FamT = nm->FamT;
+}
+
 void AtmosphericNoise(
     struct NoiseParams *noiseP,
     int hour, 
@@ -332,20 +481,20 @@ void AtmosphericNoise(
     // and the 4 hour timeblock.
     slp = fmod(lrxmt, 4.0) / 4.0;
 
-    fa = pow(10.0, (FS_now.FA / 10.0))
-       + (pow(10.0, (FS_adj.FA / 10.0)) - pow(10.0, (FS_now.FA / 10.0))
+    fa = DB2RATIO(FS_now.FA)
+       + (DB2RATIO(FS_adj.FA) - DB2RATIO(FS_now.FA)
          ) * slp;
-    noiseP->FaA = 10.0 * log10(fa);
+    noiseP->FaA = RATIO2DB(fa);
 
-    fa = pow(10.0, (FS_now.Du / 10.0))
-       + (pow(10.0, (FS_adj.Du / 10.0)) - pow(10.0, (FS_now.Du / 10.0))
+    fa = DB2RATIO(FS_now.Du)
+       + (DB2RATIO(FS_adj.Du) - DB2RATIO(FS_now.Du)
          ) * slp;
-    noiseP->DuA = 10.0 * log10(fa);
+    noiseP->DuA = RATIO2DB(fa);
 
-    fa = pow(10.0, (FS_now.Dl / 10.0))
-       + (pow(10.0, (FS_adj.Dl / 10.0)) - pow(10.0, (FS_now.Dl / 10.0))
+    fa = DB2RATIO(FS_now.Dl)
+       + (DB2RATIO(FS_adj.Dl) - DB2RATIO(FS_now.Dl)
          ) * slp;
-    noiseP->DlA = 10.0 * log10(fa);
+    noiseP->DlA = RATIO2DB(fa);
 
     return;
 }
@@ -374,7 +523,7 @@ void GetFamParameters(
             struct FamStats *FS - structure containing the noise parameters
 
         SUBROUTINES
-            None
+            FindFam1MHz()
      */
 
     double v[5];
@@ -385,49 +534,11 @@ void GetFamParameters(
     double x;
     double y;
     double Fam1MHz; // Atmospheric noise Fam (dB above kT0b at 1 MHz)
-    double R;
-    double ZZ[30]; // This assumes lm = 29
-    double q; // Temp Latitude or Longitude
 
     int i, j, k;
-    int lm, ln;
 
     // First find the atmospheric noise Fam (dB above kT0b at 1 MHz).
-    // Set the limits of the Fourier series
-    lm = 29;
-    ln = 15;
-    /*
-    The longitude used here is the geographic east longitude
-    (0 to 2*PI radians).
-    Initialize the temp, q, as half the geographic east longitude.
-    */
-    if (lng < 0.0) {
-        q = (lng + 2.0 * PI) / 2.0;
-    } else {
-        q = lng / 2.0;
-    }
-
-    // Calculate the longitude series
-    for (j = 0; j < lm; j++) {
-        ZZ[j] = 0.0; // Initialize ZZ[j]
-        R = 0.0;
-        for (k = 0; k < ln; k++) {
-            R = R + sin((k + 1.0) * q) * noiseP->fakp[FS->tmblk][k][j];
-        }
-        ZZ[j] = R + noiseP->fakp[FS->tmblk][15][j];
-    }
-
-    // Calculate the latitude series
-    // Reuse the temp, q, as the latitude plus 90 degrees
-    q = (lat + PI / 2.0);
-
-    R = 0.0;
-    for (j = 0; j < lm; j++) {
-        R = R + sin((j + 1.0) * q) * ZZ[j];
-    }
-    // Final Fourier series calculation.
-    // (Note the linear nomalization using fakabp values)
-    Fam1MHz = R + noiseP->fakabp[FS->tmblk][0] + noiseP->fakabp[FS->tmblk][1] * q;
+    Fam1MHz = FindFam1MHz(noiseP, FS->tmblk, lng, lat);
 
     // Determine if the reciever latitude is positive or negative
     if (lat < 0) {
@@ -503,6 +614,189 @@ void GetFamParameters(
     return;
 }
 
+double FindFam1MHz(
+    struct NoiseParams *noiseP,
+    int tmblk,
+    double lng,
+    double lat
+) {
+    /*
+    Find the atmospheric noise Fam (dB above kT0b at 1 MHz) for the time
+    block at the receiver from the Fourier series in fakp and fakabp.
+    Fam1MHz does not depend on the frequency, so the value for each time
+    block at the last receiver location is kept in noiseP->famcache.
+    Frequency sweeps, several transmitters and repeated hours at the same
+    receiver then only sum the series once for each time block.
+
+    The sines of the harmonics of the longitude and the latitude are found
+    once for each series by SineHarmonics() from one sine and cosine
+    rather than with a sin() for each term. The longitude series is summed
+    a row of fakp at a time so that the inner loop runs along the row.
+
+        INPUT
+            struct NoiseParams *noiseP
+            int tmblk - Time block
+            double lng (rad)
+            double lat (rad)
+
+        OUTPUT
+            noiseP->famcache
+            Returns Fam1MHz
+
+        SUBROUTINES
+            SineHarmonics()
+     */
+
+    struct FamCache *fc = &noiseP->famcache;
+
+    double sinlng[FAKPROWS - 1]; // sin((k + 1) * q) for the longitude series
+    double sinlat[FAKPCOLS];     // sin((j + 1) * q) for the latitude series
+    double Fam1MHz;
+    double R;
+    double ZZ[30]; // This assumes lm = 29
+    double q; // Temp Latitude or Longitude
+
+    int j, k;
+    int lm, ln;
+
+    // Start again if the location or the coefficients have changed
+    if ((fc->fakp != noiseP->fakp) || (fc->reads != FamDudReads) ||
+        (fc->lng != lng) || (fc->lat != lat)) {
+        fc->fakp = noiseP->fakp;
+        fc->reads = FamDudReads;
+        fc->lng = lng;
+        fc->lat = lat;
+        fc->valid = 0;
+    }
+
+    if ((fc->valid & (1 << tmblk)) != 0) {
+        return fc->Fam1MHz[tmblk];
+    }
+
+    // Set the limits of the Fourier series
+    lm = 29;
+    ln = 15;
+    /*
+    The longitude used here is the geographic east longitude
+    (0 to 2*PI radians).
+    Initialize the temp, q, as half the geographic east longitude.
+    */
+    if (lng < 0.0) {
+        q = (lng + 2.0 * PI) / 2.0;
+    } else {
+        q = lng / 2.0;
+    }
+
+    SineHarmonics(q, ln, sinlng);
+
+    // Calculate the longitude series
+    for (j = 0; j < lm; j++) {
+        ZZ[j] = 0.0;
+    }
+    for (k = 0; k < ln; k++) {
+        for (j = 0; j < lm; j++) {
+            ZZ[j] = ZZ[j] + sinlng[k] * noiseP->fakp[tmblk][k][j];
+        }
+    }
+    for (j = 0; j < lm; j++) {
+        ZZ[j] = ZZ[j] + noiseP->fakp[tmblk][15][j];
+    }
+
+    // Calculate the latitude series
+    // Reuse the temp, q, as the latitude plus 90 degrees
+    q = (lat + PI / 2.0);
+
+    SineHarmonics(q, lm, sinlat);
+
+    R = 0.0;
+    for (j = 0; j < lm; j++) {
+        R = R + sinlat[j] * ZZ[j];
+    }
+    // Final Fourier series calculation.
+    // (Note the linear nomalization using fakabp values)
+    Fam1MHz = R + noiseP->fakabp[tmblk][0] + noiseP->fakabp[tmblk][1] * q;
+
+    fc->Fam1MHz[tmblk] = Fam1MHz;
+    fc->valid |= (1 << tmblk);
+    fc->sums++;
+
+    return Fam1MHz;
+}
+
+void SineHarmonics(
+    double q,
+    int n,
+    double s[]
+) {
+    /*
+    Find s[k] = sin((k + 1) * q) for k = 0 to n - 1 from sin(q) and
+    cos(q) alone with the angle addition formulas
+
+        sin((k + 1) * q) = sin(k * q) * cos(q) + cos(k * q) * sin(q)
+        cos((k + 1) * q) = cos(k * q) * cos(q) - sin(k * q) * sin(q)
+
+    Carrying the cosine as well as the sine keeps the rounding error
+    growing only linearly with k at every angle. For the 29 harmonics of
+    the latitude series the largest difference from sin() is about 1e-14.
+
+        INPUT
+            double q (rad)
+            int n - Number of harmonics
+            double s[] - At least n long
+
+        OUTPUT
+            s[]
+
+        SUBROUTINES
+            None
+     */
+
+    double sq, cq;
+    double sk, ck;
+    double t;
+
+    int k;
+
+    if (n < 1) return;
+
+    sq = sin(q);
+    cq = cos(q);
+
+    sk = sq;
+    ck = cq;
+    s[0] = sk;
+    for (k = 1; k < n; k++) {
+        t = sk * cq + ck * sq;
+        ck = ck * cq - sk * sq;
+        sk = t;
+        s[k] = sk;
+    }
+}
+
+void NoteFamDudRead(
+    struct NoiseParams *noiseP
+) {
+    /*
+    Record that coefficients have been read into the block at
+    noiseP->fakp so that no struct FamCache or struct NoiseMemo made from
+    the block before is used again.
+
+        INPUT
+            struct NoiseParams *noiseP
+
+        OUTPUT
+            noiseP->famcache
+            noiseP->memo
+
+        SUBROUTINES
+            None
+     */
+
+    FamDudReads++;
+    noiseP->famcache.valid = 0;
+    noiseP->memo.valid = 0;
+}
+
 void ManMadeNoise(
     struct NoiseParams *noiseP,
     double frequency
@@ -620,6 +914,42 @@ int ReadFamDud(
     struct NoiseParams *noiseP,
     const char* DataFilePath,
     int month
+) {
+    /*
+    Read the atmospheric noise coefficients for the month. The binary file
+    FamDudXX.bin is used if there is one, otherwise the text file
+    COEFFXXW.txt is parsed. The binary files are made from the text files
+    with the program FamDudConvert. If the text files are compiled into the
+    library (See EmbeddedNoise.c) they are used and no file is read.
+
+        INPUT
+            struct NoiseParams *noiseP
+            int month
+
+        OUTPUT
+            noiseP->fam
+            noiseP->dud
+            noiseP->fakp
+            noiseP->fakabp
+
+        SUBROUTINES
+            EmbeddedNoise()
+            ReadFamDudBin()
+            ReadFamDudTxt()
+     */
+
+    if ((EmbeddedNoise() != TRUE) &&
+        (ReadFamDudBin(noiseP, DataFilePath, month) == RTN_READFAMDUDOK)) {
+        return RTN_READFAMDUDOK;
+    }
+
+    return ReadFamDudTxt(noiseP, DataFilePath, month);
+}
+
+int ReadFamDudTxt(
+    struct NoiseParams *noiseP,
+    const char* DataFilePath,
+    int month
 ) {
     /*
     Read the harmonized coefficient files from Peter Suessman.
@@ -670,7 +1000,9 @@ int ReadFamDud(
     sprintf(CoeffFile, "COEFF%02dW.txt", month + 1);
     strcat(InFilePath, CoeffFile);
 
-    fp = fopen(InFilePath, "r");
+    // Use the file compiled into the library if there is one
+    fp = OpenEmbeddedNoise(CoeffFile);
+    if (fp == NULL) fp = fopen(InFilePath, "r");
     if (fp == NULL) {
         printf("ReadFamDud: ERROR Can't find input file - %s\n", InFilePath);
 
@@ -906,6 +1238,8 @@ int ReadFamDud(
     // Clean up;
     fclose(fp);
 
+    NoteFamDudRead(noiseP);
+
     return RTN_READFAMDUDOK;
 
 	#ifdef __GNUC__
@@ -913,6 +1247,164 @@ int ReadFamDud(
 	#endif
 }
 
+int ReadFamDudBin(
+    struct NoiseParams *noiseP,
+    const char* DataFilePath,
+    int month
+) {
+    /*
+    Read the atmospheric noise coefficients for the month from the binary
+    file FamDudXX.bin written by WriteFamDudBin(). The file holds only the
+    arrays fakp[][][], fakabp[][], dud[][][] and fam[][] as doubles in the
+    order of their indices, after a short header. This is the layout of
+    the block the tables are in (See AllocateNoiseMemory()), so the tables
+    are read straight into the block with one fread(). If the file is
+    missing nothing is printed, so the caller can fall back to
+    ReadFamDudTxt().
+
+        INPUT
+            struct NoiseParams *noiseP
+            int month
+
+        OUTPUT
+            noiseP->fam
+            noiseP->dud
+            noiseP->fakp
+            noiseP->fakabp
+            returns RTN_READFAMDUDOK, RTN_ERROPENCOEFFFILE or RTN_ERRFAMDUDBIN
+
+        SUBROUTINES
+            MakeFamDudHeader()
+            NoteFamDudRead()
+     */
+
+    struct FamDudHeader expected, header;
+
+    size_t n;
+
+    char CoeffFile[22];
+    char InFilePath[270];
+
+    FILE *fp;
+
+    strcpy(InFilePath, DataFilePath);
+    sprintf(CoeffFile, "FamDud%02d.bin", month + 1);
+    strcat(InFilePath, CoeffFile);
+
+    fp = fopen(InFilePath, "rb");
+    if (fp == NULL) {
+        return RTN_ERROPENCOEFFFILE;
+    }
+
+    MakeFamDudHeader(&expected);
+    if ((fread(&header, sizeof(header), 1, fp) != 1) ||
+        (memcmp(&header, &expected, sizeof(expected)) != 0)) {
+        printf("ReadFamDudBin: ERROR %s is not a coefficient file for this machine\n", InFilePath);
+        fclose(fp);
+        return RTN_ERRFAMDUDBIN;
+    }
+
+    // The block starts at fakp. A file that is too long is rejected too.
+    n = fread(noiseP->fakp, sizeof(double), NFAMDUD, fp);
+    if ((n != NFAMDUD) || (fgetc(fp) != EOF)) {
+        printf("ReadFamDudBin: ERROR %s is not a coefficient file for this machine\n", InFilePath);
+        fclose(fp);
+        return RTN_ERRFAMDUDBIN;
+    }
+    fclose(fp);
+
+    NoteFamDudRead(noiseP);
+
+    return RTN_READFAMDUDOK;
+}
+
+int WriteFamDudBin(
+    struct NoiseParams const *noiseP,
+    const char* DataFilePath,
+    int month
+) {
+    /*
+    Write the atmospheric noise coefficients for the month to the binary
+    file FamDudXX.bin that ReadFamDudBin() reads. The coefficients are
+    normally read from COEFFXXW.txt with ReadFamDudTxt() first.
+
+        INPUT
+            struct NoiseParams *noiseP
+            int month
+
+        OUTPUT
+            Writes DataFilePath/FamDudXX.bin
+            returns RTN_READFAMDUDOK or RTN_ERRWRITEFAMDUD
+
+        SUBROUTINES
+            MakeFamDudHeader()
+     */
+
+    struct FamDudHeader header;
+
+    int ok;
+
+    char CoeffFile[22];
+    char OutFilePath[270];
+    char TmpFilePath[274];
+
+    FILE *fp;
+
+    strcpy(OutFilePath, DataFilePath);
+    sprintf(CoeffFile, "FamDud%02d.bin", month + 1);
+    strcat(OutFilePath, CoeffFile);
+    strcpy(TmpFilePath, OutFilePath);
+    strcat(TmpFilePath, ".tmp");
+
+    // Write under a temporary name so a reader never sees a partial file
+    fp = fopen(TmpFilePath, "wb");
+    if (fp == NULL) {
+        printf("WriteFamDudBin: ERROR Can't create %s\n", TmpFilePath);
+        return RTN_ERRWRITEFAMDUD;
+    }
+
+    MakeFamDudHeader(&header);
+    ok = (fwrite(&header, sizeof(header), 1, fp) == 1);
+    // The block starts at fakp (See AllocateNoiseMemory())
+    ok = ok && (fwrite(noiseP->fakp, sizeof(double), NFAMDUD, fp) == NFAMDUD);
+    ok = (fclose(fp) == 0) && ok;
+
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    if (ok) remove(OutFilePath);
+#endif
+    if (!ok || (rename(TmpFilePath, OutFilePath) != 0)) {
+        printf("WriteFamDudBin: ERROR Can't write %s\n", OutFilePath);
+        remove(TmpFilePath);
+        return RTN_ERRWRITEFAMDUD;
+    }
+
+    return RTN_READFAMDUDOK;
+}
+
+void MakeFamDudHeader(
+    struct FamDudHeader *header
+) {
+    /*
+    Fill in the header of a binary coefficient file for this machine.
+
+        INPUT
+            struct FamDudHeader *header
+
+        OUTPUT
+            struct FamDudHeader *header
+     */
+
+    memset(header, 0, sizeof(struct FamDudHeader));
+    memcpy(header->magic, FAMDUDMAGIC, sizeof(header->magic));
+    header->version = FAMDUDVERSION;
+    header->nfakp = NFAKP;
+    header->nfakabp = NFAKABP;
+    header->ndud = NDUD;
+    header->nfam = NFAM;
+    header->check = FAMDUDCHECK;
+}
+
 char const* P372Version(void) {
     /*
     Return the version of the P533 DLL.
@@ -930,6 +1422,25 @@ char const* P372Version(void) {
     return P372VER;
 }
 
+int P372DataLayout(void) {
+    /*
+    Return the version of the layout of the coefficient tables and of
+    struct NoiseParams that the P372 DLL was built with (See
+    P372DATALAYOUT).
+
+        INPUT
+            None
+
+        OUTPUT
+            Returns P372DATALAYOUT
+
+        SUBROUTINES
+            None
+    */
+
+    return P372DATALAYOUT;
+}
+
 char const* P372CompileTime(void) {
     /*
     Return the compile time of the P533 DLL.
@@ -1016,38 +1527,38 @@ void AtmosphericNoise_LT(
     slp = fmod(lrxmt, 4.0) / 4.0;
 
     // Load the  return structure 
-    fa = pow(10.0, (FS_now.FA / 10.0))
-       + (pow(10.0, (FS_adj.FA / 10.0)) - pow(10.0, (FS_now.FA / 10.0))
+    fa = DB2RATIO(FS_now.FA)
+       + (DB2RATIO(FS_adj.FA) - DB2RATIO(FS_now.FA)
          ) * slp;
-    FamS->FA = 10.0 * log10(fa);
+    FamS->FA = RATIO2DB(fa);
 
-    fa = pow(10.0, (FS_now.Du / 10.0))
-       + (pow(10.0, (FS_adj.Du / 10.0)) - pow(10.0, (FS_now.Du / 10.0))
+    fa = DB2RATIO(FS_now.Du)
+       + (DB2RATIO(FS_adj.Du) - DB2RATIO(FS_now.Du)
          ) * slp;
-    FamS->Du = 10.0 * log10(fa);
+    FamS->Du = RATIO2DB(fa);
 
-    fa = pow(10.0, (FS_now.Dl / 10.0))
-       + (pow(10.0, (FS_adj.Dl / 10.0)) - pow(10.0, (FS_now.Dl / 10.0))
+    fa = DB2RATIO(FS_now.Dl)
+       + (DB2RATIO(FS_adj.Dl) - DB2RATIO(FS_now.Dl)
          ) * slp;
-    FamS->Dl = 10.0 * log10(fa);
+    FamS->Dl = RATIO2DB(fa);
 
-    fa = pow(10.0, (FS_now.SigmaDl / 10.0))
-       + (pow(10.0, (FS_adj.SigmaDl / 10.0)) 
-          - pow(10.0, (FS_now.SigmaDl / 10.0))
+    fa = DB2RATIO(FS_now.SigmaDl)
+       + (DB2RATIO(FS_adj.SigmaDl) 
+          - DB2RATIO(FS_now.SigmaDl)
          ) * slp;
-    FamS->SigmaDl = 10.0 * log10(fa);
+    FamS->SigmaDl = RATIO2DB(fa);
 
-    fa = pow(10.0, (FS_now.SigmaDu / 10.0))
-       + (pow(10.0, (FS_adj.SigmaDu / 10.0))
-          - pow(10.0, (FS_now.SigmaDu / 10.0))
+    fa = DB2RATIO(FS_now.SigmaDu)
+       + (DB2RATIO(FS_adj.SigmaDu)
+          - DB2RATIO(FS_now.SigmaDu)
          ) * slp;
-    FamS->SigmaDu = 10.0 * log10(fa);
+    FamS->SigmaDu = RATIO2DB(fa);
 
-    fa = pow(10.0, (FS_now.SigmaFam / 10.0))
-       + (pow(10.0, (FS_adj.SigmaFam / 10.0))
-          - pow(10.0, (FS_now.SigmaFam / 10.0))
+    fa = DB2RATIO(FS_now.SigmaFam)
+       + (DB2RATIO(FS_adj.SigmaFam)
+          - DB2RATIO(FS_now.SigmaFam)
          ) * slp;
-    FamS->SigmaFam = 10.0 * log10(fa);
+    FamS->SigmaFam = RATIO2DB(fa);
 
     // The time block for in the FamS structure is irrelevant to return
     // so set it to 99 as an indicator.
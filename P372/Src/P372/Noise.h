@@ -53,6 +53,10 @@
 #define RTN_ERRALLOCATENOISE 207
 // ERROR: Can't open output file in MakeNoise().
 #define RTN_ERRMNCANTOPENFILE 208
+// ERROR: FamDudXX.bin is not a coefficient file for this machine in ReadFamDudBin().
+#define RTN_ERRFAMDUDBIN 209
+// ERROR: Can't write FamDudXX.bin in WriteFamDudBin().
+#define RTN_ERRWRITEFAMDUD 210
 
 // Return OKAY > 20 and <= 30.
 // AllocatePathMemory().
@@ -67,6 +71,29 @@
 #define RTN_NOISEMANMADEOK 25
 // MakeNoise() Stand alone P372 caller.
 #define RTN_MAKENOISEOK 26
+
+// Atmospheric noise coefficient tables (See AllocateNoiseMemory()).
+// Each table is a fixed size array and all four are in one contiguous
+// block in the order fakp, fakabp, dud, fam, which is also the order of
+// the FamDudXX.bin files.
+#define FAKPBLKS 6      // Time blocks
+#define FAKPROWS 16
+#define FAKPCOLS 29
+#define FAKABPCOLS 2
+#define DUDPARMS 5
+#define DUDROWS 12
+#define DUDCOLS 5
+#define FAMROWS 12
+#define FAMCOLS 14
+#define NFAKP (FAKPBLKS * FAKPROWS * FAKPCOLS)
+#define NFAKABP (FAKPBLKS * FAKABPCOLS)
+#define NDUD (DUDPARMS * DUDROWS * DUDCOLS)
+#define NFAM (FAMROWS * FAMCOLS)
+#define NFAMDUD (NFAKP + NFAKABP + NDUD + NFAM)
+// Version of the layout of the tables and of struct NoiseParams. It
+// changes whenever either layout does. A caller that indexes the tables
+// itself checks it against P372DataLayout().
+#define P372DATALAYOUT 5
 /* End Defines */
 
 /* Struct Definitions */
@@ -80,6 +107,41 @@ struct FamStats {
   double SigmaDl;  // Standard deviation of values of Dl
 };
 
+// Fam1MHz does not depend on the frequency, so it is kept for each time
+// block at the last receiver location (See FindFam1MHz()). The cache is
+// copied with the structure NoiseParams, and so is the count of the series
+// summed into it, so the difference of the counts before and after a copy
+// is used is the number of series that had to be summed again.
+struct FamCache {
+  double (*fakp)[FAKPROWS][FAKPCOLS]; // Coefficients the entries are for
+  unsigned int reads; // Coefficient reads when the entries were made
+  double lng;         // Receiver longitude (rad)
+  double lat;         // Receiver latitude (rad)
+  int valid;          // Bit tmblk is set when Fam1MHz[tmblk] is for the key
+  unsigned int sums;  // Number of Fam1MHz series summed into the cache
+  double Fam1MHz[FAKPBLKS];
+};
+
+// The inputs and the outputs of the last Noise() call. A call with the
+// same inputs, such as the same receiver for several transmitters, copies
+// the outputs from here rather than working them out again (See Noise()).
+// The outputs are kept here because InitializeNoise() resets the ones in
+// struct NoiseParams between calls.
+struct NoiseMemo {
+  double (*fakp)[FAKPROWS][FAKPCOLS]; // Coefficients the outputs are for
+  unsigned int reads; // Coefficient reads when the outputs were made
+  int hour;
+  double lng;          // Receiver longitude (rad)
+  double lat;          // Receiver latitude (rad)
+  double frequency;    // (MHz)
+  double ManMadeNoise;
+  int valid;           // Non-zero when the outputs are for the inputs above
+  double FaA, DuA, DlA; // Outputs for the inputs above
+  double FaM, DuM, DlM;
+  double FaG, DuG, DlG;
+  double DuT, DlT, FamT;
+};
+
 struct NoiseParams {
   // Output Parameters
   double FaA;  // Atmospheric noise
@@ -97,10 +159,13 @@ struct NoiseParams {
 
   // Non-Output Parameters
   double ManMadeNoise;
-  double ***fakp;
-  double **fakabp;
-  double **fam;
-  double ***dud;
+  // Coefficient tables. fakp is the start of the block that holds all four.
+  double (*fakp)[FAKPROWS][FAKPCOLS]; // [FAKPBLKS][FAKPROWS][FAKPCOLS]
+  double (*fakabp)[FAKABPCOLS];       // [FAKPBLKS][FAKABPCOLS]
+  double (*fam)[FAMCOLS];             // [FAMROWS][FAMCOLS]
+  double (*dud)[DUDROWS][DUDCOLS];    // [DUDPARMS][DUDROWS][DUDCOLS]
+  struct FamCache famcache;           // Fam1MHz at the last receiver location
+  struct NoiseMemo memo;              // Inputs of the last Noise() call
 };
 /* End Struct Definitions */
 
@@ -109,6 +174,8 @@ struct NoiseParams {
     #include <Windows.h>
     // P372Version() & P372CompileTime()
     typedef const char *(__cdecl *cP372Info)(void);
+    // P372DataLayout()
+    typedef int(__cdecl *iP372DataLayout)(void);
     // AllocateNoiseMemory() & FreeNoiseMemory()
     typedef int(__cdecl *iNoiseMemory)(
         struct NoiseParams *noiseP
@@ -183,11 +250,27 @@ DLLEXPORT int ReadFamDud(
     const char *DataFilePath,
     int month
 );
+DLLEXPORT int ReadFamDudTxt(
+    struct NoiseParams *noiseP,
+    const char *DataFilePath,
+    int month
+);
+DLLEXPORT int ReadFamDudBin(
+    struct NoiseParams *noiseP,
+    const char *DataFilePath,
+    int month
+);
+DLLEXPORT int WriteFamDudBin(
+    struct NoiseParams const *noiseP,
+    const char *DataFilePath,
+    int month
+);
 DLLEXPORT void InitializeNoise(
     struct NoiseParams *noiseP
 );
 DLLEXPORT char const *P372CompileTime(void);
 DLLEXPORT char const *P372Version(void);
+DLLEXPORT int P372DataLayout(void);
 DLLEXPORT void AtmosphericNoise(
     struct NoiseParams *noiseP,
     int iutc,
@@ -277,6 +360,7 @@ DLLEXPORT int MakeNoise(
     HINSTANCE hLib;
     cP372Info dllP372Version;
     cP372Info dllP372CompileTime;
+    iP372DataLayout dllP372DataLayout;
     iNoise dllNoise;
     iNoiseMemory dllAllocateNoiseMemory;
     iNoiseMemory dllFreeNoiseMemory;
@@ -290,6 +374,7 @@ DLLEXPORT int MakeNoise(
     void *hLib;
     char *(*dllP372Version)();
     char *(*dllP372CompileTime)();
+    int (*dllP372DataLayout)(void);
     int (*dllNoise)(struct NoiseParams *, int, double, double, double);
     int (*dllAllocateNoiseMemory)(struct NoiseParams *);
     int (*dllFreeNoiseMemory)(struct NoiseParams *);
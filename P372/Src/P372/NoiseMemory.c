@@ -14,6 +14,11 @@ int AllocateNoiseMemory(
     Allocate the memory necessary for the noiseP structure.
     The data must be read into these structures elsewhere.
 
+    The four coefficient tables are fixed size arrays in one contiguous
+    block, so each coefficient is a single indexed load. noiseP->fakp is
+    the start of the block and the other tables follow it in the order of
+    the FamDudXX.bin files (See Noise.h).
+
         INPUT
             struct NoiseParams *noiseP
 
@@ -22,68 +27,26 @@ int AllocateNoiseMemory(
             noiseP->fakabp
             noiseP->fam
             noiseP->dud
+            noiseP->famcache
+            noiseP->memo
 
         SUBROUTINES
             None
      */
 
-    double ***fakp;
-    double **fakabp;
-    double **fam;
-    double ***dud;
-
-    int m, n;
-
-    // Create the fakp array.
-    fakp = (double***)malloc(6 * sizeof(double**));
-    for (n = 0; n < 6; n++) {
-        fakp[n] = (double**)malloc(16 * sizeof(double*));
-        for (m = 0; m < 16; m++) {
-            fakp[n][m] = (double*)malloc(29 * sizeof(double));
-        }
-    }
-
-    // Create the fakabp array.
-    fakabp = (double**)malloc(6 * sizeof(double*));
-    for (m = 0; m < 6; m++) {
-        fakabp[m] = (double*)malloc(2 * sizeof(double));
-    }
-
-    // Create the dud array.
-    dud = (double***)malloc(5 * sizeof(double**));
-    for (n = 0; n < 5; n++) {
-        dud[n] = (double**)malloc(12 * sizeof(double*));
-        for (m = 0; m < 12; m++) {
-            dud[n][m] = (double*)malloc(5 * sizeof(double));
-        }
-    }
-
-    // Create the fam array.
-    fam = (double**)malloc(12 * sizeof(double*));
-    for (m = 0; m < 12; m++) {
-        fam[m] = (double*)malloc(14 * sizeof(double));
-    }
-
-    // Check for NULLs and save the pointers to the path structure.
-    if (dud != NULL)
-        noiseP->dud = dud;
-    else
-        return RTN_ERRALLOCATEDUD;
-
-    if (fam != NULL)
-        noiseP->fam = fam;
-    else
-        return RTN_ERRALLOCATEFAM;
-
-    if (fakp != NULL)
-        noiseP->fakp = fakp;
-    else
-        return RTN_ERRALLOCATEFAKP;
-
-    if (fakabp != NULL)
-        noiseP->fakabp = fakabp;
-    else
-        return RTN_ERRALLOCATEFAKABP;
+    double *block;
+
+    block = (double*)malloc(NFAMDUD * sizeof(double));
+    if (block == NULL)
+        return RTN_ERRALLOCATENOISE;
+
+    noiseP->fakp = (double(*)[FAKPROWS][FAKPCOLS])block;
+    noiseP->fakabp = (double(*)[FAKABPCOLS])(block + NFAKP);
+    noiseP->dud = (double(*)[DUDROWS][DUDCOLS])(block + NFAKP + NFAKABP);
+    noiseP->fam = (double(*)[FAMCOLS])(block + NFAKP + NFAKABP + NDUD);
+    noiseP->famcache.valid = 0;
+    noiseP->famcache.sums = 0;
+    noiseP->memo.valid = 0;
 
     return RTN_ALLOCATEP372OK;
 }
@@ -105,37 +68,12 @@ int FreeNoiseMemory(
              None
        */
 
-    int m, n;
-
-    // Free DUD
-    for (n = 0; n < 5; n++) {
-        for (m = 0; m < 12; m++) {
-            free(noiseP->dud[n][m]);
-        }
-        free(noiseP->dud[n]);
-    }
-    free(noiseP->dud);
-
-    // Free FAM
-    for (m = 0; m < 12; m++) {
-        free(noiseP->fam[m]);
-    }
-    free(noiseP->fam);
-
-    // Free FAKP
-    for (n = 0; n < 6; n++) {
-        for (m = 0; m < 16; m++) {
-            free(noiseP->fakp[n][m]);
-        }
-        free(noiseP->fakp[n]);
-    }
+    // All of the tables are in the block that starts at fakp
     free(noiseP->fakp);
-
-    // Free fakabp
-    for (m = 0; m < 6; m++) {
-        free(noiseP->fakabp[m]);
-    }
-    free(noiseP->fakabp);
+    noiseP->fakp = NULL;
+    noiseP->fakabp = NULL;
+    noiseP->dud = NULL;
+    noiseP->fam = NULL;
 
     return RTN_NOISEFREED;
 }
@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+
+	BatchCheck - Checks P533Batch() against P533(). A grid of receivers, with some locations that are out of range mixed
+		in, is run through P533Batch() for several hours and frequencies and each receiver is then run on its own with
+		P533(). The return value of each receiver must be the same. For a receiver that succeeds every result must be
+		bit for bit the same as the path from P533(), and for one that fails every result must be TOOBIG.
+
+		"make check" in P533/Linux builds and runs it. It returns EXIT_FAILURE if any receiver differs. The usage is
+			BatchCheck DataFilePath [Month]
+
+		where Month is 1 to 12 (1 by default).
+
+*/
+
+// Local Defines
+#define NLAT	19		// Grid points from 90S to 90N
+#define NLNG	36		// Grid points from 180W to 170E
+#define NBAD	3		// Receivers that are out of range
+#define NRX		(NLAT*NLNG + NBAD)
+#define NRUNS	4
+#define NRES	10		// Arrays in struct BatchResults other than rtn
+// End Local Defines
+
+int main(int argc, char *argv[]) {
+
+	struct PathData path, ref;
+	struct DatasetCache cache;
+	struct Dataset own;
+	struct BatchResults res;
+	struct Location L_rx[NRX];
+
+	char DataFilePath[256];
+
+	int hrs[NRUNS] = {1, 7, 13, 19};
+	double frqs[NRUNS] = {5.0, 10.0, 15.0, 25.0};
+
+	double *val[NRES];		// The arrays of res in the order they are in the structure
+	double const *pv[NRES];	// The same parameters in the path from P533()
+	int rtn[NRX];
+
+	long nok, nfail, ndiff;
+	int month;
+	int retval;
+	int i, j, r;
+
+	if((argc < 2) || (argc > 3) || (strlen(argv[1]) >= sizeof(DataFilePath))) {
+		printf("Usage: BatchCheck DataFilePath [Month]\n");
+		return EXIT_FAILURE;
+	}
+	strcpy(DataFilePath, argv[1]);
+	month = (argc > 2) ? atoi(argv[2]) - 1 : 0;
+	if((month < 0) || (month > 11)) month = 0;
+
+	if(AllocatePathMemory(&path) != RTN_ALLOCATEP533OK) {
+		printf("BatchCheck: Can't allocate the path\n");
+		return EXIT_FAILURE;
+	}
+	GetDataset(&path, &own);
+
+	retval = LoadDatasetCache(&cache, DataFilePath, TRUE);
+	if(retval == RTN_ALLOCATEP533OK) retval = SelectMonth(&path, &cache, month);
+	if(retval != RTN_ALLOCATEP533OK) {
+		printf("BatchCheck: Error %d loading the data in %s\n", retval, DataFilePath);
+		FreeDatasetCache(&cache);
+		return EXIT_FAILURE;
+	}
+
+	// A 10 W transmitter in Luxembourg with isotropic antennas
+	IsotropicPattern(&path.A_tx, 0.0, TRUE);
+	IsotropicPattern(&path.A_rx, 0.0, TRUE);
+	path.L_tx.lat = 49.67*D2R;
+	path.L_tx.lng = 6.32*D2R;
+	path.txpower = 10.0*log10(10.0/1000.0);	// dB(1 kW)
+	path.SSN = 100;
+	path.year = 2020;
+	path.BW = 3000.0;
+	path.SNRr = 15.0;
+	path.SIRr = 10.0;
+	path.F0 = 10.0;
+	path.T0 = 3.0;
+	path.A = 3.0;
+	path.TW = 5.0;
+	path.FW = 10.0;
+	path.SNRXXp = 90;
+	path.Modulation = ANALOG;
+	path.SorL = SHORTPATH;
+	path.noiseP.ManMadeNoise = RESIDENTIAL;
+
+	// The grid with a receiver that is out of range at the start, in the middle and at the end
+	j = 0;
+	L_rx[j].lat = 91.0*D2R;
+	L_rx[j++].lng = 0.0;
+	for(i=0; i<NLAT*NLNG; i++) {
+		if(i == NLAT*NLNG/2) {
+			L_rx[j].lat = 0.0;
+			L_rx[j++].lng = 181.0*D2R;
+		}
+		L_rx[j].lat = (-90.0 + 10.0*(i/NLNG))*D2R;
+		L_rx[j++].lng = (-180.0 + 10.0*(i%NLNG))*D2R;
+	}
+	L_rx[j].lat = -95.0*D2R;
+	L_rx[j++].lng = -200.0*D2R;
+
+	memset(&res, 0, sizeof(res));
+	res.rtn = rtn;
+	for(r=0; r<NRES; r++) {
+		val[r] = (double *) malloc(NRX*sizeof(double));
+		if(val[r] == NULL) {
+			printf("BatchCheck: Can't allocate the results\n");
+			return EXIT_FAILURE;
+		}
+	}
+	res.distance = val[0];
+	res.BMUF = val[1];
+	res.MUF50 = val[2];
+	res.OPMUF = val[3];
+	res.Ep = val[4];
+	res.Pr = val[5];
+	res.SNR = val[6];
+	res.SNRXX = val[7];
+	res.BCR = val[8];
+	res.OCR = val[9];
+
+	pv[0] = &ref.distance;
+	pv[1] = &ref.BMUF;
+	pv[2] = &ref.MUF50;
+	pv[3] = &ref.OPMUF;
+	pv[4] = &ref.Ep;
+	pv[5] = &ref.Pr;
+	pv[6] = &ref.SNR;
+	pv[7] = &ref.SNRXX;
+	pv[8] = &ref.BCR;
+	pv[9] = &ref.OCR;
+
+	nok = 0;
+	nfail = 0;
+	ndiff = 0;
+	for(j=0; j<NRUNS; j++) {
+		path.hour = hrs[j];
+		path.frequency = frqs[j];
+
+		retval = P533Batch(&path, L_rx, NRX, &res);
+		if(retval != RTN_P533OK) {
+			printf("BatchCheck: Error %d from P533Batch()\n", retval);
+			return EXIT_FAILURE;
+		}
+
+		for(i=0; i<NRX; i++) {
+			ref = path;
+			ref.L_rx = L_rx[i];
+			retval = P533(&ref);
+			if(retval != rtn[i]) {
+				ndiff++;
+				if(ndiff <= 10) printf("BatchCheck: Receiver %d returned %d from P533Batch() and %d from P533()\n", i, rtn[i], retval);
+				continue;
+			}
+
+			for(r=0; r<NRES; r++) {
+				if(((retval == RTN_P533OK) && (memcmp(&val[r][i], pv[r], sizeof(double)) != 0)) ||
+				   ((retval != RTN_P533OK) && (val[r][i] != TOOBIG))) {
+					break;
+				}
+			}
+			if(r < NRES) {
+				ndiff++;
+				if(ndiff <= 10) printf("BatchCheck: Receiver %d hour %d %.1f MHz differs in result %d\n", i, hrs[j], frqs[j], r);
+			}
+			else if(retval == RTN_P533OK) {
+				nok++;
+			}
+			else {
+				nfail++;
+			}
+		}
+	}
+
+	printf("BatchCheck: %d receivers, %d hours and frequencies\n", NRX, NRUNS);
+	printf("BatchCheck: %ld results identical to P533(), %ld failed receivers marked TOOBIG, %ld differ\n", nok, nfail, ndiff);
+
+	AttachDataset(&path, &own);
+	FreeDatasetCache(&cache);
+	FreePathMemory(&path);
+	for(r=0; r<NRES; r++) free(val[r]);
+
+	if((ndiff != 0) || (nfail != NBAD*NRUNS)) {
+		printf("BatchCheck: P533Batch() is not the same as P533()\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,109 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+
+	BindP372Bench - Microbenchmark of the cost of binding the P372 routines on each call to P533().
+		Before BindP372() every call to P533() loaded libp372.so and looked up six symbols. This program times
+		that per-call load against BindP372(), which only binds on the first call in the process.
+
+		"make bench" in P533/Linux builds and runs it. The usage is
+			BindP372Bench [number of calls]
+
+*/
+
+// Local Defines
+#define NCALLS		100000
+// End Local Defines
+
+// Local prototypes
+double ElapsedNs(struct timespec start, struct timespec stop);
+// End local prototypes
+
+int main(int argc, char *argv[]) {
+
+	struct timespec start, stop;
+
+	void * hP372;
+	void * sym[6];
+
+	double tPerCall;	// Old per-call load and lookup (ns)
+	double tBound;		// BindP372() after the first call (ns)
+	double tFirst;		// First call of BindP372() (ns)
+
+	long n, i;
+
+	n = NCALLS;
+	if(argc > 1) n = atol(argv[1]);
+	if(n <= 0) n = NCALLS;
+
+	// The first BindP372() call does the work
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if(BindP372() != RTN_P372BOUNDOK) {
+		printf("BindP372Bench: Couldn't bind libp372.so\n");
+		return RTN_ERRP372DLL;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tFirst = ElapsedNs(start, stop);
+
+	// The binding that P533(), AllocatePathMemory() and FreePathMemory() did on every call
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) {
+		hP372 = dlopen("libp372.so", RTLD_NOW);
+		sym[0] = dlsym(hP372, "P372Version");
+		sym[1] = dlsym(hP372, "P372CompileTime");
+		sym[2] = dlsym(hP372, "Noise");
+		sym[3] = dlsym(hP372, "AllocateNoiseMemory");
+		sym[4] = dlsym(hP372, "FreeNoiseMemory");
+		sym[5] = dlsym(hP372, "InitializeNoise");
+		if(sym[2] == NULL) return RTN_ERRP372DLL;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tPerCall = ElapsedNs(start, stop)/n;
+
+	// The binding P533() does now
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) {
+		if(BindP372() != RTN_P372BOUNDOK) return RTN_ERRP372DLL;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tBound = ElapsedNs(start, stop)/n;
+
+	printf("BindP372Bench: %ld calls\n", n);
+	printf("BindP372Bench: First BindP372()               %12.1f ns\n", tFirst);
+	printf("BindP372Bench: dlopen() + 6 dlsym() per call  %12.1f ns/call\n", tPerCall);
+	printf("BindP372Bench: BindP372() per call            %12.1f ns/call\n", tBound);
+
+	return EXIT_SUCCESS;
+
+}
+
+double ElapsedNs(struct timespec start, struct timespec stop) {
+
+	/*
+
+		ElapsedNs() - Returns the time between two clock readings in nanoseconds
+
+			INPUT
+				struct timespec start
+				struct timespec stop
+
+			OUTPUT
+				returns the elapsed time (ns)
+
+			SUBROUTINES
+				None
+
+	*/
+
+	return (stop.tv_sec - start.tv_sec)*1.0e9 + (stop.tv_nsec - start.tv_nsec);
+
+}
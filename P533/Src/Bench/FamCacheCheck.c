@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+
+	FamCacheCheck - Checks that a frequency sweep with P533Prepare() and P533Frequency() sums the Fam1MHz series of the
+		atmospheric noise once for each receiver and not once for each frequency (See struct FamCache in Noise.h). The
+		grid points of an area are prepared for each hour and then finished for each frequency in the order that
+		ITURHFProp uses, frequencies outside and grid points inside, into one path. The number of series summed is
+		counted with famcache.sums. Each result is also compared with P533() for the same point and frequency.
+
+		"make check" in P533/Linux builds and runs it. It returns EXIT_FAILURE if a series is summed in P533Frequency(),
+		if P533Prepare() sums more than the two time blocks of the hour or if a result is not identical to P533(). The
+		usage is
+			FamCacheCheck DataFilePath [Month]
+
+		where Month is 1 to 12 (1 by default).
+
+*/
+
+// Local Defines
+#define NLAT	5		// Grid points from 60S to 60N
+#define NLNG	6		// Grid points from 150W to 150E
+#define NPTS	(NLAT*NLNG)
+#define NHRS	4
+#define NFRQS	15		// 2 to 30 MHz
+// End Local Defines
+
+int SameResult(struct PathData const *a, struct PathData const *b);
+
+int main(int argc, char *argv[]) {
+
+	struct PathData path, out, ref;
+	struct PathData *prepared;
+	struct DatasetCache cache;
+	struct Dataset own;
+
+	char DataFilePath[256];
+
+	int hrs[NHRS] = {1, 7, 13, 19};
+
+	unsigned int sprep, sfreq;	// Series summed in P533Prepare() and in P533Frequency()
+	unsigned int s;
+
+	long ncalls;
+	int ndiff;
+	int month;
+	int retval;
+	int h, f, k;
+
+	if((argc < 2) || (argc > 3) || (strlen(argv[1]) >= sizeof(DataFilePath))) {
+		printf("Usage: FamCacheCheck DataFilePath [Month]\n");
+		return EXIT_FAILURE;
+	}
+	strcpy(DataFilePath, argv[1]);
+	month = (argc > 2) ? atoi(argv[2]) - 1 : 0;
+	if((month < 0) || (month > 11)) month = 0;
+
+	prepared = (struct PathData *) malloc(NPTS*sizeof(struct PathData));
+	if((prepared == NULL) || (AllocatePathMemory(&path) != RTN_ALLOCATEP533OK)) {
+		printf("FamCacheCheck: Can't allocate the paths\n");
+		return EXIT_FAILURE;
+	}
+	GetDataset(&path, &own);
+
+	retval = LoadDatasetCache(&cache, DataFilePath, TRUE);
+	if(retval == RTN_ALLOCATEP533OK) retval = SelectMonth(&path, &cache, month);
+	if(retval != RTN_ALLOCATEP533OK) {
+		printf("FamCacheCheck: Error %d loading the data in %s\n", retval, DataFilePath);
+		FreeDatasetCache(&cache);
+		return EXIT_FAILURE;
+	}
+
+	// A 10 W transmitter in Luxembourg with isotropic antennas
+	IsotropicPattern(&path.A_tx, 0.0, TRUE);
+	IsotropicPattern(&path.A_rx, 0.0, TRUE);
+	path.L_tx.lat = 49.67*D2R;
+	path.L_tx.lng = 6.32*D2R;
+	path.txpower = 10.0*log10(10.0/1000.0);	// dB(1 kW)
+	path.SSN = 100;
+	path.year = 2020;
+	path.BW = 3000.0;
+	path.SNRr = 15.0;
+	path.SIRr = 10.0;
+	path.F0 = 10.0;
+	path.T0 = 3.0;
+	path.A = 3.0;
+	path.TW = 5.0;
+	path.FW = 10.0;
+	path.SNRXXp = 90;
+	path.Modulation = ANALOG;
+	path.SorL = SHORTPATH;
+	path.noiseP.ManMadeNoise = RESIDENTIAL;
+
+	sprep = 0;
+	sfreq = 0;
+	ncalls = 0;
+	ndiff = 0;
+	for(h=0; h<NHRS; h++) {
+		path.hour = hrs[h];
+		path.frequency = 2.0;
+
+		for(k=0; k<NPTS; k++) {
+			prepared[k] = path;
+			prepared[k].L_rx.lat = (-60.0 + 30.0*(k/NLNG))*D2R;
+			prepared[k].L_rx.lng = (-150.0 + 60.0*(k%NLNG))*D2R;
+			s = prepared[k].noiseP.famcache.sums;
+			retval = P533Prepare(&prepared[k]);
+			if(retval != RTN_P533OK) {
+				printf("FamCacheCheck: Error %d from P533Prepare()\n", retval);
+				return EXIT_FAILURE;
+			}
+			sprep += prepared[k].noiseP.famcache.sums - s;
+		}
+
+		for(f=0; f<NFRQS; f++) {
+			for(k=0; k<NPTS; k++) {
+				retval = P533Frequency(&out, &prepared[k], 2.0*(f + 1));
+				sfreq += out.noiseP.famcache.sums - prepared[k].noiseP.famcache.sums;
+				ncalls++;
+
+				ref = prepared[k];
+				ref.frequency = 2.0*(f + 1);
+				if((P533(&ref) != retval) || (SameResult(&out, &ref) != TRUE)) ndiff++;
+			}
+		}
+	}
+
+	printf("FamCacheCheck: %d points, %d hours and %d frequencies\n", NPTS, NHRS, NFRQS);
+	printf("FamCacheCheck: Fam1MHz series summed in P533Prepare()   %6u (%d calls)\n", sprep, NPTS*NHRS);
+	printf("FamCacheCheck: Fam1MHz series summed in P533Frequency() %6u (%ld calls)\n", sfreq, ncalls);
+	printf("FamCacheCheck: %d results differ from P533()\n", ndiff);
+
+	AttachDataset(&path, &own);
+	FreeDatasetCache(&cache);
+	FreePathMemory(&path);
+	free(prepared);
+
+	if((sfreq != 0) || (sprep > 2*NPTS*NHRS) || (ndiff != 0)) {
+		printf("FamCacheCheck: The sweep did not use the Fam cache of the prepared paths\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+
+}
+
+int SameResult(struct PathData const *a, struct PathData const *b) {
+
+	// TRUE if the noise, the signal and the reliability are bit for bit the same
+	return (memcmp(&a->noiseP.FamT, &b->noiseP.FamT, sizeof(double)) == 0) &&
+		(memcmp(&a->noiseP.DuT, &b->noiseP.DuT, sizeof(double)) == 0) &&
+		(memcmp(&a->noiseP.DlT, &b->noiseP.DlT, sizeof(double)) == 0) &&
+		(memcmp(&a->Ep, &b->Ep, sizeof(double)) == 0) &&
+		(memcmp(&a->SNR, &b->SNR, sizeof(double)) == 0) &&
+		(memcmp(&a->BCR, &b->BCR, sizeof(double)) == 0);
+
+}
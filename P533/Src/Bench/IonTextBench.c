@@ -0,0 +1,270 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+
+	IonTextBench - Benchmark of reading a text ionospheric map file. It writes the maps for a month from ionosXX.bin as
+		a text file in the iongrid layout, reads the text back with the fgets() and sscanf() loop that
+		ReadIonParametersTxt() used to have and with ReadIonParametersTxtFile(), checks that every value is identical and
+		reports the throughput of each. This is done for a text file with three decimals, as iongrid writes, and for one
+		with all nine significant digits of each float.
+
+		"make bench" and "make check" in P533/Linux build and run it. It returns EXIT_FAILURE if the values aren't
+		identical. The usage is
+			IonTextBench DataFilePath [Month] [TextFile]
+
+		where Month is 1 to 12 (1 by default) and TextFile is the scratch text file (ionosbench.txt by default).
+
+*/
+
+// Local prototypes
+int WriteText(char const *TextFile, char const *format, float ****foF2, float ****M3kF2);
+int ReadTextSscanf(char const *TextFile, float ****foF2, float ****M3kF2);
+int SameMaps(struct PathData const *a, struct PathData const *b);
+double ElapsedS(struct timespec start, struct timespec stop);
+// End local prototypes
+
+int main(int argc, char *argv[]) {
+
+	struct PathData src, a, b;
+	struct timespec start, stop;
+
+	char DataFilePath[256];
+	char const *TextFile;
+	char const *formats[2] = {"%7.3f", "%.9g"};
+
+	double tOld, tNew;	// Read times (s)
+	double mb;			// Size of the text file (MB)
+
+	int month;
+	int f;
+	int same;	// TRUE while every text file has given identical values
+
+	FILE *fp;
+
+	if((argc < 2) || (argc > 4) || (strlen(argv[1]) >= sizeof(DataFilePath))) {
+		printf("Usage: IonTextBench DataFilePath [Month] [TextFile]\n");
+		return EXIT_FAILURE;
+	}
+	strcpy(DataFilePath, argv[1]);
+	month = (argc > 2) ? atoi(argv[2]) - 1 : 0;
+	if((month < 0) || (month > 11)) month = 0;
+	TextFile = (argc > 3) ? argv[3] : "ionosbench.txt";
+
+	if((AllocatePathMemory(&src) != RTN_ALLOCATEP533OK) || (AllocatePathMemory(&a) != RTN_ALLOCATEP533OK) ||
+	   (AllocatePathMemory(&b) != RTN_ALLOCATEP533OK)) {
+		printf("IonTextBench: Can't allocate the maps\n");
+		return EXIT_FAILURE;
+	}
+
+	if(ReadIonParametersBin(month, src.foF2, src.M3kF2, DataFilePath, TRUE) != RTN_READIONPARAOK) {
+		return EXIT_FAILURE;
+	}
+
+	same = TRUE;
+	for(f=0; f<2; f++) {
+		if(WriteText(TextFile, formats[f], src.foF2, src.M3kF2) != TRUE) {
+			printf("IonTextBench: Can't write %s\n", TextFile);
+			return EXIT_FAILURE;
+		}
+		fp = fopen(TextFile, "rb");
+		fseek(fp, 0, SEEK_END);
+		mb = ftell(fp)/1.0e6;
+		fclose(fp);
+
+		// Read once first so both readers start with the file in the file system cache
+		ReadTextSscanf(TextFile, a.foF2, a.M3kF2);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		ReadTextSscanf(TextFile, a.foF2, a.M3kF2);
+		clock_gettime(CLOCK_MONOTONIC, &stop);
+		tOld = ElapsedS(start, stop);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if(ReadIonParametersTxtFile(TextFile, b.foF2, b.M3kF2, TRUE) != RTN_READIONPARAOK) return EXIT_FAILURE;
+		clock_gettime(CLOCK_MONOTONIC, &stop);
+		tNew = ElapsedS(start, stop);
+
+		printf("IonTextBench: \"%s\" %.1f MB\n", formats[f], mb);
+		printf("IonTextBench:     fgets() + sscanf()          %8.3f s %8.1f MB/s\n", tOld, mb/tOld);
+		printf("IonTextBench:     ReadIonParametersTxtFile()  %8.3f s %8.1f MB/s\n", tNew, mb/tNew);
+		if(SameMaps(&a, &b) != TRUE) same = FALSE;
+		printf("IonTextBench:     Values %s\n", (SameMaps(&a, &b) == TRUE) ? "identical" : "DIFFERENT");
+	}
+
+	remove(TextFile);
+
+	FreePathMemory(&src);
+	FreePathMemory(&a);
+	FreePathMemory(&b);
+
+	return (same == TRUE) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
+
+int WriteText(char const *TextFile, char const *format, float ****foF2, float ****M3kF2) {
+
+	/*
+
+		WriteText() - Writes the maps as a text file with the 24 hours of each grid point over six lines of five, three,
+			five, three, five and three values
+
+			INPUT
+				char const *TextFile
+				char const *format - printf() format of each value
+				float ****foF2
+				float ****M3kF2
+
+			OUTPUT
+				returns TRUE or FALSE
+
+			SUBROUTINES
+				None
+
+	*/
+
+	static int const perline[6] = {5, 3, 5, 3, 5, 3};
+
+	float ****map;
+
+	int i, j, k, m, n, l, c;
+
+	FILE *fp;
+
+	fp = fopen(TextFile, "w");
+	if(fp == NULL) return FALSE;
+
+	for(n=0; n<2; n++) {
+		map = (n == 0) ? foF2 : M3kF2;
+		for(m=0; m<2; m++) {
+			for(j=0; j<241; j++) {
+				for(k=0; k<121; k++) {
+					i = 0;
+					for(l=0; l<6; l++) {
+						for(c=0; c<perline[l]; c++) {
+							fputs("  ", fp);
+							fprintf(fp, format, map[i++][j][k][m]);
+						}
+						fputc('\n', fp);
+					}
+				}
+			}
+		}
+	}
+
+	return (fclose(fp) == 0);
+
+}
+
+int ReadTextSscanf(char const *TextFile, float ****foF2, float ****M3kF2) {
+
+	/*
+
+		ReadTextSscanf() - The fgets() and sscanf() loop of the old ReadIonParametersTxt()
+
+			INPUT
+				char const *TextFile
+
+			OUTPUT
+				Data is read into the arrays foF2 and M3kF2
+				returns TRUE or FALSE
+
+			SUBROUTINES
+				None
+
+	*/
+
+	float ****map;
+
+	char line[300];
+
+	int j, k, m, n;
+
+	FILE *fp;
+
+	fp = fopen(TextFile, "r");
+	if(fp == NULL) return FALSE;
+
+	for(n=0; n<2; n++) {
+		map = (n == 0) ? foF2 : M3kF2;
+		for(m=0; m<2; m++) {
+			for(j=0; j<241; j++) {
+				for(k=0; k<121; k++) {
+					if(fgets(line, 300, fp) == NULL) break;
+					sscanf(line, "  %f  %f  %f  %f  %f", &map[0][j][k][m], &map[1][j][k][m], &map[2][j][k][m],
+														 &map[3][j][k][m], &map[4][j][k][m]);
+					if(fgets(line, 300, fp) == NULL) break;
+					sscanf(line, "  %f  %f  %f", &map[5][j][k][m], &map[6][j][k][m], &map[7][j][k][m]);
+					if(fgets(line, 300, fp) == NULL) break;
+					sscanf(line, "  %f  %f  %f  %f  %f", &map[8][j][k][m], &map[9][j][k][m], &map[10][j][k][m],
+														 &map[11][j][k][m], &map[12][j][k][m]);
+					if(fgets(line, 300, fp) == NULL) break;
+					sscanf(line, "  %f  %f  %f", &map[13][j][k][m], &map[14][j][k][m], &map[15][j][k][m]);
+					if(fgets(line, 300, fp) == NULL) break;
+					sscanf(line, "  %f  %f  %f  %f  %f", &map[16][j][k][m], &map[17][j][k][m], &map[18][j][k][m],
+														 &map[19][j][k][m], &map[20][j][k][m]);
+					if(fgets(line, 300, fp) == NULL) break;
+					sscanf(line, "  %f  %f  %f", &map[21][j][k][m], &map[22][j][k][m], &map[23][j][k][m]);
+				}
+			}
+		}
+	}
+
+	fclose(fp);
+
+	return TRUE;
+
+}
+
+int SameMaps(struct PathData const *a, struct PathData const *b) {
+
+	/*
+
+		SameMaps() - Returns TRUE if the two maps have the same bits in every value
+
+			INPUT
+				struct PathData const *a
+				struct PathData const *b
+
+			OUTPUT
+				returns TRUE or FALSE
+
+			SUBROUTINES
+				None
+
+	*/
+
+	return (memcmp(a->ionmap, b->ionmap, IONMAPSIZE*sizeof(float)) == 0);
+
+}
+
+double ElapsedS(struct timespec start, struct timespec stop) {
+
+	/*
+
+		ElapsedS() - Returns the time between two clock readings in seconds
+
+			INPUT
+				struct timespec start
+				struct timespec stop
+
+			OUTPUT
+				returns the elapsed time (s)
+
+			SUBROUTINES
+				None
+
+	*/
+
+	return (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec)*1.0e-9;
+
+}
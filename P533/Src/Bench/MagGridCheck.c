@@ -0,0 +1,136 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+
+	MagGridCheck - Measures how far the magnetic field grid (See MagGrid.c) is from the exact model. At random points on
+		the globe it finds the magnetic dip and the gyrofrequency at 100 and 300 km with MagfitBatch() and with
+		MagGridBatch() and reports the largest and the RMS differences, and the time per control point of each. It also
+		reports the time to make the grid. No data files are needed.
+
+		"make check" in P533/Linux builds and runs it. It returns EXIT_FAILURE if a difference is larger than the limits
+		below, which are about twice the differences given in MagGrid.c. The usage is
+			MagGridCheck [number of points]
+
+*/
+
+// Local Defines
+#define DEFAULTPOINTS	1000000
+#define CHECKBLOCK		64		// Control points per call
+#define MAXDIPDIFF		0.5		// Limit of the largest dip difference (degrees)
+#define MAXDIPRMS		0.01	// Limit of the RMS dip difference (degrees)
+#define MAXFHDIFF		0.0003	// Limit of the largest fH difference (MHz)
+// End Local Defines
+
+double Seconds(void);
+
+int main(int argc, char *argv[]) {
+
+	struct ControlPt exact[CHECKBLOCK], grid[CHECKBLOCK];
+	struct ControlPt *pe[CHECKBLOCK], *pg[CHECKBLOCK];
+
+	double maxdip[2] = {0.0, 0.0}, maxfH[2] = {0.0, 0.0};
+	double ssdip[2] = {0.0, 0.0}, ssfH[2] = {0.0, 0.0};
+	double wheredip[2][2], wherefH[2][2];	// [height][lat, lng] (degrees) of the largest differences
+	double d;
+	double t, texact, tgrid;
+
+	long npts;
+	long b;
+	int hr;
+	int k;
+
+	npts = DEFAULTPOINTS;
+	if(argc > 1) npts = atol(argv[1]);
+	npts = ((npts + CHECKBLOCK - 1)/CHECKBLOCK)*CHECKBLOCK;
+
+	for(k=0; k<CHECKBLOCK; k++) {
+		pe[k] = &exact[k];
+		pg[k] = &grid[k];
+	}
+
+	// The first call makes the grid so it is timed on its own
+	grid[0].L.lat = 0.0;
+	grid[0].L.lng = 0.0;
+	t = Seconds();
+	MagGridBatch(pg, 1);
+	printf("MagGridCheck: The grid was made in %.1f ms\n", (Seconds() - t)*1e3);
+
+	srand(533);
+	texact = 0.0;
+	tgrid = 0.0;
+	for(b=0; b<npts; b+=CHECKBLOCK) {
+		for(k=0; k<CHECKBLOCK; k++) {
+			// Uniform on the sphere
+			exact[k].L.lat = asin(2.0*rand()/RAND_MAX - 1.0);
+			exact[k].L.lng = (2.0*rand()/RAND_MAX - 1.0)*PI;
+			grid[k].L = exact[k].L;
+		}
+
+		t = Seconds();
+		MagfitBatch(pe, CHECKBLOCK);
+		texact += Seconds() - t;
+
+		t = Seconds();
+		MagGridBatch(pg, CHECKBLOCK);
+		tgrid += Seconds() - t;
+
+		for(k=0; k<CHECKBLOCK; k++) {
+			for(hr=HR100km; hr<=HR300km; hr++) {
+				d = fabs(grid[k].dip[hr] - exact[k].dip[hr])*R2D;
+				ssdip[hr] += d*d;
+				if(d > maxdip[hr]) {
+					maxdip[hr] = d;
+					wheredip[hr][0] = exact[k].L.lat*R2D;
+					wheredip[hr][1] = exact[k].L.lng*R2D;
+				}
+				d = fabs(grid[k].fH[hr] - exact[k].fH[hr]);
+				ssfH[hr] += d*d;
+				if(d > maxfH[hr]) {
+					maxfH[hr] = d;
+					wherefH[hr][0] = exact[k].L.lat*R2D;
+					wherefH[hr][1] = exact[k].L.lng*R2D;
+				}
+			}
+		}
+	}
+
+	printf("MagGridCheck: %ld random points\n", npts);
+	for(hr=HR100km; hr<=HR300km; hr++) {
+		printf("%d km: dip max %.6f deg (at %.2f, %.2f) RMS %.6f deg\n", (hr == HR100km) ? 100 : 300,
+			maxdip[hr], wheredip[hr][0], wheredip[hr][1], sqrt(ssdip[hr]/npts));
+		printf("%d km: fH  max %.6f MHz (at %.2f, %.2f) RMS %.6f MHz\n", (hr == HR100km) ? 100 : 300,
+			maxfH[hr], wherefH[hr][0], wherefH[hr][1], sqrt(ssfH[hr]/npts));
+	}
+	printf("MagfitBatch()  %8.1f ns per control point\n", texact*1e9/npts);
+	printf("MagGridBatch() %8.1f ns per control point\n", tgrid*1e9/npts);
+
+	for(hr=HR100km; hr<=HR300km; hr++) {
+		if((maxdip[hr] > MAXDIPDIFF) || (sqrt(ssdip[hr]/npts) > MAXDIPRMS) || (maxfH[hr] > MAXFHDIFF)) {
+			printf("MagGridCheck: The grid differs from magfit() by more than the limits\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+
+}
+
+double Seconds(void) {
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+
+}
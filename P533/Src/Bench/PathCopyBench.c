@@ -0,0 +1,301 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+
+	PathCopyBench - Microbenchmark of passing struct PathData, struct ControlPt and struct Antenna by value. AntennaGain(),
+		AntennaGain08(), FindfoF2var(), MirrorReflectionHeight(), AbsorptionTerm() and FindLh() used to take these
+		structures by value, so each call copied them onto the stack. They now take const pointers. For each routine this
+		program reports the bytes the old call copied and the time per call with the old convention and with the new one.
+
+		The old convention is modelled by a wrapper that takes the structures by value and passes their addresses on, so
+		both columns do the same arithmetic. The wrappers are called through volatile function pointers so the compiler
+		can't inline them and drop the copies. No data files are needed.
+
+		"make bench" in P533/Linux builds and runs it. The usage is
+			PathCopyBench [number of calls]
+
+*/
+
+// Local Defines
+#define NCALLS		1000000
+// End Local Defines
+
+// Local prototypes
+// Internal P533 routines that are not in P533.h
+double MirrorReflectionHeight(struct PathData const *path, struct ControlPt const *CP, double dh);
+double AbsorptionTerm(struct ControlPt const *CP, int month, double fv);
+double FindLh(struct ControlPt const *CP, double dh, int hour, int month);
+// The old pass by value conventions
+double OldAntennaGain(struct PathData path, struct Antenna Ant, double delta, int direction);
+double OldAntennaGain08(struct PathData path, struct Antenna Ant, int direction, double * elevation);
+double OldFindfoF2var(struct PathData path, double hour, double lat, int decile);
+double OldMirrorReflectionHeight(struct PathData path, struct ControlPt CP, double dh);
+double OldAbsorptionTerm(struct ControlPt CP, int month, double fv);
+double OldFindLh(struct ControlPt CP, double dh, int hour, int month);
+void Report(char const *name, size_t bytes, double tOld, double tNew);
+double ElapsedNs(struct timespec start, struct timespec stop);
+// End local prototypes
+
+// Local variables
+// Called through these so that the wrappers are not inlined
+static double (* volatile pOldAntennaGain)(struct PathData, struct Antenna, double, int) = OldAntennaGain;
+static double (* volatile pOldAntennaGain08)(struct PathData, struct Antenna, int, double *) = OldAntennaGain08;
+static double (* volatile pOldFindfoF2var)(struct PathData, double, double, int) = OldFindfoF2var;
+static double (* volatile pOldMirrorReflectionHeight)(struct PathData, struct ControlPt, double) = OldMirrorReflectionHeight;
+static double (* volatile pOldAbsorptionTerm)(struct ControlPt, int, double) = OldAbsorptionTerm;
+static double (* volatile pOldFindLh)(struct ControlPt, double, int, int) = OldFindLh;
+// End local variables
+
+int main(int argc, char *argv[]) {
+
+	struct PathData path;
+	struct ControlPt CP;
+	struct timespec start, stop;
+
+	double (*foF2var)[FOF2VARHRS][FOF2VARLATS][FOF2VARSSNS][FOF2VARDECILES];
+
+	double sum;			// Keeps the results live
+	double elevation;
+	double tOld, tNew;	// Time per call (ns)
+
+	long n, i;
+	int j;
+
+	n = NCALLS;
+	if(argc > 1) n = atol(argv[1]);
+	if(n <= 0) n = NCALLS;
+
+	// A path with an isotropic receive antenna and enough control point data for the routines
+	memset(&path, 0, sizeof(path));
+	memset(&CP, 0, sizeof(CP));
+
+	if(AllocateAntennaMemory(&path.A_rx, 1, 360, 91) != RTN_ALLOCATEP533OK) {
+		printf("PathCopyBench: Can't allocate the antenna\n");
+		return RTN_ERRALLOCATEANT;
+	}
+	path.A_rx.freqs[0] = 10.0;
+	memset(path.A_rx.pattern[0][0], 0, 360*91*sizeof(double));
+
+	foF2var = malloc(FOF2VARSIZE*sizeof(double));
+	if(foF2var == NULL) {
+		printf("PathCopyBench: Can't allocate the foF2 variability\n");
+		return RTN_ERRALLOCATEFOF2VAR;
+	}
+	for(j=0; j<FOF2VARSIZE; j++) ((double *)foF2var)[j] = 1.0 + j*1.0e-6;
+	path.foF2var = foF2var;
+
+	path.L_tx.lat = 40.0*D2R;
+	path.L_tx.lng = -105.0*D2R;
+	path.L_rx.lat = 51.0*D2R;
+	path.L_rx.lng = 0.0;
+	path.SorL = SHORTPATH;
+	path.frequency = 10.0;
+	path.SSN = 100;
+	path.month = JUN;
+	path.season = SUMMER;
+
+	CP.L = path.L_tx;
+	CP.foE = 3.0;
+	CP.foF2 = 8.0;
+	CP.M3kF2 = 3.0;
+	CP.ltime = 12.5;
+	CP.Sun.sza = 30.0*D2R;
+	CP.Sun.lsn = 19.0;
+	CP.dip[HR100km] = 60.0*D2R;
+	path.CP[MP] = CP;
+
+	// As InitializePath() and PlanAntennas() do
+	path.AP_rx.B = Bearing(path.L_rx, path.L_tx, path.SorL)*R2D;
+	PlanAntenna(&path.AP_rx, &path.A_rx, path.frequency);
+
+	printf("PathCopyBench: %ld calls\n", n);
+	printf("PathCopyBench: sizeof(struct PathData) %lu bytes, sizeof(struct ControlPt) %lu bytes, sizeof(struct Antenna) %lu bytes\n",
+		(unsigned long)sizeof(struct PathData), (unsigned long)sizeof(struct ControlPt), (unsigned long)sizeof(struct Antenna));
+	printf("PathCopyBench: %-24s %16s %16s %16s\n", "Routine", "Old copy (bytes)", "Old (ns/call)", "New (ns/call)");
+
+	sum = 0.0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += pOldAntennaGain(path, path.A_rx, (i%80)*D2R, RXTOTX);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tOld = ElapsedNs(start, stop)/n;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += AntennaGain(&path, &path.A_rx, (i%80)*D2R, RXTOTX);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tNew = ElapsedNs(start, stop)/n;
+	Report("AntennaGain()", sizeof(struct PathData) + sizeof(struct Antenna), tOld, tNew);
+
+	// The old AntennaGain08() passed its copies on to AntennaGain() for each of the 9 elevations.
+	// AntennaGain08() now uses the antenna plan so the new time also leaves out the bearing and the frequency search.
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n/10; i++) sum += pOldAntennaGain08(path, path.A_rx, RXTOTX, &elevation);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tOld = ElapsedNs(start, stop)/(n/10);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n/10; i++) sum += AntennaGain08(&path.AP_rx, &elevation);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tNew = ElapsedNs(start, stop)/(n/10);
+	Report("AntennaGain08()", 10*(sizeof(struct PathData) + sizeof(struct Antenna)), tOld, tNew);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += pOldFindfoF2var(path, (i%24) + 0.5, (i%90)*D2R, DL);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tOld = ElapsedNs(start, stop)/n;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += FindfoF2var(&path, (i%24) + 0.5, (i%90)*D2R, DL);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tNew = ElapsedNs(start, stop)/n;
+	Report("FindfoF2var()", sizeof(struct PathData), tOld, tNew);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += pOldMirrorReflectionHeight(path, path.CP[MP], 1000.0 + i%1000);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tOld = ElapsedNs(start, stop)/n;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += MirrorReflectionHeight(&path, &path.CP[MP], 1000.0 + i%1000);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tNew = ElapsedNs(start, stop)/n;
+	Report("MirrorReflectionHeight()", sizeof(struct PathData) + sizeof(struct ControlPt), tOld, tNew);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += pOldAbsorptionTerm(path.CP[MP], path.month, 5.0 + i%5);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tOld = ElapsedNs(start, stop)/n;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += AbsorptionTerm(&path.CP[MP], path.month, 5.0 + i%5);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tNew = ElapsedNs(start, stop)/n;
+	Report("AbsorptionTerm()", sizeof(struct ControlPt), tOld, tNew);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += pOldFindLh(path.CP[MP], 2500.0 + i%5000, i%24, path.month);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tOld = ElapsedNs(start, stop)/n;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(i=0; i<n; i++) sum += FindLh(&path.CP[MP], 2500.0 + i%5000, i%24, path.month);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	tNew = ElapsedNs(start, stop)/n;
+	Report("FindLh()", sizeof(struct ControlPt), tOld, tNew);
+
+	printf("PathCopyBench: Checksum %g\n", sum);
+
+	free(foF2var);
+	FreeAntenna(&path.A_rx);
+
+	return EXIT_SUCCESS;
+
+}
+
+double OldAntennaGain(struct PathData path, struct Antenna Ant, double delta, int direction) {
+	return AntennaGain(&path, &Ant, delta, direction);
+}
+
+double OldAntennaGain08(struct PathData path, struct Antenna Ant, int direction, double * elevation) {
+
+	/*
+
+		OldAntennaGain08() - AntennaGain08() as it was, passing its copies on to AntennaGain() by value
+
+			INPUT
+				struct PathData path
+				struct Antenna Ant
+				int direction
+				double *elevation
+
+			OUTPUT
+				elevation - Elevation of the largest gain
+				returns the largest gain from 0 to 8 degrees elevation
+
+			SUBROUTINES
+				OldAntennaGain()
+
+	*/
+
+	double Gmax, G;
+
+	int i;
+
+	Gmax = TINYDB;
+	for(i=0; i<9; i++) {
+		G = pOldAntennaGain(path, Ant, ((double)i)*D2R, direction);
+		if(G > Gmax) {
+			Gmax = G;
+			*elevation = i*D2R;
+		}
+	}
+
+	return Gmax;
+
+}
+
+double OldFindfoF2var(struct PathData path, double hour, double lat, int decile) {
+	return FindfoF2var(&path, hour, lat, decile);
+}
+
+double OldMirrorReflectionHeight(struct PathData path, struct ControlPt CP, double dh) {
+	return MirrorReflectionHeight(&path, &CP, dh);
+}
+
+double OldAbsorptionTerm(struct ControlPt CP, int month, double fv) {
+	return AbsorptionTerm(&CP, month, fv);
+}
+
+double OldFindLh(struct ControlPt CP, double dh, int hour, int month) {
+	return FindLh(&CP, dh, hour, month);
+}
+
+void Report(char const *name, size_t bytes, double tOld, double tNew) {
+
+	/*
+
+		Report() - Prints one line of the results
+
+			INPUT
+				char const *name - Routine
+				size_t bytes - Bytes copied by one call with the old convention
+				double tOld - Time per call with the old convention (ns)
+				double tNew - Time per call with the new convention (ns)
+
+			OUTPUT
+				None
+
+			SUBROUTINES
+				None
+
+	*/
+
+	printf("PathCopyBench: %-24s %16lu %16.1f %16.1f\n", name, (unsigned long)bytes, tOld, tNew);
+
+}
+
+double ElapsedNs(struct timespec start, struct timespec stop) {
+
+	/*
+
+		ElapsedNs() - Returns the time between two clock readings in nanoseconds
+
+			INPUT
+				struct timespec start
+				struct timespec stop
+
+			OUTPUT
+				returns the elapsed time (ns)
+
+			SUBROUTINES
+				None
+
+	*/
+
+	return (stop.tv_sec - start.tv_sec)*1.0e9 + (stop.tv_nsec - start.tv_nsec);
+
+}
@@ -0,0 +1,277 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+ * An antenna cache file, <antenna file>.cache, holds an antenna pattern exactly as it is in memory after ReadType11(),
+ * ReadType13() or ReadType14(): the header below, the freqn frequencies and then the [freqn][azin][elen] block of gains
+ * (See AllocateAntennaMemory()). ReadAntennaCache() loads the frequencies and the whole block with one read each, so
+ * repeated runs with the same antenna files don't parse the text again.
+ *
+ * A cache file is only used if it was made from the same antenna file path with the same modification time and size. The
+ * pattern is stored unrotated, so a type 13 cache serves any main beam bearing (See struct Antenna). The cache is in the
+ * machine's own double format, as checked by ANTCACHECHECK.
+ */
+
+// Local defines
+#define ANTCACHEMAGIC	"P533ANTC"
+#define ANTCACHEVERSION	2
+#define ANTCACHECHECK	1234.5		// Detects a file that was made on a machine with a different double format
+#define ANTCACHESUFFIX	".cache"
+// End local defines
+
+// Local structures
+struct AntCacheHeader {
+	char magic[8];			// ANTCACHEMAGIC
+	int version;			// ANTCACHEVERSION
+	int type;				// Antenna file type 11, 13 or 14
+	int freqn;				// Number of frequencies
+	int azin;				// Number of azimuths
+	int elen;				// Number of elevations
+	long long mtime;		// Modification time of the antenna file
+	long long size;			// Size of the antenna file (bytes)
+	double check;			// ANTCACHECHECK
+	char source[256];		// Antenna file path
+	char Name[256];			// Antenna name
+};
+// End local structures
+
+// Local prototypes
+int MakeAntCacheHeader(struct AntCacheHeader *hdr, char const *AntFilePath, int type);
+// End local prototypes
+
+DLLEXPORT int ReadAntennaCache(struct Antenna *Ant, char const *AntFilePath, double bearing, int *type, int silent) {
+
+	/*
+
+		ReadAntennaCache() - Loads an antenna pattern from the cache file <AntFilePath>.cache made by WriteAntennaCache().
+			The frequencies are read with one read and the whole pattern with another straight into the block allocated by
+			AllocateAntennaMemory().
+
+			If there is no cache file, or it is out of date, this returns RTN_ERRANTENNACACHE without a message and the caller
+			should read the antenna file itself.
+
+			INPUT
+				struct Antenna *Ant
+				char const *AntFilePath - The antenna file the cache was made from
+				double bearing - Main beam bearing (radians) of a type 13 antenna
+				int *type
+				int silent
+
+			OUTPUT
+				Ant - The antenna pattern
+				type - The type of the antenna file the cache was made from
+				returns RTN_READANTENNAPATTERNSOK or RTN_ERRANTENNACACHE
+
+			SUBROUTINES
+				MakeAntCacheHeader()
+				AllocateAntennaMemory()
+				FreeAntenna()
+
+	*/
+
+	struct AntCacheHeader expected, hdr;
+
+	char CacheFilePath[256+sizeof(ANTCACHESUFFIX)];
+
+	size_t ngain;		// Number of gains in the block
+
+	FILE *fp;
+
+	if(strlen(AntFilePath) >= sizeof(hdr.source)) return RTN_ERRANTENNACACHE;
+
+	strcpy(CacheFilePath, AntFilePath);
+	strcat(CacheFilePath, ANTCACHESUFFIX);
+
+	fp = fopen(CacheFilePath, "rb");
+	if(fp == NULL) return RTN_ERRANTENNACACHE;
+
+	if(fread(&hdr, sizeof(hdr), 1, fp) != 1) {
+		fclose(fp);
+		return RTN_ERRANTENNACACHE;
+	}
+
+	// The type is only known from the cache so build the expected header with it
+	if(MakeAntCacheHeader(&expected, AntFilePath, hdr.type) != RTN_READANTENNAPATTERNSOK) {
+		fclose(fp);
+		return RTN_ERRANTENNACACHE;
+	}
+
+	if((memcmp(hdr.magic, expected.magic, sizeof(hdr.magic)) != 0) || (hdr.version != expected.version) ||
+	   (hdr.check != expected.check) || (hdr.mtime != expected.mtime) ||
+	   (hdr.size != expected.size) || (strcmp(hdr.source, expected.source) != 0) ||
+	   (hdr.freqn < 1) || (hdr.azin < 1) || (hdr.elen < 1)) {
+		fclose(fp);
+		return RTN_ERRANTENNACACHE;
+	}
+
+	if(AllocateAntennaMemory(Ant, hdr.freqn, hdr.azin, hdr.elen) != RTN_ALLOCATEP533OK) {
+		fclose(fp);
+		return RTN_ERRANTENNACACHE;
+	}
+
+	ngain = (size_t)hdr.freqn*hdr.azin*hdr.elen;
+	if((fread(Ant->freqs, sizeof(double), hdr.freqn, fp) != (size_t)hdr.freqn) ||
+	   (fread(Ant->pattern[0][0], sizeof(double), ngain, fp) != ngain)) {
+		fclose(fp);
+		FreeAntenna(Ant);
+		return RTN_ERRANTENNACACHE;
+	}
+	fclose(fp);
+
+	hdr.Name[sizeof(hdr.Name)-1] = '\0';
+	strcpy(Ant->Name, hdr.Name);
+
+	*type = hdr.type;
+
+	// As ReadType13() does
+	if(hdr.type == 13) Ant->rotation = (((int)(bearing*R2D)%360) + 360)%360;
+
+	// User feedback
+	if(silent != TRUE) {
+		printf("ReadAntennaCache: Reading antenna %.35s from %s\n", Ant->Name, CacheFilePath);
+	}
+
+	return RTN_READANTENNAPATTERNSOK;
+
+}
+
+DLLEXPORT int WriteAntennaCache(struct Antenna const *Ant, char const *AntFilePath, int type, int silent) {
+
+	/*
+
+		WriteAntennaCache() - Writes the antenna pattern that was just read from AntFilePath to the cache file
+			<AntFilePath>.cache so that ReadAntennaCache() can load it next time. The file is written under a temporary name
+			and then renamed, so a process reading the old cache is not disturbed.
+
+			INPUT
+				struct Antenna const *Ant - As read by ReadType11(), ReadType13() or ReadType14()
+				char const *AntFilePath - The antenna file the pattern was read from
+				int type - Antenna file type 11, 13 or 14
+				int silent
+
+			OUTPUT
+				Writes <AntFilePath>.cache
+				returns RTN_READANTENNAPATTERNSOK or RTN_ERRANTENNACACHE
+
+			SUBROUTINES
+				MakeAntCacheHeader()
+
+	*/
+
+	struct AntCacheHeader hdr;
+
+	char CacheFilePath[256+sizeof(ANTCACHESUFFIX)];
+	char TmpFilePath[256+sizeof(ANTCACHESUFFIX)+4];
+
+	size_t ngain;		// Number of gains in the block
+
+	FILE *fp;
+
+	int ok;
+
+	if((Ant->pattern == NULL) || (Ant->freqs == NULL)) return RTN_ERRANTENNACACHE;
+
+	if(MakeAntCacheHeader(&hdr, AntFilePath, type) != RTN_READANTENNAPATTERNSOK) {
+		return RTN_ERRANTENNACACHE;
+	}
+	hdr.freqn = Ant->freqn;
+	// All of the antenna file types are read into 1-degree azimuths and elevations
+	hdr.azin = 360;
+	hdr.elen = 91;
+	memcpy(hdr.Name, Ant->Name, sizeof(hdr.Name));
+	hdr.Name[sizeof(hdr.Name)-1] = '\0';
+
+	strcpy(CacheFilePath, AntFilePath);
+	strcat(CacheFilePath, ANTCACHESUFFIX);
+	strcpy(TmpFilePath, CacheFilePath);
+	strcat(TmpFilePath, ".tmp");
+
+	fp = fopen(TmpFilePath, "wb");
+	if(fp == NULL) {
+		if(silent != TRUE) {
+			printf("WriteAntennaCache: Can't create %s\n", TmpFilePath);
+		}
+		return RTN_ERRANTENNACACHE;
+	}
+
+	if(silent != TRUE) {
+		printf("WriteAntennaCache: Writing file %s\n", CacheFilePath);
+	}
+
+	ngain = (size_t)hdr.freqn*hdr.azin*hdr.elen;
+	ok = (fwrite(&hdr, sizeof(hdr), 1, fp) == 1);
+	ok = ok && (fwrite(Ant->freqs, sizeof(double), hdr.freqn, fp) == (size_t)hdr.freqn);
+	ok = ok && (fwrite(Ant->pattern[0][0], sizeof(double), ngain, fp) == ngain);
+	ok = (fclose(fp) == 0) && ok;
+
+#ifdef _WIN32
+	// rename() does not replace an existing file on Windows
+	if(ok) remove(CacheFilePath);
+#endif
+	if(!ok || (rename(TmpFilePath, CacheFilePath) != 0)) {
+		if(silent != TRUE) {
+			printf("WriteAntennaCache: Can't write %s\n", CacheFilePath);
+		}
+		remove(TmpFilePath);
+		return RTN_ERRANTENNACACHE;
+	}
+
+	return RTN_READANTENNAPATTERNSOK;
+
+}
+
+int MakeAntCacheHeader(struct AntCacheHeader *hdr, char const *AntFilePath, int type) {
+
+	/*
+
+		MakeAntCacheHeader() - Fills in the header of an antenna cache file for the antenna file as it is now. The dimensions
+			and the name are left for the caller.
+
+			INPUT
+				struct AntCacheHeader *hdr
+				char const *AntFilePath
+				int type - Antenna file type
+
+			OUTPUT
+				struct AntCacheHeader *hdr
+				returns RTN_READANTENNAPATTERNSOK or RTN_ERRANTENNACACHE if the antenna file can't be found
+
+			SUBROUTINES
+				None
+
+	*/
+
+#ifdef _WIN32
+	struct _stat64 st;
+#else
+	struct stat st;
+#endif
+
+	if(strlen(AntFilePath) >= sizeof(hdr->source)) return RTN_ERRANTENNACACHE;
+
+#ifdef _WIN32
+	if(_stat64(AntFilePath, &st) != 0) return RTN_ERRANTENNACACHE;
+#else
+	if(stat(AntFilePath, &st) != 0) return RTN_ERRANTENNACACHE;
+#endif
+
+	memset(hdr, 0, sizeof(struct AntCacheHeader));
+	memcpy(hdr->magic, ANTCACHEMAGIC, sizeof(hdr->magic));
+	hdr->version = ANTCACHEVERSION;
+	hdr->type = type;
+	hdr->mtime = (long long)st.st_mtime;
+	hdr->size = (long long)st.st_size;
+	hdr->check = ANTCACHECHECK;
+	strcpy(hdr->source, AntFilePath);
+
+	return RTN_READANTENNAPATTERNSOK;
+
+}
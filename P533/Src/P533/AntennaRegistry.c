@@ -0,0 +1,317 @@
+#ifndef _WIN32
+	#define _POSIX_C_SOURCE 200112L // pthread_mutex_t
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+ * The antenna registry holds one copy of each antenna file that has been read in the process. RegisterAntenna() reads a
+ * file the first time it is asked for and afterwards hands out the same pattern, so paths, threads and transmitters that
+ * use the same antenna file share one read only copy. The patterns are stored unrotated and each path's struct Antenna
+ * carries its own main beam rotation, which AntennaGain() applies at lookup, so the bearing is not part of the key.
+ *
+ * The registry is kept until FreeAntennaRegistry(). A file is not read again if it changes while the process runs.
+ */
+
+// Local defines
+#define ANTREGISTRYINC	8	// Number of entries the registry grows by
+// End local defines
+
+// Local structures
+struct AntennaEntry {
+	char source[256];		// Antenna file path
+	int type;				// Antenna file type 11, 13 or 14
+	struct Antenna Ant;		// Unrotated pattern
+};
+// End local structures
+
+// Local variables
+static struct AntennaEntry *Registry = NULL;
+static int RegistryN = 0;		// Number of entries in use
+static int RegistrySize = 0;	// Number of entries allocated
+#ifdef _WIN32
+	static SRWLOCK RegistryLock = SRWLOCK_INIT;
+#else
+	static pthread_mutex_t RegistryLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+// End local variables
+
+// Local prototypes
+void LockRegistry(void);
+void UnlockRegistry(void);
+// End local prototypes
+
+DLLEXPORT int RegisterAntenna(struct Antenna *Ant, char const *AntFilePath, double bearing, int cache, int silent) {
+
+	/*
+
+		RegisterAntenna() - Gives Ant the shared pattern of the antenna file AntFilePath, reading the file if it is not in
+			the registry yet. Ant is marked shared so FreeAntenna() and FreePathMemory() leave the pattern alone. Ant must not
+			be written to, for example with SetAntennaPatternVal().
+
+			INPUT
+				struct Antenna *Ant
+				char const *AntFilePath
+				double bearing - Main beam bearing (radians) for type 13 files
+				int cache - TRUE to load and save the pattern in a cache file (See AntennaCache.c)
+				int silent
+
+			OUTPUT
+				Ant - The antenna pattern with the rotation for the bearing
+				returns RTN_READANTENNAPATTERNSOK, RTN_ERRCANTOPENANTFILE or RTN_ERRALLOCATEANT
+
+			SUBROUTINES
+				LockRegistry()
+				UnlockRegistry()
+				ReadAntennaCache()
+				ReadAntennaFile()
+				WriteAntennaCache()
+				FreeAntenna()
+
+	*/
+
+	struct AntennaEntry *entry;
+	struct AntennaEntry *grown;
+
+	int retval;
+	int i;
+
+	if(strlen(AntFilePath) >= sizeof(entry->source)) return RTN_ERRCANTOPENANTFILE;
+
+	LockRegistry();
+
+	entry = NULL;
+	for(i=0; i<RegistryN; i++) {
+		if(strcmp(Registry[i].source, AntFilePath) == 0) {
+			entry = &Registry[i];
+			break;
+		}
+	}
+
+	if(entry == NULL) {
+		if(RegistryN == RegistrySize) {
+			grown = (struct AntennaEntry *) realloc(Registry, (RegistrySize + ANTREGISTRYINC)*sizeof(struct AntennaEntry));
+			if(grown == NULL) {
+				UnlockRegistry();
+				return RTN_ERRALLOCATEANT;
+			}
+			Registry = grown;
+			RegistrySize += ANTREGISTRYINC;
+		}
+
+		entry = &Registry[RegistryN];
+		memset(entry, 0, sizeof(struct AntennaEntry));
+		strcpy(entry->source, AntFilePath);
+
+		// The entry is read with no bearing so that it is unrotated
+		retval = RTN_ERRANTENNACACHE;
+		if(cache == TRUE) {
+			retval = ReadAntennaCache(&entry->Ant, AntFilePath, 0.0, &entry->type, silent);
+		}
+		if(retval != RTN_READANTENNAPATTERNSOK) {
+			retval = ReadAntennaFile(&entry->Ant, AntFilePath, 0.0, &entry->type, silent);
+			// Failing to write the cache only means that the antenna file is read again next time
+			if((retval == RTN_READANTENNAPATTERNSOK) && (cache == TRUE)) {
+				WriteAntennaCache(&entry->Ant, AntFilePath, entry->type, silent);
+			}
+		}
+
+		if(retval != RTN_READANTENNAPATTERNSOK) {
+			FreeAntenna(&entry->Ant);
+			UnlockRegistry();
+			return retval;
+		}
+
+		entry->Ant.shared = TRUE;
+		RegistryN++;
+	}
+	else if(silent != TRUE) {
+		printf("RegisterAntenna: Sharing antenna %.35s\n", entry->Ant.Name);
+	}
+
+	*Ant = entry->Ant;
+
+	// As ReadType13() does
+	if(entry->type == 13) Ant->rotation = (((int)(bearing*R2D)%360) + 360)%360;
+
+	UnlockRegistry();
+
+	return RTN_READANTENNAPATTERNSOK;
+
+}
+
+DLLEXPORT void FreeAntennaRegistry(void) {
+
+	/*
+
+		FreeAntennaRegistry() - Frees all of the patterns in the antenna registry. Any struct Antenna that was given a pattern
+			by RegisterAntenna() must not be used afterwards.
+
+			INPUT
+				None
+
+			OUTPUT
+				None
+
+			SUBROUTINES
+				LockRegistry()
+				UnlockRegistry()
+				FreeAntenna()
+
+	*/
+
+	int i;
+
+	LockRegistry();
+
+	for(i=0; i<RegistryN; i++) {
+		Registry[i].Ant.shared = FALSE;
+		FreeAntenna(&Registry[i].Ant);
+	}
+	free(Registry);
+	Registry = NULL;
+	RegistryN = 0;
+	RegistrySize = 0;
+
+	UnlockRegistry();
+
+}
+
+DLLEXPORT int ReadAntennaFile(struct Antenna *Ant, char const *AntFilePath, double bearing, int *type, int silent) {
+
+	/*
+
+		ReadAntennaFile() - Reads an antenna file of type 11, 13 or 14. The type is on the fourth line of the file.
+
+			INPUT
+				struct Antenna *Ant
+				char const *AntFilePath
+				double bearing - Main beam bearing (radians) for type 13 files
+				int *type
+				int silent
+
+			OUTPUT
+				Ant - The antenna pattern
+				type - The antenna file type
+				returns RTN_READANTENNAPATTERNSOK, RTN_ERRCANTOPENANTFILE or the error from the reader
+
+			SUBROUTINES
+				ReadType11()
+				ReadType13()
+				ReadType14()
+
+	*/
+
+	#ifdef __GNUC__
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wunused-result"
+	#endif
+
+	char line[256];		// Read input line
+	char instr[256];	// String temp
+
+	int retval;
+	int lineCtr;
+
+	FILE *fp;
+
+	/* VOACAP type antennas identify the antenna type on the forth
+	 * line; e.g;
+	 *   14    [ 2] Antenna Type..: 30 x (efficiency + 91 gain values) follow
+	 */
+	fp = fopen(AntFilePath, "r");
+	if(fp == NULL) return RTN_ERRCANTOPENANTFILE;
+
+	line[0] = '\0';
+	for(lineCtr = 0; lineCtr<4; ++lineCtr) {
+		fgets(line, sizeof(line), fp);		// Scroll to line 3, Antenna type
+	}
+
+	*type = 0;
+	sscanf(line, " %d %s\n", type, instr);
+	rewind(fp);
+
+	if(*type == 11) {
+		retval = ReadType11(Ant, fp, silent);
+	}
+	else if(*type == 13) {
+		retval = ReadType13(Ant, fp, bearing, silent);
+	}
+	else if(*type == 14) {
+		retval = ReadType14(Ant, fp, silent);
+	}
+	else {
+		printf("Unsuppported antenna type: %d\n", *type);
+		retval = RTN_ERRCANTOPENANTFILE;
+	}
+	fclose(fp);
+
+	return retval;
+
+	#ifdef __GNUC__
+	#pragma GCC diagnostic pop
+	#endif
+}
+
+void LockRegistry(void) {
+
+	/*
+
+		LockRegistry() - Takes the lock on the antenna registry
+
+			INPUT
+				None
+
+			OUTPUT
+				None
+
+			SUBROUTINES
+				None
+
+	*/
+
+#ifdef _WIN32
+	AcquireSRWLockExclusive(&RegistryLock);
+#else
+	pthread_mutex_lock(&RegistryLock);
+#endif
+
+}
+
+void UnlockRegistry(void) {
+
+	/*
+
+		UnlockRegistry() - Releases the lock on the antenna registry
+
+			INPUT
+				None
+
+			OUTPUT
+				None
+
+			SUBROUTINES
+				None
+
+	*/
+
+#ifdef _WIN32
+	ReleaseSRWLockExclusive(&RegistryLock);
+#else
+	pthread_mutex_unlock(&RegistryLock);
+#endif
+
+}
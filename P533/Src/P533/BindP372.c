@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+// Local Defines
+#define UNBOUND		0
+#define BOUND		1
+// End Local Defines
+
+// Records whether the P372 entry points have been resolved for this process
+static int P372state = UNBOUND;
+
+DLLEXPORT int BindP372(void) {
+
+	/*
+
+		BindP372() - Resolves the P372 noise routines once per process. The dll function pointers in Noise.h
+			are shared by every subroutine in the P533 library. Previously P533(), AllocatePathMemory() and
+			FreePathMemory() each loaded the P372 library and looked up its symbols every time they were called.
+			In an area coverage run this meant one library load and six symbol lookups per calculation point.
+			Now the first call does the binding and every later call returns immediately.
+
+			When the P533 library is built with P372STATIC defined, the P372 source is compiled into the P533
+			library and the function pointers are bound directly to the linked routines. No dynamic load is done.
+
+			INPUT
+				None
+
+			OUTPUT
+				dllP372Version()
+				dllP372CompileTime()
+				dllP372DataLayout()
+				dllNoise()
+				dllAllocateNoiseMemory()
+				dllFreeNoiseMemory()
+				dllReadFamDud()
+				dllInitializeNoise()
+				returns RTN_P372BOUNDOK or RTN_ERRP372DLL
+
+			SUBROUTINES
+				None
+
+	*/
+
+	if(P372state == BOUND) return RTN_P372BOUNDOK;
+
+#ifdef P372STATIC
+	dllP372Version = (void *)P372Version;
+	dllP372CompileTime = (void *)P372CompileTime;
+	dllP372DataLayout = P372DataLayout;
+	dllNoise = Noise;
+	dllAllocateNoiseMemory = AllocateNoiseMemory;
+	dllFreeNoiseMemory = FreeNoiseMemory;
+	dllReadFamDud = ReadFamDud;
+	dllInitializeNoise = InitializeNoise;
+#elif _WIN32
+	// Get the handle to the P372 DLL.
+	hLib = LoadLibrary("P372.dll");
+	if (hLib == NULL) {
+		printf("P533: BindP372: Error %d P372.DLL Not Found\n", RTN_ERRP372DLL);
+		return RTN_ERRP372DLL;
+	}
+	int mod[512];
+	// Get the handle to the DLL library, hLib.
+	GetModuleFileName((HMODULE)hLib, (LPTSTR)mod, 512);
+	// Get the P372Version() process from the DLL.
+	dllP372Version = (cP372Info)GetProcAddress((HMODULE)hLib, "P372Version");
+	// Get the P372CompileTime() process from the DLL.
+	dllP372CompileTime = (cP372Info)GetProcAddress((HMODULE)hLib, "P372CompileTime");
+	dllP372DataLayout = (iP372DataLayout)GetProcAddress((HMODULE)hLib, "P372DataLayout");
+
+	dllNoise = (iNoise)GetProcAddress((HMODULE)hLib, "Noise");
+	dllAllocateNoiseMemory = (iNoiseMemory)GetProcAddress((HMODULE)hLib, "AllocateNoiseMemory");
+	dllFreeNoiseMemory = (iNoiseMemory)GetProcAddress((HMODULE)hLib, "FreeNoiseMemory");
+	dllReadFamDud = (iReadFamDud)GetProcAddress((HMODULE)hLib, "ReadFamDud");
+	dllInitializeNoise = (vInitializeNoise)GetProcAddress((HMODULE)hLib, "InitializeNoise");
+#elif __linux__ || __APPLE__
+	hLib = dlopen("libp372.so", RTLD_NOW);
+	if (!hLib) {
+		printf("P533: BindP372: Error %d Couldn't load libp372.so\n", RTN_ERRP372DLL);
+		return RTN_ERRP372DLL;
+	}
+	dllP372Version = dlsym(hLib, "P372Version");
+	dllP372CompileTime = dlsym(hLib, "P372CompileTime");
+	dllP372DataLayout = dlsym(hLib, "P372DataLayout");
+	dllNoise = dlsym(hLib, "Noise");
+	dllAllocateNoiseMemory = dlsym(hLib, "AllocateNoiseMemory");
+	dllFreeNoiseMemory = dlsym(hLib, "FreeNoiseMemory");
+	dllReadFamDud = dlsym(hLib, "ReadFamDud");
+	dllInitializeNoise = dlsym(hLib, "InitializeNoise");
+#endif
+
+	// The noise coefficient tables are allocated by P372 and indexed with the layout in Noise.h, so they must agree
+	if((dllP372DataLayout == NULL) || (dllP372DataLayout() != P372DATALAYOUT)) {
+		printf("P533: BindP372: Error %d The P372 library has a different data layout\n", RTN_ERRP372DLL);
+		return RTN_ERRP372DLL;
+	}
+
+	P372state = BOUND;
+
+	return RTN_P372BOUNDOK;
+
+}
@@ -7,6 +7,12 @@
 #include "P533.h"
 // End local includes
 
+// Local defines
+#define IONBATCHBLOCK	16	// Number of control points IonosphericParametersBatch() evaluates together
+#define IONZEROLAT		60	// Latitude index of the equator in the ionospheric maps
+#define IONZEROLNG		120	// Longitude index of the prime meridian in the ionospheric maps
+// End local defines
+
 void CalculateCPParameters( struct PathData *path, struct ControlPt *here) {
 
 	/*
@@ -30,10 +36,10 @@ void CalculateCPParameters( struct PathData *path, struct ControlPt *here) {
 	 			via FindFoE()
 	 				here->foE - Critical frequency fo the E layer
 	 				here->ltime - Local time
-	 			via magfit()
+	 			via MagfitBatch() or MagGridBatch() if path->MagField is MAGFIELDGRID
 	 				here->dip[2] - Magnetic dip calculated at 100 and 300 km
 	 				here->fH[2] - Gyrofreqency calculated at 100 and 300 km
-	 			via SolarParameters() 
+	 			via SolarPosition() and path->Sun
 	 				here->Sun.ha - Hour angle (radians)
 	 				here->Sun.sha -  Sunrise/Sunset hour angle (radians)
 	 				here->Sun.sza - Solar zenith angle (radians)
@@ -44,47 +50,109 @@ void CalculateCPParameters( struct PathData *path, struct ControlPt *here) {
 	 				here->Sun.lss - local sunset (hours)
 	 
 	 		SUBROUTINES
-				IonosphericParameters()
-				SolarParameters()
-				FindfoE()
-				magfit()
+				CalculateCPIonosphere()
+				MagfitBatch()
+				MagGridBatch()
 
 	 */
 
-	/*
-	 * Find the ionospheric parameters foF2 and M3kF2 at the control point here.
-	 * If here is not on a grid point then use bilinear interpolation.
-	 */
-	IonosphericParameters(here, path->foF2, path->M3kF2, path->hour, path->SSN);
-
-	/*
-	 * Calculate the solar parameters. 
-	 * These parametres are used in the MedianSkywaveFieldStrengthLong() calculation. Because this 
-	 * routine determines the control point parameters for all methods, find the solar parameters now
-	 * before entering the conditional loop for the foE calculation.
-	 */
-	// Find the solar parameters for the control point.
-	SolarParameters(here, path->month, (double)path->hour);
-		
-	/*
-	 * Calculate foE by the method outlined in P.1239-2. 
-	 */
-	FindfoE(here, path->month, path->hour, path->SSN);
+	CalculateCPIonosphere(path, here);
 
 	/* 
 	 * At each control point the gyrofrequency and magnetic dip must also be calculated.
 	 * The calculation is done at two heights: 
 	 *		height = 300 km is for the determination of MUF and the long path (> 9000 km).
      *      height = 100 km is used in the determination of absorption on the int paths (< 9000 km).
+	 * MagfitBatch() does both heights in one pass. MagGridBatch() interpolates them from the magnetic field grid instead.
+	 */
+	if(path->MagField == MAGFIELDGRID) {
+		MagGridBatch(&here, 1);
+	}
+	else {
+		MagfitBatch(&here, 1);
+	}
+
+	return;
+}
+
+void CalculateCPIonosphere(struct PathData *path, struct ControlPt *here) {
+
+	/*
+
+	  CalculateCPIonosphere() - The part of CalculateCPParameters() that depends on the hour: foF2, M3kF2, foE and the solar
+			parameters. The gyrofrequency and magnetic dip only depend on the location of the control point, so a caller that
+			finds the parameters of the same control point for many hours can find them once with MagfitBatch().
+
+	 		INPUT
+	 			struct PathData *path
+	 			struct ControlPt *here - This is a pointer to the control point of interest.
+
+	 		OUTPUT
+	 			here - As CalculateCPParameters() except here->dip[] and here->fH[]
+
+	 		SUBROUTINES
+				CalculateCPIonosphereBatch()
+
 	 */
 
-	magfit(here, 100.00);
-	magfit(here, 300.00);
+	CalculateCPIonosphereBatch(path, &here, 1);
 
 	return;
 }
 
-void IonosphericParameters(struct ControlPt *here, float ****foF2, float ****M3kF2, int hour, int SSN){
+void CalculateCPIonosphereBatch(struct PathData *path, struct ControlPt *here[], int n) {
+
+	/*
+
+	  CalculateCPIonosphereBatch() - CalculateCPIonosphere() for n control points. The ionospheric parameters for all of
+			the control points are found by one call to IonosphericParametersBatch().
+
+	 		INPUT
+	 			struct PathData *path - With path->Sun from InitializeCircuit()
+	 			struct ControlPt *here[] - Control points of interest
+				int n - Number of control points
+
+	 		OUTPUT
+	 			here[] - As CalculateCPParameters() except here[]->dip[] and here[]->fH[]
+
+	 		SUBROUTINES
+				IonosphericParametersBatch()
+				SolarPosition()
+				FindfoE()
+
+	 */
+
+	int k;
+
+	/*
+	 * Find the ionospheric parameters foF2 and M3kF2 at the control points.
+	 * If a control point is not on a grid point then use bilinear interpolation.
+	 */
+	IonosphericParametersBatch(here, n, path->ionmap, path->hour, path->SSN);
+
+	for(k=0; k<n; k++) {
+		/*
+		 * Calculate the solar parameters. 
+		 * These parametres are used in the MedianSkywaveFieldStrengthLong() calculation. Because this 
+		 * routine determines the control point parameters for all methods, find the solar parameters now
+		 * before entering the conditional loop for the foE calculation.
+		 */
+		// Find the solar parameters for the control point. The declination and the equation of time are the same for
+		// every control point, so they are taken from the path (See InitializeCircuit()).
+		here[k]->Sun.decl = path->Sun.decl;
+		here[k]->Sun.eot = path->Sun.eot;
+		SolarPosition(here[k], (double)path->hour);
+
+		/*
+		 * Calculate foE by the method outlined in P.1239-2. 
+		 */
+		FindfoE(here[k], path->month, path->hour, path->SSN);
+	}
+
+	return;
+}
+
+void IonosphericParameters(struct ControlPt *here, float const *ionmap, int hour, int SSN){
 
 	/*
 	 
@@ -92,8 +160,7 @@ void IonosphericParameters(struct ControlPt *here, float ****foF2, float ****M3k
 	 
 	  	INPUTS
 	 		struct ControlPt *here,
-	  		double ****foF2
-	 		double ****M3kF2
+	  		float const *ionmap - foF2 and M(3000)F2 maps (See IONMAPCELLPTR())
 	 		int hour
 	 		int SSN
 	 
@@ -102,252 +169,160 @@ void IonosphericParameters(struct ControlPt *here, float ****foF2, float ****M3k
 	 		here->M3KF2
 
 		SUBROUTINES
-			BilinearInterpolation()
+			IonosphericParametersBatch()
+
+	*/
+
+	IonosphericParametersBatch(&here, 1, ionmap, hour, SSN);
+
+	return;
+
+}
+
+void IonosphericParametersBatch(struct ControlPt *here[], int n, float const *ionmap, int hour, int SSN) {
+
+	/*
+
+	  IonosphericParametersBatch() - Finds foF2 and M(3000)F2 by Bilinear Interpolation for n control points.
+			The control points are taken IONBATCHBLOCK at a time in three passes, each a loop over the control points
+			in the block with no branches that the compiler can vectorise:
+				i) The grid indices of the four neighbours and the interpolation weights. The neighbours are chosen by
+				   selects on the hemisphere rather than by a branch for each quadrant, edge and corner.
+				ii) The four neighbouring grid cells. Each cell holds foF2 and M(3000)F2 for both SSNs, so all four
+				    values of a neighbour are fetched together.
+				iii) The interpolation of the four values and then the interpolation by the SSN.
+			The results are the same as those of the earlier quadrant by quadrant code.
+
+	  	INPUTS
+	 		struct ControlPt *here[] - Control points of interest
+			int n - Number of control points
+	  		float const *ionmap - foF2 and M(3000)F2 maps (See IONMAPCELLPTR())
+	 		int hour
+	 		int SSN
+
+	 	OUTPUT
+	 		here[]->foF2
+	 		here[]->M3KF2
+
+		SUBROUTINES
+			None
 
  		I am indebted to Peter Suessman for the use of his program, iongrid ver 1.80, which was used extensively
  		to verify the method in this routine. 
 
 	*/
-	 	
-	struct Neighbor {
-		struct Location L; // the physical location of the point
-		double foF2[2], M3kF2[2]; // the values for the ionospheric parameters at the point
-		int j, k; // the j (lng) and k (lat) indexes into the gridpoint map. 
-	} UL, UR, LR, LL; // UL = upper left, UR = upper right, LR = lower right and LL = lower left
-	
-	struct Neighbor ned; //  
-    
-	// Temporary Varibles
-	int m; // Temp the SSN index
-	int n; // Temp hours index
 
-	
-	
-	int		lng, lat;	// gridmap maxima
+	float const *map;	// The maps for the hour
+	float const *cell;	// Temp grid cell in the ionospheric map
+
+	// The neighbours in the order LL = lower left, LR = lower right, UL = upper left and UR = upper right
+	int nbr[4][IONBATCHBLOCK];					// Offset of the neighbour's grid cell in map
+	double w[4][IONBATCHBLOCK];					// Bilinear weight of the neighbour
+	double val[4][IONMAPCELL][IONBATCHBLOCK];	// The neighbour's grid cell
+	double ned[IONMAPCELL][IONBATCHBLOCK];		// The interpolated grid cell
 
-	// For the gridpoint maps at an increment of 1.5 degrees in lat and long
-	int zerolat = 60;	// The max latitude is 121 
-	int zerolng = 120;	// The max longitude is 241
 	double inc;			// Increment for the gridpoint maps (1.5 * pi) / 180 = 0.0261799388
 	double fracj, frack;// Fractional "column" j and fractional "row" k
+	double x, y;		// Latitude and longitude in increments
+
+	int j0, j1;			// Left and right longitude indices
+	int k0, k1;			// Lower and upper latitude indices
+	int north, east;	// The quadrant
+	int b;				// Start of the block
+	int nb;				// Number of control points in the block
+	int i, q, k;
 
 	// This routine is dependent on the 1.5 degree increment
 	inc = 1.5*D2R;
 
-	lng = 241;	// 241 Longitudes at 1.5 degree increments
-	lat = 121;	// 121 lngitudes at 1.5 degree increments
-	 
-	/*
-	 * Find the neighborhood around the point of interest
-	 * The neighbors are determined differently for each quadrant so that the neighbors are in the correct order relative to the 
-	 * array indices. This is done to simplify the interpolation code. There are no quadrants in the foF2 and M3kF2 data array. In the 
-	 * foF2 and M3kF2 array the 0,0 point is the southwest corner and the indicies increase north and east. 
-	 * First determine the quadrant
-	 */
-	if( here->L.lat >= 0.0 ) {
-		if (here->L.lng >= 0.0) { // NE quad
-			LL.k = zerolat+(int)(here->L.lat / inc); // North is positive
-			LL.j = zerolng+(int)(here->L.lng / inc); // East is positive
-			LR.k = LL.k;
-			LR.j = LL.j+1;
-			UR.k = LL.k+1;
-			UR.j = LL.j+1;
-			UL.k = LL.k+1;
-			UL.j = LL.j;
-			// Check the rollover conditions - corners and edges
-			if ( LL.j != lng-1 ) { // not on E edge
-				if ( LL.k != lat-1 ) { // not on N edge
-					// don't do anything
-				}
-				else { // N edge
-					// fix the N rollover - no rollover N to S
-					UR.k = LL.k;
-					UL.k = LL.k;
-				}
-            }
-			else { // E edge
-				if ( LL.k != lat-1 ) { // not on N edge
-					// fix the E rollover - rollover E to W
-					LR.j = 0;
-					UR.j = 0;
-				}
-				else { // NE corner
-					// Collapse to 1D
-					LR.k = LL.k;
-					LR.j = 0;
-					UR.k = LL.k;
-					UR.j = 0;
-					UL.k = LL.k;
-					UL.j = LL.j;
-				}
-            }
-        }
-		else {	// NW quad
-			LR.k = zerolat+(int)(here->L.lat / inc); // North is positive
-			LR.j = zerolng+(int)(here->L.lng / inc); // West is negative	
-			LL.k = LR.k;
-			LL.j = LR.j-1;
-			UL.k = LR.k+1;
-			UL.j = LR.j-1;
-			UR.k = LR.k+1;
-			UR.j = LR.j;
-			// Check the rollover conditions - corners and edges
-			if ( LR.j != 0.0 ) { // not on W edge
-				if ( LR.k != lat-1 ) { // not on N edge
-					// don't do anything
-				}
-				else { // N edge
-					// fix the N rollover - no rollover N to S
-					UR.k = LR.k;
-					UL.k = LR.k;
-				}
-            }
-			else { // W edge
-				if ( LR.k != lat-1 ) { // not on N edge
-					// fix the W rollover - rollover W to E
-					LL.j = lng-1;
-					UL.j = lng-1;
-				}
-				else { // NW corner
-					// Collapse to 1D
-					LL.k = LR.k;
-					LL.j = lng-1;
-					UR.k = LR.k;
-					UR.j = LR.j;
-					UL.k = LR.k;
-					UL.j = lng-1;
-				}
-            }
-        }
-    }
-	else { 
-		if (here->L.lng >= 0.0) { // SE quad
-			UL.k = zerolat+(int)(here->L.lat / inc); // South is negative
-			UL.j = zerolng+(int)(here->L.lng / inc); // East is positive
-			UR.k = UL.k;
-			UR.j = UL.j+1;
-			LL.k = UL.k-1;
-			LL.j = UL.j;
-			LR.k = UL.k-1;
-			LR.j = UL.j+1;
-			// Check the rollover conditions - corners and edges
-			if ( UL.j != lng-1 ) { // not on E edge
-				if ( UL.k != 0 ) { // not on SE corner
-					// don't do anything
-				}
-				else { // S edge
-					// fix the S rollover - no rollover S to N
-					LL.k = UL.k;
-					LR.k = UL.k;
-				}
-            }
-			else { // E edge
-				if ( UL.k != 0 ) { // not on SE corner
-					// fix the E rollover - rollover E to W
-					LR.j = 0;
-					UR.j = 0;
-				}
-				else { // SE corner
-					// Collapse to 1D
-					LR.k = UL.k;
-					LR.j = 0;
-					UR.k = UL.k;
-					UR.j = 0;
-					LL.k = UL.k;
-					LL.j = UL.j;
-				}
-            }
-        }
-		else { // SW quad
-			UR.k = zerolat+(int)(here->L.lat / inc); // South is negative
-			UR.j = zerolng+(int)(here->L.lng / inc); // West is negative
-			UL.k = UR.k;
-			UL.j = UR.j-1;
-			LL.k = UR.k-1;
-			LL.j = UR.j-1;
-			LR.k = UR.k-1;
-			LR.j = UR.j;
-			// Check the rollover conditions - corners and edges
-			if ( UR.j != 0.0 ) { // not on W edge
-				if ( UR.k != 0 ) { // not on SW corner
-					// don't do anything
-				}
-				else { // S edge
-					// fix the N rollover - no rollover N to S
-					LR.k = UR.k;
-					LL.k = UR.k;
-				}
-            }
-			else { // W edge
-				if ( UR.k != 0 ) { // not on SW corner
-					// fix the W rollover - rollover W to E
-					LL.j = lng-1;
-					UL.j = lng-1;
-				}
-				else { // SW corner
-					// Collapse to 1D
-					LR.k = UR.k;
-					LR.j = UR.j;
-					LL.k = UR.k;
-					LL.j = lng-1;
-					UL.k = UR.k;
-					UL.j = lng-1;
-				}
-            }
-        }
-    }
-
-    // Determine the lat and lng in degrees
-	UL.L.lat = UL.k*inc - PI/2.0;
-	UL.L.lng = UL.j*inc - PI;
-	LL.L.lat = LL.k*inc - PI/2.0;
-	LL.L.lng = LL.j*inc - PI;
-	UR.L.lat = UR.k*inc - PI/2.0;
-	UR.L.lng = UR.j*inc - PI;
-	LR.L.lat = LR.k*inc - PI/2.0;
-	LR.L.lng = LR.j*inc - PI;
+	map = IONMAPCELLPTR(ionmap, hour, 0, 0);
 
 	/*
-	 * At this point you have the neighborhood around the point now you can populate the foF2 and
-	 * M3kF2 for each of the adjacent points
+	 * Note the SSN maximum has been restricted to a maximm of 160 ITU-R P.533-12.
 	 */
-	n = hour;
-
-	for(m=0; m<2; m++) { // SSN
-		// Upper Left
-		UL.foF2[m] = foF2[n][UL.j][UL.k][m];
-		UL.M3kF2[m] = M3kF2[n][UL.j][UL.k][m];
-		// Upper Right
-		UR.foF2[m] = foF2[n][UR.j][UR.k][m];
-		UR.M3kF2[m] = M3kF2[n][UR.j][UR.k][m];
-		// Lower Left
-		LL.foF2[m] = foF2[n][LL.j][LL.k][m];
-		LL.M3kF2[m] = M3kF2[n][LL.j][LL.k][m];
-		// Lower Right
-		LR.foF2[m] = foF2[n][LR.j][LR.k][m];
-		LR.M3kF2[m] = M3kF2[n][LR.j][LR.k][m];
-	}
+	SSN = min(SSN, MAXSSN);
 
-    // Now you are ready to interpolate the value at the point of interest
-	// determine the fractional "column" j and fractional "row" k for the bilinear interpolation calculation
-	frack =  fabs(here->L.lat/inc) - (int)fabs(here->L.lat/inc); // Fractional row distance
-	fracj =  fabs(here->L.lng/inc) - (int)fabs(here->L.lng/inc); // Fractional column distance
-	for(m=0; m<2; m++) {
-		ned.foF2[m] = BilinearInterpolation(LL.foF2[m], LR.foF2[m], UL.foF2[m], UR.foF2[m], frack, fracj);
-		ned.M3kF2[m] = BilinearInterpolation(LL.M3kF2[m], LR.M3kF2[m], UL.M3kF2[m], UR.M3kF2[m], frack, fracj);
-	}
+	for(b=0; b<n; b+=IONBATCHBLOCK) {
+		nb = ((n - b) < IONBATCHBLOCK) ? (n - b) : IONBATCHBLOCK;
+
+		/*
+		 * Find the neighborhood around the point of interest
+		 * In the foF2 and M3kF2 maps the 0,0 point is the southwest corner and the indicies increase north and east. The
+		 * index of the grid line towards the equator or the prime meridian from the point is found by truncation. In the
+		 * north (east) the other neighbour is the next one up (right), which stops (rolls over to the W edge) at the N
+		 * (E) edge. In the south (west) the other neighbour is the next one down (left), which stops (rolls over to the E
+		 * edge) at the S (W) edge. The fractional "row" and "column" are measured from the grid line towards the equator
+		 * or the prime meridian.
+		 */
+		for(k=0; k<nb; k++) {
+			x = here[b+k]->L.lat/inc;
+			y = here[b+k]->L.lng/inc;
+			north = (here[b+k]->L.lat >= 0.0);
+			east = (here[b+k]->L.lng >= 0.0);
+
+			k0 = IONZEROLAT + (int)x;
+			k1 = k0;
+			j0 = IONZEROLNG + (int)y;
+			j1 = j0;
+			k0 = north ? k0 : k0 - 1;
+			k1 = north ? k1 + 1 : k1;
+			j0 = east ? j0 : j0 - 1;
+			j1 = east ? j1 + 1 : j1;
+			// No rollover N to S
+			k0 = (k0 < 0) ? 0 : k0;
+			k1 = (k1 > IONMAPLATS-1) ? IONMAPLATS-1 : k1;
+			// Rollover E to W
+			j0 = (j0 < 0) ? IONMAPLNGS-1 : j0;
+			j1 = (j1 > IONMAPLNGS-1) ? 0 : j1;
+
+			nbr[0][k] = (j0*IONMAPLATS + k0)*IONMAPCELL;
+			nbr[1][k] = (j1*IONMAPLATS + k0)*IONMAPCELL;
+			nbr[2][k] = (j0*IONMAPLATS + k1)*IONMAPCELL;
+			nbr[3][k] = (j1*IONMAPLATS + k1)*IONMAPCELL;
+
+			// Determine the fractional "column" j and fractional "row" k for the bilinear interpolation calculation
+			frack =  fabs(x) - (int)fabs(x); // Fractional row distance
+			fracj =  fabs(y) - (int)fabs(y); // Fractional column distance
+
+			// The weights as in BilinearInterpolation()
+			w[0][k] = (1.0 - frack)*(1.0 - fracj);
+			w[1][k] = (1.0 - frack)*(fracj);
+			w[2][k] = (frack)*(1.0 - fracj);
+			w[3][k] = (frack)*(fracj);
+		}
 
-    // End of calculation for foF2 and M3kF2
+		// Each grid cell holds both SSNs of foF2 and M(3000)F2
+		for(q=0; q<4; q++) {
+			for(k=0; k<nb; k++) {
+				cell = map + nbr[q][k];
+				for(i=0; i<IONMAPCELL; i++) {
+					val[q][i][k] = cell[i];
+				}
+			}
+		}
 
-	/*
-	 * Now interpolate by the SSN. Note the SSN maximum has been restricted to a maximm of 160 ITU-R P.533-12.
-	 * "For most purposes it is adequate to assume a linear relationship with R12 for both foF2 and M(3000)F2." 
-	 * ITU-R P.1239-2 (10-2009)
-	 * Note the index on foF2 and M3kF2 in the neighbor structure is for the SSN = 0 (index = 0) and SSN = 100 (index = 1)
-	 */
-	SSN = min(SSN, MAXSSN);
-	here->foF2 = (ned.foF2[1]*SSN + ned.foF2[0]*(100.0 - SSN))/100.0;
-	here->M3kF2 = (ned.M3kF2[1]*SSN + ned.M3kF2[0]*(100.0 - SSN))/100.0;
+		// Now you are ready to interpolate the value at the point of interest
+		// The terms are summed in the order of BilinearInterpolation()
+		for(i=0; i<IONMAPCELL; i++) {
+			for(k=0; k<nb; k++) {
+				ned[i][k] = val[0][i][k]*w[0][k] +
+							val[2][i][k]*w[2][k] +
+							val[1][i][k]*w[1][k] +
+							val[3][i][k]*w[3][k];
+			}
+		}
+
+		/*
+		 * Now interpolate by the SSN.
+		 * "For most purposes it is adequate to assume a linear relationship with R12 for both foF2 and M(3000)F2." 
+		 * ITU-R P.1239-2 (10-2009)
+		 * Note the grid cell holds each parameter for the SSN = 0 (offset 0) and SSN = 100 (offset 1)
+		 */
+		for(k=0; k<nb; k++) {
+			here[b+k]->foF2 = (ned[IONMAPFOF2+1][k]*SSN + ned[IONMAPFOF2][k]*(100.0 - SSN))/100.0;
+			here[b+k]->M3kF2 = (ned[IONMAPM3KF2+1][k]*SSN + ned[IONMAPM3KF2][k]*(100.0 - SSN))/100.0;
+		}
+	}
 
 	// End of calculation for foF2 and M3kF2
 
@@ -530,6 +505,36 @@ void SolarParameters(struct ControlPt *here, int month, double hour) {
 	 			here->Sun.lsn - local solar noon (hours)
 	 			here->Sun.lss - local sunset (hours)
 
+			SUBROUTINES
+				SolarTime()
+				SolarPosition()
+
+	 */
+
+	SolarTime(&here->Sun, month, hour);
+
+	SolarPosition(here, hour);
+
+	return;
+
+}
+
+void SolarTime(struct SolarParameters *Sun, int month, double hour) {
+
+	/*
+	 
+	 	SolarTime() - The part of SolarParameters() that doesn't depend on the location: the solar declination and the 
+	 		equation of time for the given time and month.
+	 
+	 		INPUT
+	 			struct SolarParameters *Sun
+	 			int month - Month index
+	 			double hour - Decimal hours
+	  
+	 		OUTPUT
+	  			Sun->decl - Solar declination (radians)
+	  			Sun->eot- Equation of time (minutes)
+
 			SUBROUTINES
 				None
 
@@ -541,11 +546,6 @@ void SolarParameters(struct ControlPt *here, int month, double hour) {
 	 
 	 */
 
-	double cosphi;	// cosine of the solar zenith angle
-	double tst;		// True solar time
-	double toffset;
-	double ltime;	// Local time 
-	double tzone;	// Time zone
 	double lambda;
 	double epsilon;	
 	double nu;
@@ -562,10 +562,6 @@ void SolarParameters(struct ControlPt *here, int month, double hour) {
 	// The day of the year (doty) array allows us to determine the day count of the day of interest
 	int doty[12] = { 0, 31, 59, 90, 120, 152, 181, 212, 243, 273, 304, 334 }; 
 
-	// Determine the local time, hours, minutes, seconds and time zone
-	ltime = hour + (int)(here->L.lng/(15.0*D2R)); // Local time 
-	tzone = (int)(here->L.lng/(15.0*D2R)); // hours
-	
 	// At present this code only works for the 15th day of the month
 	// If this changes a day field should be added to the path structure
 	// and passed into this routine
@@ -602,10 +598,48 @@ void SolarParameters(struct ControlPt *here, int month, double hour) {
 	// Equation of Time = tilt effect + eclliptic effect
 	// Where 0.398892 is the minutes per degree of Earth's rotation 
 	// 1440 minutes per day /361 degrees per day 
-	here->Sun.eot = B*((epsilon - beta) + (lambda - nu))*R2D;
+	Sun->eot = B*((epsilon - beta) + (lambda - nu))*R2D;
 
 	// Solar declination in radians
-	here->Sun.decl =  asin(S*sin((sin(A*(D-2)*D2R)*0.016713 + A*(D-2)*D2R) - V));
+	Sun->decl =  asin(S*sin((sin(A*(D-2)*D2R)*0.016713 + A*(D-2)*D2R) - V));
+
+	return;
+
+}
+
+void SolarPosition(struct ControlPt *here, double hour) {
+
+	/*
+	 
+	 	SolarPosition() - The part of SolarParameters() that depends on the location. here->Sun.decl and here->Sun.eot
+	 		must have been found by SolarTime() for the same time and month.
+	 
+	 		INPUT
+	 			struct ControlPt *here - The control point of interest
+	 			double hour - Decimal hours
+	  
+	 		OUTPUT
+	 			here->Sun.ha - Hour angle (radians)
+	 			here->Sun.sha -  Sunrise/Sunset hour angle (radians)
+	 			here->Sun.sza - Solar zenith angle (radians)
+	 			here->Sun.lsr - local sunrise (hours)
+	 			here->Sun.lsn - local solar noon (hours)
+	 			here->Sun.lss - local sunset (hours)
+
+			SUBROUTINES
+				None
+	 
+	 */
+
+	double cosphi;	// cosine of the solar zenith angle
+	double tst;		// True solar time
+	double toffset;
+	double ltime;	// Local time 
+	double tzone;	// Time zone
+
+	// Determine the local time, hours, minutes, seconds and time zone
+	ltime = hour + (int)(here->L.lng/(15.0*D2R)); // Local time 
+	tzone = (int)(here->L.lng/(15.0*D2R)); // hours
 	
 	// Find the hour angle which can be found from the solar time corrected for the local longitude and the eot
 	toffset = (((here->L.lng/(15.0*D2R)) - tzone)*60.0 + here->Sun.eot); // minutes
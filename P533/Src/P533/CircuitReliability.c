@@ -10,11 +10,11 @@
 
 // Local prototypes
 void ModeSort(struct Mode *M[MAXMDS], int order[MAXMDS], int criteria);
-int NumberofModes(struct PathData path);
+int NumberofModes(struct PathData const *path);
 double DigitalModulationSignalandInterferers(struct PathData *path, int iS[MAXMDS], int iI[MAXMDS]);
 void EquatorialScattering(struct PathData *path, int iS[MAXMDS]);
-double FindFlambdad(struct ControlPt CP);
-double FindFTl(struct ControlPt CP);
+double FindFlambdad(struct ControlPt const *CP);
+double FindFTl(struct ControlPt const *CP);
 // End local prototypes
 
 // Local defines
@@ -163,7 +163,7 @@ void CircuitReliability(struct PathData *path) {
 	}
 
     // Calculate the SNR
-	path->SNR = S - 10.0*log10(pow(10.0, (noiseP.FaA/10.0)) + pow(10.0, (noiseP.FaM/10.0)) + pow(10.0, (noiseP.FaG/10.0)))
+	path->SNR = S - RATIO2DB(DB2RATIO(noiseP.FaA) + DB2RATIO(noiseP.FaM) + DB2RATIO(noiseP.FaG))
 		          - 10.0*log10(path->BW) + 204;
 
 	// Step 4 & 7: "Signal upper decile deviation (day-to-day) (dB)" & "Signal lower decile deviation (day-to-day) (dB)"		
@@ -232,16 +232,16 @@ void CircuitReliability(struct PathData *path) {
 
 
 	// Step 6: "Upper decile deviation of resultant signal-to-noise ratio (dB)"
-	x = pow(10.0, (noiseP.FaA/10.0)) + pow(10.0, (noiseP.FaM/10.0)) + pow(10.0, (noiseP.FaG/10.0));
-	y = pow(10.0, ((noiseP.FaA-noiseP.DlA)/10.0)) + pow(10.0, ((noiseP.FaM- noiseP.DlM)/10.0)) + pow(10.0, ((noiseP.FaG- noiseP.DlG)/10.0));
+	x = DB2RATIO(noiseP.FaA) + DB2RATIO(noiseP.FaM) + DB2RATIO(noiseP.FaG);
+	y = DB2RATIO(noiseP.FaA - noiseP.DlA) + DB2RATIO(noiseP.FaM - noiseP.DlM) + DB2RATIO(noiseP.FaG - noiseP.DlG);
 
-	path->DuSN = sqrt(pow(10.0*log10(x/y),2) + pow(DuSd,2) + pow(DuSh,2));
+	path->DuSN = sqrt(pow(RATIO2DB(x/y),2) + pow(DuSd,2) + pow(DuSh,2));
 
 	// Step 9: "Upper decile deviation of resultant signal-to-noise ratio (dB)"
 	// The value in variable x can be reused from Step 6 above.
-	y = pow(10.0, ((noiseP.FaA+ noiseP.DuA)/10.0)) + pow(10.0, ((noiseP.FaM+ noiseP.DuM)/10.0)) + pow(10.0, ((noiseP.FaG+ noiseP.DuG)/10.0));
+	y = DB2RATIO(noiseP.FaA + noiseP.DuA) + DB2RATIO(noiseP.FaM + noiseP.DuM) + DB2RATIO(noiseP.FaG + noiseP.DuG);
 
-	path->DlSN = sqrt(pow(10.0*log10(y/x),2) + pow(DlSd,2) + pow(DlSh,2));
+	path->DlSN = sqrt(pow(RATIO2DB(y/x),2) + pow(DlSd,2) + pow(DlSh,2));
 
 	// Step 11: "Basic circuit reliability for S/N >= or < S/Nr (%)"
 	if(path->SNR >= path->SNRr) {
@@ -350,14 +350,14 @@ void CircuitReliability(struct PathData *path) {
 		for(n=0; n<MAXMDS; n++) {
 			if(iI[n] != NOTINDEX) {  //
 				if(iI[n] < MAXEMDS) { // E mode interference
-					Isum += pow(10.0, ((path->Md_E[iI[n]].Prw - path->A)/10.0));
-					Isumu += pow(10.0, ((path->Md_E[iI[n]].Prw - path->A + DuIh)/10.0));
-					Isuml += pow(10.0, ((path->Md_E[iI[n]].Prw - path->A - DlIh)/10.0));
+					Isum += DB2RATIO(path->Md_E[iI[n]].Prw - path->A);
+					Isumu += DB2RATIO(path->Md_E[iI[n]].Prw - path->A + DuIh);
+					Isuml += DB2RATIO(path->Md_E[iI[n]].Prw - path->A - DlIh);
 				}
 				else { // F2 mode interference 
-					Isum += pow(10.0, ((path->Md_F2[iI[n]-3].Prw - path->A)/10.0));
-					Isumu += pow(10.0, ((path->Md_F2[iI[n]-3].Prw - path->A + DuIh)/10.0));
-					Isuml += pow(10.0, ((path->Md_F2[iI[n]-3].Prw - path->A - DlIh)/10.0));
+					Isum += DB2RATIO(path->Md_F2[iI[n]-3].Prw - path->A);
+					Isumu += DB2RATIO(path->Md_F2[iI[n]-3].Prw - path->A + DuIh);
+					Isuml += DB2RATIO(path->Md_F2[iI[n]-3].Prw - path->A - DlIh);
 				}
             }
         }
@@ -374,13 +374,13 @@ void CircuitReliability(struct PathData *path) {
 		}
 
         // Step 4: Determine the signal-to-interference ratio
-		path->SIR = S - 10.0*log10(Isum);
+		path->SIR = S - RATIO2DB(Isum);
 
 		// Step 7: Determine the upper decile deviation of the signal-to-interference ratio
-		path->DuSI = sqrt(pow(DuSh,2) + pow(10.0*log10(Isum/Isuml),2));
+		path->DuSI = sqrt(pow(DuSh,2) + pow(RATIO2DB(Isum/Isuml),2));
 
 		// Step 10: Determine the lower decile deviation of the signal-to-interference ratio
-		path->DlSI = sqrt(pow(DlSh,2) + pow(10.0*log10(Isumu/Isum), 2));
+		path->DlSI = sqrt(pow(DlSh,2) + pow(RATIO2DB(Isumu/Isum), 2));
 
 		// Step 12: Circuit reliability in the presence of interference only for S/I >= or < S/Ir
 		if(path->SIR >= path->SIRr) {
@@ -488,14 +488,14 @@ void ModeSort(struct Mode *M[MAXMDS], int order[MAXMDS], int criteria) {
 
 } // End ModeSort()
 
-int NumberofModes(struct PathData path) {
+int NumberofModes(struct PathData const *path) {
 
 	/*
 	 
 	  NumberofModes() - Counts the number of modes in the path structure
 	 
 	 		INPUT
-	 			struct PathData path
+	 			struct PathData const *path
 	 
 	 		OUTPUT
 	 			returns the number of modes that exist
@@ -510,13 +510,13 @@ int NumberofModes(struct PathData path) {
 	count = 0;
 	for(n=0; n<MAXEMDS; n++) {
 		// Only count the modes that exist
-		if(path.Md_E[n].BMUF != 0.0) {
+		if(path->Md_E[n].BMUF != 0.0) {
 			count += 1;
 		}
     }
     for(n=0; n<MAXF2MDS; n++) {
 		// Only cound the modes that exist
-		if(path.Md_F2[n].BMUF != 0.0) {
+		if(path->Md_F2[n].BMUF != 0.0) {
 			count += 1;
 		}
     }
@@ -606,7 +606,7 @@ double DigitalModulationSignalandInterferers(struct PathData *path, int iS[MAXMD
         }
 
         // Do the following if there are 2 or more modes 
-		if(NumberofModes(*path) >= 2) {
+		if(NumberofModes(path) >= 2) {
 			// For this calculation the layers don't matter so set up an array of all the modes
 			// so that a single loop can be used
 			// Point the M[] array at all of the modes in path
@@ -648,7 +648,7 @@ double DigitalModulationSignalandInterferers(struct PathData *path, int iS[MAXMD
 				if(M[n]->BMUF != 0.0) { 
 					if((M[n]->Prw >= deltaA) && (M[n]->tau <= deltat)) {
 
-						Ssum += pow(pow(10.0, M[n]->Ew/10.0), 2);
+						Ssum += pow(DB2RATIO(M[n]->Ew), 2);
 						iS[n] = n;
 					}
 					else { // If the mode is not determined to be a signal then it is interference.
@@ -662,7 +662,7 @@ double DigitalModulationSignalandInterferers(struct PathData *path, int iS[MAXMD
             // Only determine Etw if there is a mode that satisfies the criteria above 
 			// otherwise Etw is set to the something small
 			if(Ssum > 0) {
-				Etw = 10.0*log10(sqrt(Ssum));
+				Etw = RATIO2DB(sqrt(Ssum));
 			}
 			else {
 				Etw = TINYDB;
@@ -672,7 +672,7 @@ double DigitalModulationSignalandInterferers(struct PathData *path, int iS[MAXMD
 			S = Etw + path->Grw - 20.0*log10(path->frequency) - 107.2;
 
 		}
-		else { // (NumberofModes(*path) < 2) 
+		else { // (NumberofModes(path) < 2) 
 			// There is only one mode. 
 			S = path->Pr;
 		}
@@ -823,17 +823,17 @@ void EquatorialScattering(struct PathData *path, int iS[MAXMDS]) {
 				if((iS[n] != NOTINDEX) && (iS[n] >= MAXEMDS)) { // Does the mode exist and is it an F2 layer mode?
 					if(iS[n] == path->n0_F2) { // Lowest order F2 mode
 						if(path->distance <= path->dmax) {
-							Flambdad = FindFlambdad(path->CP[MP]);
-							FTl = FindFTl(path->CP[MP]);							
+							Flambdad = FindFlambdad(&path->CP[MP]);
+							FTl = FindFTl(&path->CP[MP]);							
 						}
 						else {
 							if(PTspread[Td02] >= PTspread[Rd02]) {
-								Flambdad = FindFlambdad(path->CP[Td02]);
-								FTl = FindFTl(path->CP[Td02]);
+								Flambdad = FindFlambdad(&path->CP[Td02]);
+								FTl = FindFTl(&path->CP[Td02]);
 							}
 							else {
-								Flambdad = FindFlambdad(path->CP[Rd02]);
-								FTl = FindFTl(path->CP[Rd02]);
+								Flambdad = FindFlambdad(&path->CP[Rd02]);
+								FTl = FindFTl(&path->CP[Rd02]);
 							}
                         }
                     }
@@ -841,14 +841,14 @@ void EquatorialScattering(struct PathData *path, int iS[MAXMDS]) {
 						if(path->distance <= path->dmax) { 
 							// Find the largest time scattering by brute force
 							if((PTspread[T1k] >= PTspread[R1k]) && (PTspread[T1k] >= PTspread[MP])) {
-								Flambdad = FindFlambdad(path->CP[T1k]);
-								FTl = FindFTl(path->CP[T1k]);
+								Flambdad = FindFlambdad(&path->CP[T1k]);
+								FTl = FindFTl(&path->CP[T1k]);
 							} else if ((PTspread[R1k] >= PTspread[T1k]) && (PTspread[R1k] >= PTspread[MP])) {
-								Flambdad = FindFlambdad(path->CP[R1k]);
-								FTl = FindFTl(path->CP[R1k]);
+								Flambdad = FindFlambdad(&path->CP[R1k]);
+								FTl = FindFTl(&path->CP[R1k]);
 							} else if ((PTspread[MP] >= PTspread[R1k]) && (PTspread[MP] >= PTspread[T1k])) {
-								Flambdad = FindFlambdad(path->CP[MP]);
-								FTl = FindFTl(path->CP[MP]);
+								Flambdad = FindFlambdad(&path->CP[MP]);
+								FTl = FindFTl(&path->CP[MP]);
 							}
                         }
 						else {
@@ -856,36 +856,36 @@ void EquatorialScattering(struct PathData *path, int iS[MAXMDS]) {
 							   (PTspread[T1k] >= PTspread[Td02]) &&
 							   (PTspread[T1k] >= PTspread[MP]) &&
 							   (PTspread[T1k] >= PTspread[Rd02])) {
-								Flambdad = FindFlambdad(path->CP[T1k]);
-								FTl = FindFTl(path->CP[T1k]);
+								Flambdad = FindFlambdad(&path->CP[T1k]);
+								FTl = FindFTl(&path->CP[T1k]);
 							} 
 							else if ((PTspread[R1k] >= PTspread[T1k]) && 
 								     (PTspread[R1k] >= PTspread[MP]) &&
 									 (PTspread[R1k] >= PTspread[Td02]) &&
 									 (PTspread[R1k] >= PTspread[Rd02])) {
-								Flambdad = FindFlambdad(path->CP[R1k]);
-								FTl = FindFTl(path->CP[R1k]);
+								Flambdad = FindFlambdad(&path->CP[R1k]);
+								FTl = FindFTl(&path->CP[R1k]);
 							} 
 							else if ((PTspread[MP] >= PTspread[R1k]) && 
 								     (PTspread[MP] >= PTspread[T1k]) &&
 									 (PTspread[MP] >= PTspread[Td02]) &&
 									 (PTspread[MP] >= PTspread[Rd02]))	{
-								Flambdad = FindFlambdad(path->CP[MP]);
-								FTl = FindFTl(path->CP[MP]);
+								Flambdad = FindFlambdad(&path->CP[MP]);
+								FTl = FindFTl(&path->CP[MP]);
 							} 
 							else if((PTspread[Td02] >= PTspread[Rd02]) && 
 								    (PTspread[Td02] >= PTspread[MP]) &&
 									(PTspread[Td02] >= PTspread[T1k]) &&
 									(PTspread[Td02] >= PTspread[R1k]))	{
-								Flambdad = FindFlambdad(path->CP[Td02]);
-								FTl = FindFTl(path->CP[Td02]);
+								Flambdad = FindFlambdad(&path->CP[Td02]);
+								FTl = FindFTl(&path->CP[Td02]);
 							} 
 							else if ((PTspread[Rd02] >= PTspread[T1k]) && 
 								     (PTspread[Rd02] >= PTspread[MP]) &&
 									 (PTspread[Rd02] >= PTspread[R1k]) &&
 									 (PTspread[Rd02] >= PTspread[Td02])) {
-								Flambdad = FindFlambdad(path->CP[Rd02]);
-								FTl = FindFTl(path->CP[Rd02]);							
+								Flambdad = FindFlambdad(&path->CP[Rd02]);
+								FTl = FindFTl(&path->CP[Rd02]);							
 							}
                         }
                     } // Higher order F2 modes
@@ -919,7 +919,7 @@ void EquatorialScattering(struct PathData *path, int iS[MAXMDS]) {
 
 }
 
-double FindFlambdad(struct ControlPt CP) {
+double FindFlambdad(struct ControlPt const *CP) {
 
 	/*
 	 
@@ -940,7 +940,7 @@ double FindFlambdad(struct ControlPt CP) {
 	double lambdad;
 
 	// Magnetic dip parameter 
-	lambdad = fabs(CP.dip[HR100km]);
+	lambdad = fabs(CP->dip[HR100km]);
 	if((0.0 <= lambdad) && (lambdad < 15.0*D2R)) {
 		return 1.0;
 	}
@@ -955,7 +955,7 @@ double FindFlambdad(struct ControlPt CP) {
 
 }
 
-double FindFTl(struct ControlPt CP) {
+double FindFTl(struct ControlPt const *CP) {
 
 	/*
 	 
@@ -977,7 +977,7 @@ double FindFTl(struct ControlPt CP) {
 	double Tl;
 
 	// Time parameter
-	Tl = CP.ltime;
+	Tl = CP->ltime;
 	if((0.0 < Tl) && (Tl <= 3.0)) {
 		return 1.0;
 	}
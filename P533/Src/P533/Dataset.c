@@ -0,0 +1,619 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+// Local defines
+// Limits used by LoadDatasetCache() to check the ionospheric maps. They are only meant to catch a damaged or foreign file.
+#define FOF2MAX			50.0	// foF2 (MHz)
+#define M3KF2MAX		10.0	// M(3000)F2
+// End local defines
+
+// Local prototypes
+void ZeroAntenna(struct Antenna *ant);
+float ****IonMapView(float *ionmap, int offset);
+void FreeIonMapView(float ****view);
+int ValidIonMap(float const *ionmap);
+// End local prototypes
+
+DLLEXPORT int AllocateDataset(struct Dataset *ds) {
+
+	/*
+
+	  AllocateDataset() - Allocates the read-only data that P533() uses for a month. The data must be read into these arrays elsewhere.
+			Any number of PathData structures can share one dataset with AttachDataset(). P533() does not write to the dataset, so
+			paths that share a dataset can be calculated concurrently.
+
+			The P372 routines are bound here by BindP372(). This must be done before P533() is called from more than one thread.
+
+	 		INPUT
+	 			struct Dataset *ds
+
+	 		OUTPUT
+	 			ds->ionmap
+	 			ds->foF2
+	 			ds->M3kF2
+	 			ds->foF2var
+	 			ds->fakp
+	 			ds->fakabp
+	 			ds->fam
+	 			ds->dud
+				ds->A_tx
+				ds->A_rx
+
+	 		SUBROUTINES
+	 			BindP372()
+				dllAllocateNoiseMemory()
+				ZeroAntenna()
+				AllocateIonMap()
+				IonMapView()
+
+	 */
+
+	float *ionmap;			// foF2 and M(3000)F2 ionospheric maps
+	float ****foF2;			// foF2 view of ionmap
+	float ****M3kF2;		// M(3000)F2 view of ionmap
+	double (*foF2var)[FOF2VARHRS][FOF2VARLATS][FOF2VARSSNS][FOF2VARDECILES];	// foF2 statistics
+
+	struct NoiseParams noiseP; // Temporary noise structure for the P372 allocation
+
+	int retval;
+
+	/*
+	 * Allocate the ionospheric maps that will be used by the P533 engine.
+	 * Both maps are in one aligned block (See IONMAPCELLPTR() in P533.h). The arrays foF2 and M3kF2 are
+	 * [hour][longitude][latitude][SSN] views into the block for the routines that read the maps.
+	 */
+	ionmap = AllocateIonMap();
+	if(ionmap == NULL) return RTN_ERRALLOCATEFOF2;
+
+	foF2 = IonMapView(ionmap, IONMAPFOF2);
+	M3kF2 = IonMapView(ionmap, IONMAPM3KF2);
+	ds->ionmap = ionmap;
+
+    /*
+     * Allocate the foF2 variablity array that will be used by the P533 engine.
+	 * The array is one block of FOF2VARSIZE doubles [season][hour][latitude][SSN][decile] (See P533.h)
+	 *		3 seasons		1) WINTER 2) EQUINOX 3) SUMMER
+	 *		24 hours
+	 *		19 latitudes	0, 5, 10, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 65, 70, 75, 80, 85, 90
+	 *		3 SSN ranges	1) R12 < 50 2) 50 <= R12 <= 100 3) R12 > 100
+	 *		2 deciles		1) lower 2) upper
+     */
+	foF2var = malloc(FOF2VARSIZE * sizeof(double));
+
+	/*
+	 * The TX and RX antenna arrays are allocated when parsing the
+	 * input files (e.g. ReadType13) as the array size varies with the antenna
+	 * type and the number of frequencies for which pattern data is available.
+	 *
+	 * The arrays are free'd in FreeDataset.
+	 */
+	ZeroAntenna(&ds->A_tx);
+	ZeroAntenna(&ds->A_rx);
+
+	// Check for NULLs and save the pointers to the dataset.
+	if(foF2 != NULL) ds->foF2 = foF2;
+	else return RTN_ERRALLOCATEFOF2;
+
+	if(M3kF2 != NULL) ds->M3kF2 = M3kF2;
+	else return RTN_ERRALLOCATEM3KF2;
+
+	if(foF2var != NULL) ds->foF2var = foF2var;
+	else return RTN_ERRALLOCATEFOF2VAR;
+
+	// P372.dll **********************************************************
+
+	// Bind the Noise routines in P372.dll *****************************
+	retval = BindP372();
+	if (retval != RTN_P372BOUNDOK) return retval;
+	// End P372.DLL Bind ************************************************
+
+	// Allocate the memory for the noise coefficients
+	retval = dllAllocateNoiseMemory(&noiseP);
+	if (retval != RTN_ALLOCATEP372OK) {
+		return RTN_ERRALLOCATENOISE;
+	}
+	ds->fakp = noiseP.fakp;
+	ds->fakabp = noiseP.fakabp;
+	ds->fam = noiseP.fam;
+	ds->dud = noiseP.dud;
+	// P372.dll **********************************************************
+
+	return RTN_ALLOCATEP533OK;
+
+}
+
+DLLEXPORT int FreeDataset(struct Dataset *ds) {
+
+	/*
+
+	 	FreeDataset() - Frees the memory that was dynamically (m) allocated for the structure Dataset ds.
+			No path that is attached to the dataset may be used after this.
+
+	 		INPUT
+	 			struct Dataset *ds
+
+	 		OUTPUT
+	 			returns RTN_PATHFREED or the P372 error
+
+	 		SUBROUTINES
+	 			BindP372()
+				FreeAntenna()
+				dllFreeNoiseMemory()
+				FreeIonMapView()
+				FreeIonMap()
+
+	 */
+
+	struct NoiseParams noiseP; // Temporary noise structure for the P372 free
+
+	int retval;
+
+	/*
+	 * Free the ionospheric maps and their views.
+	 */
+	FreeIonMapView(ds->foF2);
+	FreeIonMapView(ds->M3kF2);
+	FreeIonMap(ds->ionmap);
+
+	// Free the foF2 variability memory
+	free(ds->foF2var);
+
+	// Free antenna arrays
+	FreeAntenna(&ds->A_tx);
+	FreeAntenna(&ds->A_rx);
+
+	// Free the noise memory
+	retval = BindP372();
+	if (retval != RTN_P372BOUNDOK) return retval;
+	noiseP.fakp = ds->fakp;
+	noiseP.fakabp = ds->fakabp;
+	noiseP.fam = ds->fam;
+	noiseP.dud = ds->dud;
+	retval = dllFreeNoiseMemory(&noiseP);
+	if (retval != RTN_NOISEFREED) return retval; // check that the input parameters are correct
+
+	return RTN_PATHFREED;
+
+}
+
+DLLEXPORT void AttachDataset(struct PathData *path, struct Dataset const *ds) {
+
+	/*
+
+		AttachDataset() - Points the path at the read-only data in the dataset. Nothing is copied except the pointers, so any
+			number of paths can be attached to one dataset. Each path keeps its own inputs and calculated parameters.
+
+			INPUT
+				struct PathData *path
+				struct Dataset const *ds
+
+			OUTPUT
+				path->ionmap
+				path->foF2
+				path->M3kF2
+				path->foF2var
+				path->noiseP.fakp
+				path->noiseP.fakabp
+				path->noiseP.fam
+				path->noiseP.dud
+				path->noiseP.famcache
+				path->noiseP.memo
+				path->A_tx
+				path->A_rx
+
+			SUBROUTINES
+				None
+
+	*/
+
+	path->ionmap = ds->ionmap;
+	path->foF2 = ds->foF2;
+	path->M3kF2 = ds->M3kF2;
+	path->foF2var = ds->foF2var;
+
+	path->noiseP.fakp = ds->fakp;
+	path->noiseP.fakabp = ds->fakabp;
+	path->noiseP.fam = ds->fam;
+	path->noiseP.dud = ds->dud;
+	// The Fam1MHz cache and the noise memo may be for other tables
+	path->noiseP.famcache.valid = 0;
+	path->noiseP.memo.valid = 0;
+
+	path->A_tx = ds->A_tx;
+	path->A_rx = ds->A_rx;
+
+}
+
+DLLEXPORT void GetDataset(struct PathData const *path, struct Dataset *ds) {
+
+	/*
+
+		GetDataset() - Collects the read-only data pointers that a path uses into a dataset. This is the reverse of AttachDataset().
+			It lets a path that was set up with AllocatePathMemory() and the Read*() routines be shared with other paths.
+
+			INPUT
+				struct PathData const *path
+
+			OUTPUT
+				struct Dataset *ds
+
+			SUBROUTINES
+				None
+
+	*/
+
+	ds->ionmap = path->ionmap;
+	ds->foF2 = path->foF2;
+	ds->M3kF2 = path->M3kF2;
+	ds->foF2var = path->foF2var;
+
+	ds->fakp = path->noiseP.fakp;
+	ds->fakabp = path->noiseP.fakabp;
+	ds->fam = path->noiseP.fam;
+	ds->dud = path->noiseP.dud;
+
+	ds->A_tx = path->A_tx;
+	ds->A_rx = path->A_rx;
+
+}
+
+DLLEXPORT int LoadDatasetCache(struct DatasetCache *dc, char DataFilePath[256], int silent) {
+
+	/*
+
+		LoadDatasetCache() - Reads the ionospheric maps and the P372 noise coefficients for all 12 months and the foF2
+			variability for the year into the cache, and checks the maps. Each month's maps are mapped from the native
+			file ionosXX.map if there is one, otherwise they are read from ionosXX.bin. After this SelectMonth() can
+			switch a path to any month without any I/O. The cache must be freed with FreeDatasetCache() even if this fails.
+
+			INPUT
+				struct DatasetCache *dc
+				char DataFilePath[256] - Directory of the data files
+				int silent
+
+			OUTPUT
+				struct DatasetCache *dc
+				returns RTN_ALLOCATEP533OK or the error from the allocation or the read that failed
+
+			SUBROUTINES
+				AllocateDataset()
+				AttachDataset()
+				ReadP1239()
+				AllocateIonMap()
+				MapIonParameters()
+				ReadIonParametersBin()
+				dllAllocateNoiseMemory()
+				dllReadFamDud()
+				ValidIonMap()
+
+	 */
+
+	struct PathData path;		// Temporary path for the read routines that take a path
+	struct NoiseParams noiseP;	// Temporary noise structure for the P372 routines
+
+	int retval;
+	int month;
+
+	// Start from an empty cache so FreeDatasetCache() can clean up after a failure at any point
+	memset(dc, 0, sizeof(struct DatasetCache));
+
+	retval = AllocateDataset(&dc->year);
+	if(retval != RTN_ALLOCATEP533OK) return retval;
+	dc->loaded = FALSE;
+
+	// The foF2 variability is for the whole year
+	AttachDataset(&path, &dc->year);
+	retval = ReadP1239(&path, DataFilePath);
+	if(retval != RTN_READP1239OK) return retval;
+
+	for(month=JAN; month<=DEC; month++) {
+		// Ionospheric maps
+		dc->ionmap[month] = AllocateIonMap();
+		if(dc->ionmap[month] == NULL) return RTN_ERRALLOCATEFOF2;
+
+		retval = MapIonParameters(month, dc->ionmap[month], DataFilePath, silent);
+		if(retval != RTN_READIONPARAOK) {
+			retval = ReadIonParametersBin(month, dc->year.foF2, dc->year.M3kF2, DataFilePath, silent);
+			if(retval != RTN_READIONPARAOK) return retval;
+			memcpy(dc->ionmap[month], dc->year.ionmap, IONMAPSIZE*sizeof(float));
+		}
+
+		if(ValidIonMap(dc->ionmap[month]) != TRUE) {
+			printf("LoadDatasetCache: Error %d Ionospheric map for month %d is out of range\n", RTN_ERRIONMAPDATA, month+1);
+			return RTN_ERRIONMAPDATA;
+		}
+
+		// Noise coefficients
+		retval = dllAllocateNoiseMemory(&noiseP);
+		if(retval != RTN_ALLOCATEP372OK) return RTN_ERRALLOCATENOISE;
+		dc->fakp[month] = noiseP.fakp;
+		dc->fakabp[month] = noiseP.fakabp;
+		dc->fam[month] = noiseP.fam;
+		dc->dud[month] = noiseP.dud;
+
+		retval = dllReadFamDud(&noiseP, DataFilePath, month);
+		if(retval != RTN_READFAMDUDOK) return retval;
+	}
+
+	dc->loaded = TRUE;
+
+	return RTN_ALLOCATEP533OK;
+
+}
+
+DLLEXPORT int SelectMonth(struct PathData *path, struct DatasetCache const *dc, int month) {
+
+	/*
+
+		SelectMonth() - Points the path at the ionospheric maps, noise coefficients and foF2 variability in the cache for the
+			month and sets path->month. Nothing is copied. The antenna patterns of the path are not changed. The path's
+			foF2 and M3kF2 views are not changed either and still describe the maps that the path was allocated with.
+			P533() only uses path->ionmap.
+
+			Before the path is freed with FreePathMemory() it must be given back its own data with AttachDataset().
+
+			INPUT
+				struct PathData *path
+				struct DatasetCache const *dc
+				int month - 0 to 11
+
+			OUTPUT
+				path->month
+				path->ionmap
+				path->foF2var
+				path->noiseP.fakp
+				path->noiseP.fakabp
+				path->noiseP.fam
+				path->noiseP.dud
+				path->noiseP.famcache
+				path->noiseP.memo
+				returns RTN_ALLOCATEP533OK or RTN_ERRMONTH if the month is not in the cache
+
+			SUBROUTINES
+				None
+
+	*/
+
+	if((dc->loaded != TRUE) || (month < JAN) || (month > DEC)) return RTN_ERRMONTH;
+
+	path->month = month;
+
+	path->ionmap = dc->ionmap[month];
+	path->foF2var = dc->year.foF2var;
+
+	path->noiseP.fakp = dc->fakp[month];
+	path->noiseP.fakabp = dc->fakabp[month];
+	path->noiseP.fam = dc->fam[month];
+	path->noiseP.dud = dc->dud[month];
+	path->noiseP.famcache.valid = 0;
+	path->noiseP.memo.valid = 0;
+
+	return RTN_ALLOCATEP533OK;
+
+}
+
+DLLEXPORT int FreeDatasetCache(struct DatasetCache *dc) {
+
+	/*
+
+		FreeDatasetCache() - Frees everything allocated by LoadDatasetCache(), including a cache that was only partly
+			loaded. No path that has been pointed at the cache with SelectMonth() may be used after this.
+
+			INPUT
+				struct DatasetCache *dc
+
+			OUTPUT
+				returns RTN_PATHFREED or the P372 error
+
+			SUBROUTINES
+				FreeIonMap()
+				dllFreeNoiseMemory()
+				FreeDataset()
+
+	*/
+
+	struct NoiseParams noiseP; // Temporary noise structure for the P372 free
+
+	int retval;
+	int month;
+
+	for(month=JAN; month<=DEC; month++) {
+		FreeIonMap(dc->ionmap[month]);
+		dc->ionmap[month] = NULL;
+
+		if(dc->fam[month] != NULL) {
+			noiseP.fakp = dc->fakp[month];
+			noiseP.fakabp = dc->fakabp[month];
+			noiseP.fam = dc->fam[month];
+			noiseP.dud = dc->dud[month];
+			retval = dllFreeNoiseMemory(&noiseP);
+			if(retval != RTN_NOISEFREED) return retval;
+			dc->fam[month] = NULL;
+		}
+	}
+
+	dc->loaded = FALSE;
+
+	if(dc->year.ionmap == NULL) return RTN_PATHFREED;
+
+	retval = FreeDataset(&dc->year);
+	dc->year.ionmap = NULL;
+
+	return retval;
+
+}
+
+int ValidIonMap(float const *ionmap) {
+
+	/*
+
+		ValidIonMap() - Checks that every foF2 and M(3000)F2 in the ionospheric maps is a positive number within FOF2MAX
+			and M3KF2MAX. A NaN fails the check as well.
+
+			INPUT
+				float const *ionmap
+
+			OUTPUT
+				returns TRUE if the maps are valid, otherwise FALSE
+
+			SUBROUTINES
+				None
+
+	*/
+
+	int i;
+
+	for(i=0; i<IONMAPSIZE; i+=IONMAPCELL) {
+		if(!((ionmap[i+IONMAPFOF2] > 0.0) && (ionmap[i+IONMAPFOF2] <= FOF2MAX) &&
+			 (ionmap[i+IONMAPFOF2+1] > 0.0) && (ionmap[i+IONMAPFOF2+1] <= FOF2MAX) &&
+			 (ionmap[i+IONMAPM3KF2] > 0.0) && (ionmap[i+IONMAPM3KF2] <= M3KF2MAX) &&
+			 (ionmap[i+IONMAPM3KF2+1] > 0.0) && (ionmap[i+IONMAPM3KF2+1] <= M3KF2MAX))) {
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+
+}
+
+void ZeroAntenna(struct Antenna *ant) {
+
+	/*
+
+		ZeroAntenna() - Initializes an antenna that has no pattern yet
+
+			INPUT
+				struct Antenna *ant
+
+			OUTPUT
+				struct Antenna *ant
+
+			SUBROUTINES
+				None
+
+	*/
+
+	ant->Name[0] = '\0';
+	ant->freqn = 0;
+	ant->freqs = NULL;
+	ant->pattern = NULL;
+	ant->rotation = 0;
+	ant->shared = FALSE;
+
+}
+
+void FreeAntenna(struct Antenna *ant) {
+
+	/*
+
+		FreeAntenna() - Frees the pattern and frequency list of an antenna. A pattern that belongs to the antenna registry
+			is left for FreeAntennaRegistry().
+
+			INPUT
+				struct Antenna *ant
+
+			OUTPUT
+				struct Antenna *ant
+
+			SUBROUTINES
+				None
+
+	*/
+
+	if(ant->shared == TRUE) {
+		ZeroAntenna(ant);
+		return;
+	}
+
+	free(ant->freqs);
+	if(ant->pattern != NULL) {
+		// The block of gains, the azimuth pointers and the frequency pointers (See AllocateAntennaMemory())
+		free(ant->pattern[0][0]);
+		free(ant->pattern[0]);
+		free(ant->pattern);
+	}
+
+	ZeroAntenna(ant);
+
+}
+
+float ****IonMapView(float *ionmap, int offset) {
+
+	/*
+
+		IonMapView() - Makes a [hour][longitude][latitude][SSN] array view of one of the parameters in the ionospheric map
+			block. The view is three arrays of pointers, so the whole map is four allocations rather than one allocation for
+			every grid cell. The innermost pointer of the view is the parameter's SSN pair in the grid cell.
+
+			INPUT
+				float *ionmap - The ionospheric map block
+				int offset - IONMAPFOF2 or IONMAPM3KF2
+
+			OUTPUT
+				returns the view or NULL
+
+			SUBROUTINES
+				None
+
+	*/
+
+	float ****view;
+	float ***lngs;
+	float **lats;
+
+	int i, j, k;
+
+	view = (float ****) malloc(IONMAPHRS*sizeof(float ***));
+	lngs = (float ***) malloc(IONMAPHRS*IONMAPLNGS*sizeof(float **));
+	lats = (float **) malloc(IONMAPHRS*IONMAPLNGS*IONMAPLATS*sizeof(float *));
+	if((view == NULL) || (lngs == NULL) || (lats == NULL)) {
+		free(view);
+		free(lngs);
+		free(lats);
+		return NULL;
+	}
+
+	for(i=0; i<IONMAPHRS; i++) {
+		view[i] = &lngs[i*IONMAPLNGS];
+		for(j=0; j<IONMAPLNGS; j++) {
+			view[i][j] = &lats[(i*IONMAPLNGS + j)*IONMAPLATS];
+			for(k=0; k<IONMAPLATS; k++) {
+				view[i][j][k] = IONMAPCELLPTR(ionmap, i, j, k) + offset;
+			}
+		}
+	}
+
+	return view;
+
+}
+
+void FreeIonMapView(float ****view) {
+
+	/*
+
+		FreeIonMapView() - Frees a view made by IonMapView(). The block itself is not freed.
+
+			INPUT
+				float ****view
+
+			OUTPUT
+				None
+
+			SUBROUTINES
+				None
+
+	*/
+
+	if(view == NULL) return;
+
+	free(view[0][0]);
+	free(view[0]);
+	free(view);
+
+}
@@ -8,7 +8,7 @@
 // End local includes
 
 // Local prototypes
-double MirrorReflectionHeight(struct PathData path, struct ControlPt CP, double dh);
+double MirrorReflectionHeight(struct PathData const *path, struct ControlPt const *CP, double dh);
 // End local prototypes
 
 void ELayerScreeningFrequency(struct PathData *path) {
@@ -57,15 +57,15 @@ void ELayerScreeningFrequency(struct PathData *path) {
 		dh = path->distance/(k+1);
 
 		if(path->distance <= path->dmax) {
-			path->Md_F2[k].hr = MirrorReflectionHeight(*path, path->CP[MP], dh);
+			path->Md_F2[k].hr = MirrorReflectionHeight(path, &path->CP[MP], dh);
 
 		}
 		else if(path->distance > path->dmax){
 			// In this case you have to find the mirror reflection height at all the control points and take the mean.
 			// Assume that the hop distance is path->dmax.
-			path->Md_F2[k].hr = (MirrorReflectionHeight(*path, path->CP[Td02], dh) +
-					            MirrorReflectionHeight(*path, path->CP[MP], dh) +
-					            MirrorReflectionHeight(*path, path->CP[Rd02], dh))/3.0;
+			path->Md_F2[k].hr = (MirrorReflectionHeight(path, &path->CP[Td02], dh) +
+					            MirrorReflectionHeight(path, &path->CP[MP], dh) +
+					            MirrorReflectionHeight(path, &path->CP[Rd02], dh))/3.0;
 		}
 
         // Find the elevation angle from equation 13 Section 5.1 Elevation angle.
@@ -89,7 +89,7 @@ void ELayerScreeningFrequency(struct PathData *path) {
 
 }
 
-double MirrorReflectionHeight(struct PathData path, struct ControlPt CP, double d) {
+double MirrorReflectionHeight(struct PathData const *path, struct ControlPt const *CP, double d) {
 
 	/*
 
@@ -97,8 +97,8 @@ double MirrorReflectionHeight(struct PathData path, struct ControlPt CP, double
 	 		in ITU-R P.533-12 Section 5.1 "Elevation angle".
 	 
 	 		INPUT
-	 			struct PathData path
-	 			struct ControlPt CP - The control point of interest
+	 			struct PathData const *path
+	 			struct ControlPt const *CP - The control point of interest
 	 			double d - The hop length
 	 
 	 		OUTPUT
@@ -120,15 +120,15 @@ double MirrorReflectionHeight(struct PathData path, struct ControlPt CP, double
 	double ds, df;
 
 	// Determine the critical frequency ratio
-	x = CP.foF2/CP.foE;
+	x = CP->foF2/CP->foE;
 
 	y = max(x, 1.8);
 
-	deltaM = (0.18/(y - 1.4))+(0.096*(min(path.SSN,160) - 25.0)/(150.0));
+	deltaM = (0.18/(y - 1.4))+(0.096*(min(path->SSN,160) - 25.0)/(150.0));
 
-	xr = path.frequency/CP.foF2;
+	xr = path->frequency/CP->foF2;
 
-	H = (1490.0/(CP.M3kF2 + deltaM)) - 316.0;
+	H = (1490.0/(CP->M3kF2 + deltaM)) - 316.0;
 
 	if((x > 3.33) && (xr >= 1.0)) { // a)
 		E1 = -0.09707*pow(xr, 3) + 0.6870*xr*xr - 0.7506*xr + 0.6;
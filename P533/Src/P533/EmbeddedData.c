@@ -0,0 +1,126 @@
+#if !defined(_WIN32) && defined(EMBEDDATA)
+	#define _POSIX_C_SOURCE 200809L // fmemopen()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+ * When libp533.so is built with "make EMBEDDATA=1" the data files that P533 reads, the ionospheric maps ionos01.bin to
+ * ionos12.bin and "P1239-3 Decile Factors.txt", are linked into the library by EmbeddedDataFiles.S. ReadIonParametersBin() and
+ * ReadP1239() then read them from memory rather than from DataFilePath, so a prediction needs no data files at all.
+ * In any other build OpenEmbeddedData() always returns NULL and the files are read from DataFilePath as before.
+ */
+
+#ifdef EMBEDDATA
+
+// Local defines
+#define EMBEDDED(sym, name)	{ name, sym, sym##_end }
+// End local defines
+
+// Symbols defined in EmbeddedDataFiles.S
+extern char const P533Data_ionos01[], P533Data_ionos01_end[];
+extern char const P533Data_ionos02[], P533Data_ionos02_end[];
+extern char const P533Data_ionos03[], P533Data_ionos03_end[];
+extern char const P533Data_ionos04[], P533Data_ionos04_end[];
+extern char const P533Data_ionos05[], P533Data_ionos05_end[];
+extern char const P533Data_ionos06[], P533Data_ionos06_end[];
+extern char const P533Data_ionos07[], P533Data_ionos07_end[];
+extern char const P533Data_ionos08[], P533Data_ionos08_end[];
+extern char const P533Data_ionos09[], P533Data_ionos09_end[];
+extern char const P533Data_ionos10[], P533Data_ionos10_end[];
+extern char const P533Data_ionos11[], P533Data_ionos11_end[];
+extern char const P533Data_ionos12[], P533Data_ionos12_end[];
+extern char const P533Data_P1239[], P533Data_P1239_end[];
+
+// Local structures
+struct EmbeddedFile {
+	char const *name;	// File name as it would be in DataFilePath
+	char const *start;	// First byte of the file
+	char const *end;	// One past the last byte of the file
+};
+// End local structures
+
+static struct EmbeddedFile const embedded[] = {
+	EMBEDDED(P533Data_ionos01, "ionos01.bin"),
+	EMBEDDED(P533Data_ionos02, "ionos02.bin"),
+	EMBEDDED(P533Data_ionos03, "ionos03.bin"),
+	EMBEDDED(P533Data_ionos04, "ionos04.bin"),
+	EMBEDDED(P533Data_ionos05, "ionos05.bin"),
+	EMBEDDED(P533Data_ionos06, "ionos06.bin"),
+	EMBEDDED(P533Data_ionos07, "ionos07.bin"),
+	EMBEDDED(P533Data_ionos08, "ionos08.bin"),
+	EMBEDDED(P533Data_ionos09, "ionos09.bin"),
+	EMBEDDED(P533Data_ionos10, "ionos10.bin"),
+	EMBEDDED(P533Data_ionos11, "ionos11.bin"),
+	EMBEDDED(P533Data_ionos12, "ionos12.bin"),
+	EMBEDDED(P533Data_P1239, "P1239-3 Decile Factors.txt")
+};
+
+#endif
+
+FILE *OpenEmbeddedData(char const *name) {
+
+	/*
+
+		OpenEmbeddedData() - Opens a data file that was compiled into the library as a read only stream in memory. The
+			caller reads it with the usual stdio routines and closes it with fclose().
+
+			INPUT
+				char const *name - The file name without a directory, e.g. "ionos01.bin"
+
+			OUTPUT
+				returns the stream or NULL if the file was not compiled in
+
+			SUBROUTINES
+				None
+
+	*/
+
+#ifdef EMBEDDATA
+	size_t i;
+
+	for(i=0; i<sizeof(embedded)/sizeof(embedded[0]); i++) {
+		if(strcmp(name, embedded[i].name) == 0) {
+			// The stream is opened read only so the data is never written
+			return fmemopen((void *)embedded[i].start, (size_t)(embedded[i].end - embedded[i].start), "rb");
+		}
+	}
+#else
+	(void)name;
+#endif
+
+	return NULL;
+
+}
+
+int EmbeddedData(void) {
+
+	/*
+
+		EmbeddedData() - Returns TRUE if the data files were compiled into the library
+
+			INPUT
+				None
+
+			OUTPUT
+				returns TRUE or FALSE
+
+			SUBROUTINES
+				None
+
+	*/
+
+#ifdef EMBEDDATA
+	return TRUE;
+#else
+	return FALSE;
+#endif
+
+}
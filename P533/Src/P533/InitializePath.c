@@ -17,11 +17,43 @@ void InitializeModes(struct Mode *M, int n);
 /*
  * This set of routines initializes the PathData structure
  */
+void InitializeCircuit(struct PathData *path) {
+
+	/*
+
+		InitializeCircuit() - Sets up the part of the path that doesn't depend on the receiver location. It has to be run
+			before InitializePath(), and again whenever anything other than path->L_rx changes. P533Batch() runs it once
+			for all of its receivers.
+
+			INPUT
+				struct PathData *path
+
+			OUTPUT
+				path->noiseP - The noise outputs are reset
+				path->Sun - The solar declination and equation of time for the month and hour
+
+			SUBROUTINES
+				dllInitializeNoise()
+				SolarTime()
+
+	*/
+
+	// Initialize Noise from the P372.dll
+	dllInitializeNoise(&path->noiseP);
+	// End Initialize Noise
+
+	// The declination and the equation of time are the same at every control point (See CalculateCPIonosphereBatch())
+	SolarTime(&path->Sun, path->month, (double)path->hour);
+
+	return;
+}
+
 void InitializePath(struct PathData *path) {
 
 	/*
 
-		InitializePath() - Sets the path structure output values to default values
+		InitializePath() - Sets the path structure output values to default values. InitializeCircuit() must have been run
+			on the path first.
 
 			INPUT
 				struct PathData *path
@@ -32,6 +64,7 @@ void InitializePath(struct PathData *path) {
 			SUBROUTINES
 				IntializeModes()
 				GreatCircleDistance()
+				Bearing()
 				InitializCPs()
 				WhatSeason()
 
@@ -122,14 +155,14 @@ void InitializePath(struct PathData *path) {
 		path->distance = R0*PI*2 - path->distance;
 	}
 
+	// The bearings for the antenna gains. The pattern columns for the frequency are found in PlanAntennas().
+	path->AP_tx.B = Bearing(path->L_tx, path->L_rx, path->SorL)*R2D; // degrees
+	path->AP_rx.B = Bearing(path->L_rx, path->L_tx, path->SorL)*R2D; // degrees
+
     // Initialize the control points
 	InitializeCPs(path);
 	// End initializing control points
 
-	// Initialize Noise from the P372.dll
-	dllInitializeNoise(&path->noiseP);
-	// End Initialize Noise
-
 	// Initialize the path variables.
 	// For several calculations you need to know the season.
 	path->season = WhatSeason(path->CP[MP].L, path->month);
@@ -0,0 +1,355 @@
+#ifndef _WIN32
+	#define _DEFAULT_SOURCE // mmap() with MAP_ANONYMOUS, pread() and sysconf()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+	#include <malloc.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+ * The native ionospheric map files, ionosXX.map, hold the foF2 and M(3000)F2 maps for a month in exactly the layout of the
+ * block ionmap (See IONMAPCELLPTR() in P533.h). They are made once from the ionosXX.bin files with WriteIonMap(), for
+ * example by the program IonMapConvert. MapIonParameters() then maps a file directly over the block so there is no read,
+ * no transpose and no copy. Processes that map the same file share the pages in the file system cache.
+ *
+ * The file is the IONMAPSIZE floats of the map followed by the trailer below. The trailer is at the end so that the map
+ * starts at offset 0 in the file, which is page aligned for mmap().
+ */
+
+// Local defines
+#define IONMAPMAGIC		"P533IONM"
+#define IONMAPVERSION	1
+#define IONMAPCHECK		1234.5f		// Detects a file that was made on a machine with a different float format
+// End local defines
+
+// Local structures
+struct IonMapTrailer {
+	char magic[8];		// IONMAPMAGIC
+	int version;		// IONMAPVERSION
+	int hrs;			// IONMAPHRS
+	int lngs;			// IONMAPLNGS
+	int lats;			// IONMAPLATS
+	int cell;			// IONMAPCELL
+	float check;		// IONMAPCHECK
+};
+// End local structures
+
+// Local prototypes
+size_t IonMapBytes(void);
+void MakeIonMapTrailer(struct IonMapTrailer *trailer);
+// End local prototypes
+
+DLLEXPORT int MapIonParameters(int month, float *ionmap, char DataFilePath[256], int silent) {
+
+	/*
+
+		MapIonParameters() - Loads the ionospheric maps for the month from the native file ionosXX.map. On Linux and macOS
+			the file is mapped over the block ionmap, replacing its pages, so the load is a single system call and the
+			maps are read from the file system cache as they are used. Switching months remaps the block. The views
+			path->foF2 and path->M3kF2 still point into the block so they see the new month. The mapping is private, so
+			anything written to the block later goes to this process's copy and never to the file.
+
+			On Windows the file is read straight into the block. This is still one read with no transpose.
+
+			If there is no native file for the month this returns RTN_ERRMAPIONPARAMETERS without a message and the caller
+			should use ReadIonParametersBin() instead. This is also the case when the maps are compiled into the library
+			(See EmbeddedData.c), so DataFilePath is not searched at all.
+
+			INPUT
+				int month - 0 to 11
+				float *ionmap - Block from AllocateDataset() or AllocatePathMemory() (path->ionmap)
+				char DataFilePath[256] - Directory of the data files
+				int silent
+
+			OUTPUT
+				ionmap - The maps for the month
+				returns RTN_READIONPARAOK or RTN_ERRMAPIONPARAMETERS
+
+			SUBROUTINES
+				EmbeddedData()
+				IonMapBytes()
+				MakeIonMapTrailer()
+
+	*/
+
+	struct IonMapTrailer expected, trailer;
+
+	char InFilePath[256];
+	char MapFile[32];
+
+	size_t bytes;		// Bytes of map data in the file
+
+#ifdef _WIN32
+	FILE *fp;
+	long size;
+#else
+	struct stat st;
+	void *map;
+	int fd;
+#endif
+
+	if(EmbeddedData() == TRUE) return RTN_ERRMAPIONPARAMETERS;
+
+	strcpy(InFilePath, DataFilePath);
+	sprintf(MapFile, "ionos%02d.map", month+1);
+	strcat(InFilePath, MapFile);
+
+	bytes = IONMAPSIZE*sizeof(float);
+	MakeIonMapTrailer(&expected);
+
+#ifdef _WIN32
+	fp = fopen(InFilePath, "rb");
+	if(fp == NULL) return RTN_ERRMAPIONPARAMETERS;
+
+	fseek(fp, 0, SEEK_END);
+	size = ftell(fp);
+	fseek(fp, (long)bytes, SEEK_SET);
+	if((size != (long)(bytes + sizeof(trailer))) || (fread(&trailer, sizeof(trailer), 1, fp) != 1) ||
+	   (memcmp(&trailer, &expected, sizeof(trailer)) != 0)) {
+		printf("MapIonParameters: ERROR %s is not a native ionospheric map for this machine\n", InFilePath);
+		fclose(fp);
+		return RTN_ERRMAPIONPARAMETERS;
+	}
+
+	if(silent != TRUE) {
+		printf("MapIonParameters: Reading file ionos%02d.map for ionospheric parameters\n", month+1);
+	}
+
+	fseek(fp, 0, SEEK_SET);
+	if(fread(ionmap, sizeof(float), IONMAPSIZE, fp) != IONMAPSIZE) {
+		printf("MapIonParameters: ERROR Can't read %s\n", InFilePath);
+		fclose(fp);
+		return RTN_ERRMAPIONPARAMETERS;
+	}
+	fclose(fp);
+#else
+	fd = open(InFilePath, O_RDONLY);
+	if(fd < 0) return RTN_ERRMAPIONPARAMETERS;
+
+	if((fstat(fd, &st) != 0) || (st.st_size != (off_t)(bytes + sizeof(trailer))) ||
+	   (pread(fd, &trailer, sizeof(trailer), (off_t)bytes) != (ssize_t)sizeof(trailer)) ||
+	   (memcmp(&trailer, &expected, sizeof(trailer)) != 0)) {
+		printf("MapIonParameters: ERROR %s is not a native ionospheric map for this machine\n", InFilePath);
+		close(fd);
+		return RTN_ERRMAPIONPARAMETERS;
+	}
+
+	if(silent != TRUE) {
+		printf("MapIonParameters: Mapping file ionos%02d.map for ionospheric parameters\n", month+1);
+	}
+
+	map = mmap(ionmap, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+	close(fd);
+	if(map == MAP_FAILED) {
+		// The block may have lost its pages so give it new ones
+		mmap(ionmap, IonMapBytes(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+		printf("MapIonParameters: ERROR Can't map %s\n", InFilePath);
+		return RTN_ERRMAPIONPARAMETERS;
+	}
+#endif
+
+	return RTN_READIONPARAOK;
+
+}
+
+DLLEXPORT int WriteIonMap(int month, float const *ionmap, char DataFilePath[256], int silent) {
+
+	/*
+
+		WriteIonMap() - Writes the ionospheric maps in the block ionmap to the native file ionosXX.map for the month so that
+			MapIonParameters() can load them. The maps are normally read with ReadIonParametersBin() first. The file is
+			written under a temporary name and then renamed, so a process that has the old file mapped is not disturbed.
+
+			INPUT
+				int month - 0 to 11
+				float const *ionmap - The maps for the month
+				char DataFilePath[256] - Directory of the data files
+				int silent
+
+			OUTPUT
+				Writes DataFilePath/ionosXX.map
+				returns RTN_READIONPARAOK or RTN_ERRWRITEIONMAP
+
+			SUBROUTINES
+				MakeIonMapTrailer()
+
+	*/
+
+	struct IonMapTrailer trailer;
+
+	char OutFilePath[256];
+	char TmpFilePath[256];
+	char MapFile[32];
+
+	FILE *fp;
+
+	int ok;
+
+	strcpy(OutFilePath, DataFilePath);
+	sprintf(MapFile, "ionos%02d.map", month+1);
+	strcat(OutFilePath, MapFile);
+	strcpy(TmpFilePath, OutFilePath);
+	strcat(TmpFilePath, ".tmp");
+
+	MakeIonMapTrailer(&trailer);
+
+	fp = fopen(TmpFilePath, "wb");
+	if(fp == NULL) {
+		printf("WriteIonMap: ERROR Can't create %s\n", TmpFilePath);
+		return RTN_ERRWRITEIONMAP;
+	}
+
+	if(silent != TRUE) {
+		printf("WriteIonMap: Writing file ionos%02d.map\n", month+1);
+	}
+
+	ok = (fwrite(ionmap, sizeof(float), IONMAPSIZE, fp) == IONMAPSIZE);
+	ok = ok && (fwrite(&trailer, sizeof(trailer), 1, fp) == 1);
+	ok = (fclose(fp) == 0) && ok;
+
+#ifdef _WIN32
+	// rename() does not replace an existing file on Windows
+	if(ok) remove(OutFilePath);
+#endif
+	if(!ok || (rename(TmpFilePath, OutFilePath) != 0)) {
+		printf("WriteIonMap: ERROR Can't write %s\n", OutFilePath);
+		remove(TmpFilePath);
+		return RTN_ERRWRITEIONMAP;
+	}
+
+	return RTN_READIONPARAOK;
+
+}
+
+float *AllocateIonMap(void) {
+
+	/*
+
+		AllocateIonMap() - Allocates the block for the foF2 and M(3000)F2 maps. The block is aligned to at least
+			IONMAPALIGN bytes so that each four float grid cell is within one cache line. On Linux and macOS the block is
+			whole pages of its own so that MapIonParameters() can map a native file over it.
+
+			INPUT
+				None
+
+			OUTPUT
+				returns a pointer to the block or NULL
+
+			SUBROUTINES
+				IonMapBytes()
+
+	*/
+
+	void *block;
+
+#ifdef _WIN32
+	block = _aligned_malloc(IonMapBytes(), IONMAPALIGN);
+#else
+	block = mmap(NULL, IonMapBytes(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(block == MAP_FAILED) block = NULL;
+#endif
+
+	return (float *)block;
+
+}
+
+void FreeIonMap(float *ionmap) {
+
+	/*
+
+		FreeIonMap() - Frees the block allocated by AllocateIonMap() whether or not a native file is mapped over it
+
+			INPUT
+				float *ionmap
+
+			OUTPUT
+				None
+
+			SUBROUTINES
+				IonMapBytes()
+
+	*/
+
+	if(ionmap == NULL) return;
+
+#ifdef _WIN32
+	_aligned_free(ionmap);
+#else
+	munmap(ionmap, IonMapBytes());
+#endif
+
+}
+
+size_t IonMapBytes(void) {
+
+	/*
+
+		IonMapBytes() - Returns the size of the block in bytes. On Linux and macOS this is rounded up to whole pages.
+
+			INPUT
+				None
+
+			OUTPUT
+				returns the size of the block (bytes)
+
+			SUBROUTINES
+				None
+
+	*/
+
+	size_t bytes;
+
+	bytes = IONMAPSIZE*sizeof(float);
+
+#ifndef _WIN32
+	{
+		size_t page = (size_t)sysconf(_SC_PAGESIZE);
+		bytes = ((bytes + page - 1)/page)*page;
+	}
+#endif
+
+	return bytes;
+
+}
+
+void MakeIonMapTrailer(struct IonMapTrailer *trailer) {
+
+	/*
+
+		MakeIonMapTrailer() - Fills in the trailer of a native ionospheric map file for this machine
+
+			INPUT
+				struct IonMapTrailer *trailer
+
+			OUTPUT
+				struct IonMapTrailer *trailer
+
+			SUBROUTINES
+				None
+
+	*/
+
+	memset(trailer, 0, sizeof(struct IonMapTrailer));
+	memcpy(trailer->magic, IONMAPMAGIC, sizeof(trailer->magic));
+	trailer->version = IONMAPVERSION;
+	trailer->hrs = IONMAPHRS;
+	trailer->lngs = IONMAPLNGS;
+	trailer->lats = IONMAPLATS;
+	trailer->cell = IONMAPCELL;
+	trailer->check = IONMAPCHECK;
+
+}
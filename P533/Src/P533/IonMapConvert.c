@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+
+	IonMapConvert - Converts the ionospheric map files ionos01.bin to ionos12.bin into the native files ionos01.map to
+		ionos12.map that MapIonParameters() maps without reading or transposing them. The native files are written in
+		the same directory. This only needs to be done once on each machine, since the native files are in the machine's
+		own float format.
+
+		This is not part of the libp533.so build. On Linux or macOS build and run it from P533/Linux with
+			make IonMapConvert
+			LD_LIBRARY_PATH=.:../../P372/Linux ./IonMapConvert DataFilePath
+
+		where DataFilePath is the directory of the data files, ending in a '/', as in the ITURHFProp input file.
+
+*/
+
+int main(int argc, char *argv[]) {
+
+	struct PathData path;
+
+	char DataFilePath[256];
+
+	int retval;
+	int month;
+
+	if((argc != 2) || (strlen(argv[1]) >= sizeof(DataFilePath))) {
+		printf("Usage: IonMapConvert DataFilePath\n");
+		return EXIT_FAILURE;
+	}
+	strcpy(DataFilePath, argv[1]);
+
+	retval = AllocatePathMemory(&path);
+	if(retval != RTN_ALLOCATEP533OK) {
+		printf("IonMapConvert: Error %d allocating the maps\n", retval);
+		return retval;
+	}
+
+	for(month=JAN; month<=DEC; month++) {
+		retval = ReadIonParametersBin(month, path.foF2, path.M3kF2, DataFilePath, TRUE);
+		if(retval != RTN_READIONPARAOK) break;
+
+		retval = WriteIonMap(month, path.ionmap, DataFilePath, FALSE);
+		if(retval != RTN_READIONPARAOK) break;
+	}
+
+	FreePathMemory(&path);
+
+	if(retval != RTN_READIONPARAOK) {
+		printf("IonMapConvert: Error %d\n", retval);
+		return retval;
+	}
+
+	return EXIT_SUCCESS;
+
+}
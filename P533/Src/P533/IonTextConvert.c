@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+
+	IonTextConvert - Converts a text ionospheric map file, such as the ionosXX.txt files from iongrid or updated maps from
+		elsewhere in the same layout, into a file that the engine loads quickly. Either the binary file ionosXX.bin that
+		ReadIonParametersBin() reads or the native file ionosXX.map that MapIonParameters() maps is written to the data
+		directory for the month given.
+
+		This is not part of the libp533.so build. On Linux or macOS build and run it from P533/Linux with
+			make IonTextConvert
+			LD_LIBRARY_PATH=.:../../P372/Linux ./IonTextConvert bin|map TextFile Month DataFilePath
+
+		where Month is 1 to 12 and DataFilePath is the directory of the data files, ending in a '/', as in the ITURHFProp
+		input file. The native files are in the machine's own float format so they should be made on the machine that
+		uses them.
+
+*/
+
+int main(int argc, char *argv[]) {
+
+	struct PathData path;
+
+	char DataFilePath[256];
+
+	int retval;
+	int month;
+	int native;		// TRUE for ionosXX.map and FALSE for ionosXX.bin
+
+	month = (argc == 5) ? atoi(argv[3]) : 0;
+	if((argc != 5) || ((strcmp(argv[1], "bin") != 0) && (strcmp(argv[1], "map") != 0)) ||
+	   (month < 1) || (month > 12) || (strlen(argv[4]) >= sizeof(DataFilePath))) {
+		printf("Usage: IonTextConvert bin|map TextFile Month DataFilePath\n");
+		return EXIT_FAILURE;
+	}
+	native = (strcmp(argv[1], "map") == 0);
+	month = month - 1;
+	strcpy(DataFilePath, argv[4]);
+
+	retval = AllocatePathMemory(&path);
+	if(retval != RTN_ALLOCATEP533OK) {
+		printf("IonTextConvert: Error %d allocating the maps\n", retval);
+		return retval;
+	}
+
+	retval = ReadIonParametersTxtFile(argv[2], path.foF2, path.M3kF2, FALSE);
+	if(retval == RTN_READIONPARAOK) {
+		if(native == TRUE) {
+			retval = WriteIonMap(month, path.ionmap, DataFilePath, FALSE);
+		}
+		else {
+			retval = WriteIonParametersBin(month, path.foF2, path.M3kF2, DataFilePath, FALSE);
+		}
+	}
+
+	FreePathMemory(&path);
+
+	if(retval != RTN_READIONPARAOK) {
+		printf("IonTextConvert: Error %d\n", retval);
+		return retval;
+	}
+
+	return EXIT_SUCCESS;
+
+}
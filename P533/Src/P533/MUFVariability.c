@@ -10,10 +10,10 @@
 void MUFVariability(struct PathData *path) {
 	/*
 
-	 	MUFVariability() - Calculates the F2 and E Fprob, 50% MUF (MUF50), 90% MUF (MUF90) and 10% MUF (MUF10) 
+	 	MUFVariability() - Calculates the F2 and E 50% MUF (MUF50), 90% MUF (MUF90) and 10% MUF (MUF10) 
 	 		in accordance with P.533-12
-	 		Section 3.7 "The path operational MUF" and
-	 		Section 3.6 "Within the month probability of ionospheric propagation support" 
+	 		Section 3.7 "The path operational MUF"
+	 		The Fprob for the operating frequency is found in MUFProbability()
 	 
 	 		INPUT
 	 			struct PathData *path
@@ -29,8 +29,6 @@ void MUFVariability(struct PathData *path) {
 	 			path->Md_F2[].deltau = F2 layer upper decile deviation of the MUF
 	 			path->Md_E[].deltal = E layer lower decile deviation of the MUF
 	 			path->Md_E[].deltau = E layer lower decile deviation of the MUF
-	 			path->Md_F2[].Fprob = F2 layer within the month probability of ionospheric propagation support 
-	 			path->Md_E[].Fprob = E layer within the month probability of ionospheric propagation support
 	 	
 
 			SUBROUTINES
@@ -63,25 +61,15 @@ void MUFVariability(struct PathData *path) {
 			// Determine the decile factors
 			decile = DL; // Lower decile
 			// Find the deltal in the foF2var array
-			path->Md_F2[i].deltal = FindfoF2var(*path, path->CP[MP].ltime, path->CP[MP].L.lat, decile);
+			path->Md_F2[i].deltal = FindfoF2var(path, path->CP[MP].ltime, path->CP[MP].L.lat, decile);
 				
 			decile = DU; // Upper decile
 			// Find the deltau in the foF2var array
-			path->Md_F2[i].deltau = FindfoF2var(*path, path->CP[MP].ltime, path->CP[MP].L.lat, decile);
+			path->Md_F2[i].deltau = FindfoF2var(path, path->CP[MP].ltime, path->CP[MP].L.lat, decile);
 
 			// Find the other MUFs
 			path->Md_F2[i].MUF10 = path->Md_F2[i].deltau*path->Md_F2[i].MUF50;
 			path->Md_F2[i].MUF90 = path->Md_F2[i].deltal*path->Md_F2[i].MUF50;
-
-			// Now determine the probability that the mode can be supported
-			if(path->frequency < path->Md_F2[i].MUF50) {
-				path->Md_F2[i].Fprob = min(1.3 - (0.8/(1.0+((1.0 - (path->frequency/path->Md_F2[i].MUF50))/(1.0 - path->Md_F2[i].deltal)))), 1.0);
-				//printf("Eq.9  Freq=%.2f MUF50=%.2f deltal=%.2f Fprob=%.2f\n", path->frequency, path->Md_F2[i].MUF50, path->Md_F2[i].deltal, path->Md_F2[i].Fprob);
-			}
-			else { // (path->frequency >= path->Md_F2[i].MUF50)
-				path->Md_F2[i].Fprob = max((0.8/(1.0 + (((path->frequency/path->Md_F2[i].MUF50) - 1.0)/(path->Md_F2[i].deltau - 1.0)))) - 0.3, 0.0);
-				//printf("Eq.10 Freq=%.2f MUF50=%.2f deltau=%.2f Fprob=%.2f\n", path->frequency, path->Md_F2[i].MUF50, path->Md_F2[i].deltau, path->Md_F2[i].Fprob);
-			}
 		}
 	}
 
@@ -103,14 +91,6 @@ void MUFVariability(struct PathData *path) {
 			// Find the other MUFs
 			path->Md_E[i].MUF10 = path->Md_E[i].deltau*path->Md_E[i].MUF50;
 			path->Md_E[i].MUF90 = path->Md_E[i].deltal*path->Md_E[i].MUF50;
-
-			// Now determine the probability that the mode can be supported
-			if(path->frequency < path->Md_E[i].MUF50) {
-				path->Md_E[i].Fprob = min(1.3 - (0.8/(1.0 + ((1.0 - (path->frequency/path->Md_E[i].MUF50))/(1.0 - path->Md_E[i].deltal)))), 1.0);
-			}
-			else { // (path->frequency >= path->Md_F2[i].MUF50)
-				path->Md_E[i].Fprob = max((0.8/(1.0 + (((path->frequency/path->Md_E[i].MUF50) - 1.0)/(path->Md_E[i].deltau - 1.0)))) - 0.3, 0.0);
-			}
 		}
 	}
 
@@ -142,7 +122,7 @@ void MUFVariability(struct PathData *path) {
 
 }
 
-double FindfoF2var(struct PathData path, double hour, double lat, int decile) { 
+double FindfoF2var(struct PathData const *path, double hour, double lat, int decile) { 
 
 	/*
 
@@ -150,7 +130,7 @@ double FindfoF2var(struct PathData path, double hour, double lat, int decile) {
 	 		This routine uses the bilinear interpolation method in ITU-R P.1144-5
 	 
 	 		INPUT
-	 			struct PathData path 
+	 			struct PathData const *path 
 	 			double hour - Hour of interest
 	 			double lat - Latitude of interest
 	 			int decile - Upper or lower decile index
@@ -207,10 +187,10 @@ double FindfoF2var(struct PathData path, double hour, double lat, int decile) {
 	}
 
     // Determine the sunspot number index ssn. 
-	if(path.SSN < 50) {
+	if(path->SSN < 50) {
 		ssn = 0;
 	}
-	else if((50 <= path.SSN) && (path.SSN <=100)) { 
+	else if((50 <= path->SSN) && (path->SSN <=100)) { 
 		ssn = 1;	
 	}
 	else { // path-SSN > 100
@@ -218,10 +198,10 @@ double FindfoF2var(struct PathData path, double hour, double lat, int decile) {
 	}
 
     // Find the neighbors
-	LL = path.foF2var[path.season][hourL][latL][ssn][decile];
-	LR = path.foF2var[path.season][hourU][latL][ssn][decile];
-	UL = path.foF2var[path.season][hourL][latU][ssn][decile];
-	UR = path.foF2var[path.season][hourU][latU][ssn][decile];
+	LL = path->foF2var[path->season][hourL][latL][ssn][decile];
+	LR = path->foF2var[path->season][hourU][latL][ssn][decile];
+	UL = path->foF2var[path->season][hourL][latU][ssn][decile];
+	UR = path->foF2var[path->season][hourU][latU][ssn][decile];
 
 	Irc = BilinearInterpolation(LL, LR, UL, UR, r, c);
 
@@ -229,3 +209,58 @@ double FindfoF2var(struct PathData path, double hour, double lat, int decile) {
 
 }
 
+void MUFProbability(struct PathData *path) {
+	/*
+
+	 	MUFProbability() - Calculates the F2 and E Fprob for the operating frequency in accordance with P.533-12
+	 		Section 3.6 "Within the month probability of ionospheric propagation support"
+	 		MUFVariability() must have been run on the path first.
+
+	 		INPUT
+	 			struct PathData *path
+
+	 		OUTPUT
+	 			path->Md_F2[].Fprob = F2 layer within the month probability of ionospheric propagation support 
+	 			path->Md_E[].Fprob = E layer within the month probability of ionospheric propagation support
+
+			SUBROUTINES
+				None
+
+	 */
+
+	int i;		// Index
+
+	// Only do this subroutine if the path is less than or equal to 9000 km if not exit
+	if(path->distance > 9000) return; 
+
+	// The F2 layer modes
+	for(i=0; i<MAXF2MDS; i++) { // There are 6 F2 layer modes 
+		if(path->Md_F2[i].BMUF != 0.0) { // If the Basic MUF is set, non-zero, the layer exists
+			// Now determine the probability that the mode can be supported
+			if(path->frequency < path->Md_F2[i].MUF50) {
+				path->Md_F2[i].Fprob = min(1.3 - (0.8/(1.0+((1.0 - (path->frequency/path->Md_F2[i].MUF50))/(1.0 - path->Md_F2[i].deltal)))), 1.0);
+				//printf("Eq.9  Freq=%.2f MUF50=%.2f deltal=%.2f Fprob=%.2f\n", path->frequency, path->Md_F2[i].MUF50, path->Md_F2[i].deltal, path->Md_F2[i].Fprob);
+			}
+			else { // (path->frequency >= path->Md_F2[i].MUF50)
+				path->Md_F2[i].Fprob = max((0.8/(1.0 + (((path->frequency/path->Md_F2[i].MUF50) - 1.0)/(path->Md_F2[i].deltau - 1.0)))) - 0.3, 0.0);
+				//printf("Eq.10 Freq=%.2f MUF50=%.2f deltau=%.2f Fprob=%.2f\n", path->frequency, path->Md_F2[i].MUF50, path->Md_F2[i].deltau, path->Md_F2[i].Fprob);
+			}
+		}
+	}
+
+	// The E layer modes
+	for(i=0; i<MAXEMDS; i++) { // There are 3 E layer modes 
+		if(path->Md_E[i].BMUF != 0.0) { // If the Basic MUF is set, non-zero, the layer exists
+			// Now determine the probability that the mode can be supported
+			if(path->frequency < path->Md_E[i].MUF50) {
+				path->Md_E[i].Fprob = min(1.3 - (0.8/(1.0 + ((1.0 - (path->frequency/path->Md_E[i].MUF50))/(1.0 - path->Md_E[i].deltal)))), 1.0);
+			}
+			else { // (path->frequency >= path->Md_F2[i].MUF50)
+				path->Md_E[i].Fprob = max((0.8/(1.0 + (((path->frequency/path->Md_E[i].MUF50) - 1.0)/(path->Md_E[i].deltau - 1.0)))) - 0.3, 0.0);
+			}
+		}
+	}
+
+	return;
+
+}
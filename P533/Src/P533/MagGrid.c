@@ -0,0 +1,191 @@
+#ifndef _WIN32
+	#define _POSIX_C_SOURCE 200112L // pthread_once()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+ * The magnetic field grid holds the magnetic dip and the gyrofrequency at 100 and 300 km from magfit() on a global
+ * latitude by longitude grid with a spacing of MAGGRIDSTEP degrees. The field model does not depend on the month, the
+ * hour, the SSN or the frequency, so the grid is made once in the process, the first time it is used, and is then shared
+ * read only by every path and thread. MagGridBatch() bilinearly interpolates the grid in place of MagfitBatch() when
+ * path->MagField is MAGFIELDGRID (Path.MagField "GRID" in the input file).
+ *
+ * The grid is 1 degree (MAGGRIDPERDEG 1), 181 x 361 points or 2 MB, and takes about 40 ms to make. Over 10^6 random
+ * points on the globe the largest differences from magfit() are 0.00015 MHz in fH and 0.26 degrees in the dip, with an
+ * RMS difference in the dip of 0.0033 degrees, at either height. The largest dip differences are within a few degrees
+ * of the dip poles, where the dip has a sharp peak that bilinear interpolation rounds off. MAGGRIDPERDEG 2 halves the
+ * largest dip difference for four times the memory and time to make. The program MagGridCheck measures the differences.
+ */
+
+// Local defines
+#define MAGGRIDPERDEG	1						// Grid points per degree
+#define MAGGRIDSTEP		(1.0/MAGGRIDPERDEG)		// Grid spacing (degrees)
+#define MAGGRIDLATS		(180*MAGGRIDPERDEG + 1)	// -90 to 90 degrees
+#define MAGGRIDLNGS		(360*MAGGRIDPERDEG + 1)	// -180 to 180 degrees
+#define MAGGRIDVALS		4						// dip[HR100km], dip[HR300km], fH[HR100km], fH[HR300km]
+#define MAGGRIDROW		32						// Number of grid points given to MagfitBatch() at a time
+// End local defines
+
+// Local variables
+// The grid is [latitude][longitude][value] so the four values of a grid point are together
+static double MagGrid[MAGGRIDLATS][MAGGRIDLNGS][MAGGRIDVALS];
+#ifdef _WIN32
+	static INIT_ONCE MagGridOnce = INIT_ONCE_STATIC_INIT;
+#else
+	static pthread_once_t MagGridOnce = PTHREAD_ONCE_INIT;
+#endif
+// End local variables
+
+// Local prototypes
+void MakeMagGrid(void);
+#ifdef _WIN32
+	BOOL CALLBACK MakeMagGridOnce(PINIT_ONCE once, PVOID param, PVOID *context);
+#endif
+// End local prototypes
+
+void MagGridBatch(struct ControlPt *here[], int n) {
+
+	/*
+	 	MagGridBatch() - Finds the magnetic dip and the gyrofrequency at both 100 and 300 km for n control points by bilinear
+			interpolation of the magnetic field grid. The grid is made on the first call. This is a faster, approximate,
+			replacement for MagfitBatch() (See the top of this file for the largest differences).
+
+	 		INPUT
+	 			struct ControlPt *here[] - Control points of interest
+				int n - Number of control points
+
+ 	 		OUTPUT
+	 			here[]->dip[HR100km] and here[]->dip[HR300km] - Magnetic dip
+	 			here[]->fH[HR100km] and here[]->fH[HR300km] - Gyrofrequency
+
+	 		SUBROUTINES
+				MakeMagGrid()
+				BilinearInterpolation()
+
+	 */
+
+	double (*LL)[MAGGRIDVALS], (*LR)[MAGGRIDVALS], (*UL)[MAGGRIDVALS], (*UR)[MAGGRIDVALS];
+	double x, y;	// Fractional grid indices
+	double r, c;	// Fractional row and column in the grid cell
+
+	int i, j;
+	int k;
+
+#ifdef _WIN32
+	InitOnceExecuteOnce(&MagGridOnce, MakeMagGridOnce, NULL, NULL);
+#else
+	pthread_once(&MagGridOnce, MakeMagGrid);
+#endif
+
+	for(k=0; k<n; k++) {
+		x = (here[k]->L.lat*R2D + 90.0)/MAGGRIDSTEP;
+		y = (here[k]->L.lng*R2D + 180.0)/MAGGRIDSTEP;
+
+		// Wrap the longitude into the grid
+		y = fmod(y, MAGGRIDLNGS - 1);
+		if(y < 0.0) y += MAGGRIDLNGS - 1;
+
+		i = (int)x;
+		if(i < 0) i = 0;
+		if(i > MAGGRIDLATS - 2) i = MAGGRIDLATS - 2;
+		j = (int)y;
+		if(j > MAGGRIDLNGS - 2) j = MAGGRIDLNGS - 2;
+
+		r = x - i;
+		c = y - j;
+
+		LL = &MagGrid[i][j];
+		LR = &MagGrid[i][j+1];
+		UL = &MagGrid[i+1][j];
+		UR = &MagGrid[i+1][j+1];
+
+		here[k]->dip[HR100km] = BilinearInterpolation((*LL)[0], (*LR)[0], (*UL)[0], (*UR)[0], r, c);
+		here[k]->dip[HR300km] = BilinearInterpolation((*LL)[1], (*LR)[1], (*UL)[1], (*UR)[1], r, c);
+		here[k]->fH[HR100km] = BilinearInterpolation((*LL)[2], (*LR)[2], (*UL)[2], (*UR)[2], r, c);
+		here[k]->fH[HR300km] = BilinearInterpolation((*LL)[3], (*LR)[3], (*UL)[3], (*UR)[3], r, c);
+	}
+
+}
+
+void MakeMagGrid(void) {
+
+	/*
+	 	MakeMagGrid() - Fills the magnetic field grid from magfit() via MagfitBatch(). This is run once in the process.
+
+	 		INPUT
+	 			None
+
+ 	 		OUTPUT
+	 			MagGrid[][][]
+
+	 		SUBROUTINES
+				MagfitBatch()
+
+	 */
+
+	struct ControlPt pt[MAGGRIDROW];
+	struct ControlPt *mf[MAGGRIDROW];
+
+	int i, j;
+	int k, nk;
+
+	for(k=0; k<MAGGRIDROW; k++) mf[k] = &pt[k];
+
+	for(i=0; i<MAGGRIDLATS; i++) {
+		for(j=0; j<MAGGRIDLNGS; j+=MAGGRIDROW) {
+			nk = ((MAGGRIDLNGS - j) < MAGGRIDROW) ? (MAGGRIDLNGS - j) : MAGGRIDROW;
+			for(k=0; k<nk; k++) {
+				pt[k].L.lat = (-90.0 + i*MAGGRIDSTEP)*D2R;
+				pt[k].L.lng = (-180.0 + (j+k)*MAGGRIDSTEP)*D2R;
+			}
+			MagfitBatch(mf, nk);
+			for(k=0; k<nk; k++) {
+				MagGrid[i][j+k][0] = pt[k].dip[HR100km];
+				MagGrid[i][j+k][1] = pt[k].dip[HR300km];
+				MagGrid[i][j+k][2] = pt[k].fH[HR100km];
+				MagGrid[i][j+k][3] = pt[k].fH[HR300km];
+			}
+		}
+	}
+
+}
+
+#ifdef _WIN32
+BOOL CALLBACK MakeMagGridOnce(PINIT_ONCE once, PVOID param, PVOID *context) {
+
+	/*
+	 	MakeMagGridOnce() - Calls MakeMagGrid() for InitOnceExecuteOnce()
+
+	 		INPUT
+	 			As InitOnceExecuteOnce()
+
+ 	 		OUTPUT
+	 			returns TRUE
+
+	 		SUBROUTINES
+				MakeMagGrid()
+
+	 */
+
+	(void)once; (void)param; (void)context; // To avoid unused parameter warning
+
+	MakeMagGrid();
+
+	return TRUE;
+
+}
+#endif
@@ -1,10 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 // Local includes
 #include "Common.h"
 #include "P533.h"
+// End local includes
+
+// Local defines
+#define MAGFITBLOCK	8	// Number of control points MagfitBatch() evaluates together
+// End local defines
 
 void magfit(struct ControlPt *here, double height) {
 
@@ -144,3 +150,161 @@ void magfit(struct ControlPt *here, double height) {
 	here->fH[hr]=2.8*sqrt(pow(Fx,2)+pow((Fy/cos(here->L.lat)),2)+pow(Fz,2));
   
 }
+
+void MagfitBatch(struct ControlPt *here[], int n) {
+
+	/*
+	 	MagfitBatch() - Calculates the magnetic dip and the gyrofrequency at both 100 and 300 km for n control points. The
+			result is the same as calling magfit() at each height for each control point, but the work is shared:
+				i) The associated Legendre functions and the sums over m only depend on the latitude and longitude, so they
+				   are found once for both heights.
+				ii) The powers (R0/(R0 + height))^(n+2) are the same for every control point, so they are found once for the
+				   batch.
+				iii) cos(m*lng) and sin(m*lng) are found once for each control point rather than three times for each term.
+			The control points are taken MAGFITBLOCK at a time with the control point as the innermost index of the
+			working arrays, so the compiler can vectorise the recurrences across the control points. The operations
+			for each control point are done in the same order as in magfit() so the results are identical.
+
+	 		INPUT
+	 			struct ControlPt *here[] - Control points of interest
+				int n - Number of control points
+	 
+ 	 		OUTPUT
+	 			here[]->dip[HR100km] and here[]->dip[HR300km] - Magnetic dip
+	 			here[]->fH[HR100km] and here[]->fH[HR300km] - Gyrofrequency
+
+	 		SUBROUTINES
+				None
+
+	 */
+
+	// Numerical coefficients for the field model (gauss) and the Legendre function coefficients as in magfit()
+	static const double G[7][7] = { {0.000000, 0.304112, 0.024035,-0.031518,-0.041794, 0.016256,-0.019523},
+									{0.000000, 0.021474,-0.051253, 0.062130,-0.045298,-0.034407,-0.004853},
+									{0.000000, 0.000000,-0.013381,-0.024898,-0.021795,-0.019447, 0.003212},
+									{0.000000, 0.000000, 0.000000,-.0064960, 0.007008,-0.000608, 0.021413},
+									{0.000000, 0.000000, 0.000000, 0.000000,-0.002044, 0.002775, 0.001051},
+									{0.000000, 0.000000, 0.000000, 0.000000, 0.000000, 0.000697, 0.000227},
+									{0.000000, 0.000000, 0.000000, 0.000000, 0.000000, 0.000000, 0.001115}
+	};
+
+	static const double H[7][7] = { {0.000000, 0.000000, 0.000000, 0.000000, 0.000000, 0.000000, 0.000000},
+									{0.000000,-0.057989, 0.033124, 0.014870,-0.011825,-0.000796,-0.005758},
+									{0.000000, 0.000000,-0.001579,-0.004075, 0.010006,-0.002000,-0.008735},
+									{0.000000, 0.000000, 0.000000, 0.000210, 0.000430, 0.004597,-0.003406},
+									{0.000000, 0.000000, 0.000000, 0.000000, 0.001385, 0.002421,-0.000118},
+									{0.000000, 0.000000, 0.000000, 0.000000, 0.000000,-0.001218,-0.001116},
+									{0.000000, 0.000000, 0.000000, 0.000000, 0.000000, 0.000000,-0.000325}
+	};
+
+	static const double CT[7][7] = { {0.0000000,0.0000000,0.33333333,0.266666666,0.25714286,0.25396825,0.25252525},
+									 {0.0000000,0.0000000,0.00000000,0.200000000,0.22857142,0.23809523,0.24242424},
+									 {0.0000000,0.0000000,0.00000000,0.000000000,0.14285714,0.19047619,0.21212121},
+									 {0.0000000,0.0000000,0.00000000,0.000000000,0.00000000,0.11111111,0.16161616},
+									 {0.0000000,0.0000000,0.00000000,0.000000000,0.00000000,0.00000000,0.09090909},
+									 {0.0000000,0.0000000,0.00000000,0.000000000,0.00000000,0.00000000,0.00000000},
+									 {0.0000000,0.0000000,0.00000000,0.000000000,0.00000000,0.00000000,0.00000000}
+	};
+
+	// The two heights in the order of their indices HR100km and HR300km
+	static const double height[2] = {100.0, 300.0};
+
+	double P[7][7][MAGFITBLOCK];		// The Associated Legendre function
+	double DP[7][7][MAGFITBLOCK];		// The derivative of P
+	double cosm[7][MAGFITBLOCK];		// cos(m*lng)
+	double sinm[7][MAGFITBLOCK];		// sin(m*lng)
+	double slat[MAGFITBLOCK];			// sin(lat)
+	double clat[MAGFITBLOCK];			// cos(lat)
+	double SUMZ[MAGFITBLOCK], SUMX[MAGFITBLOCK], SUMY[MAGFITBLOCK];
+	double Fz[2][MAGFITBLOCK], Fx[2][MAGFITBLOCK], Fy[2][MAGFITBLOCK];
+
+	double ARN[2][7];	// (R0/(R0 + height))^(N+2)
+	double AR;
+
+	int N, M;
+	int hr;		// Height index
+	int b;		// Start of the block
+	int nb;		// Number of control points in the block
+	int k;
+
+	for(hr=HR100km; hr<=HR300km; hr++) {
+		AR = R0/(R0+height[hr]);
+		for(N=1; N<=6; N++) {
+			ARN[hr][N] = pow(AR,(N+2));
+		}
+	}
+
+	for(b=0; b<n; b+=MAGFITBLOCK) {
+		nb = ((n - b) < MAGFITBLOCK) ? (n - b) : MAGFITBLOCK;
+
+		// As in magfit() the terms that the recurrences never set are zero
+		memset(P, 0, sizeof(P));
+		memset(DP, 0, sizeof(DP));
+
+		for(k=0; k<nb; k++) {
+			slat[k] = sin(here[b+k]->L.lat);
+			clat[k] = cos(here[b+k]->L.lat);
+			for(M=0; M<=6; M++) {
+				cosm[M][k] = cos(M*here[b+k]->L.lng);
+				sinm[M][k] = sin(M*here[b+k]->L.lng);
+			}
+			P[0][0][k] = 1.0;
+			for(hr=HR100km; hr<=HR300km; hr++) {
+				Fz[hr][k] = 0.0;
+				Fx[hr][k] = 0.0;
+				Fy[hr][k] = 0.0;
+			}
+		}
+
+		for(N=1; N<=6; N++) {
+			for(k=0; k<nb; k++) {
+				SUMZ[k] = 0.0;
+				SUMX[k] = 0.0;
+				SUMY[k] = 0.0;
+			}
+
+			for(M=0; M<=N; M++) {
+				if(N == M) {
+					for(k=0; k<nb; k++) {
+						P[M][N][k] = clat[k]*P[M-1][N-1][k];
+						DP[M][N][k] = clat[k]*DP[M-1][N-1][k]+slat[k]*P[M-1][N-1][k];
+					}
+				}
+				else if(N != 1) {
+					for(k=0; k<nb; k++) {
+						P[M][N][k] = slat[k]*P[M][N-1][k] - CT[M][N]*P[M][N-2][k];
+						DP[M][N][k] = slat[k]*DP[M][N-1][k]- clat[k]*P[M][N-1][k] - CT[M][N]*DP[M][N-2][k];
+					}
+				}
+				else {
+					for(k=0; k<nb; k++) {
+						P[M][N][k] = slat[k]*P[M][N-1][k];
+						DP[M][N][k] = slat[k]*DP[M][N-1][k]-clat[k]*P[M][N-1][k];
+					}
+				}
+
+				for(k=0; k<nb; k++) {
+					SUMZ[k] = SUMZ[k]+P[M][N][k]  *( G[M][N]*cosm[M][k]+H[M][N]*sinm[M][k]);
+					SUMX[k] = SUMX[k]+DP[M][N][k] *( G[M][N]*cosm[M][k]+H[M][N]*sinm[M][k]);
+					SUMY[k] = SUMY[k]+M*P[M][N][k]*( G[M][N]*sinm[M][k]-H[M][N]*cosm[M][k]);
+				}
+			}
+
+			for(hr=HR100km; hr<=HR300km; hr++) {
+				for(k=0; k<nb; k++) {
+					Fz[hr][k] = Fz[hr][k]+ARN[hr][N]*(N+1)*SUMZ[k];
+					Fx[hr][k] = Fx[hr][k]-ARN[hr][N]*SUMX[k];
+					Fy[hr][k] = Fy[hr][k]+ARN[hr][N]*SUMY[k];
+				}
+			}
+		}
+
+		for(k=0; k<nb; k++) {
+			for(hr=HR100km; hr<=HR300km; hr++) {
+				here[b+k]->dip[hr] = atan(Fz[hr][k]/sqrt(pow(Fx[hr][k],2) + pow((Fy[hr][k]/clat[k]),2)));
+				here[b+k]->fH[hr] = 2.8*sqrt(pow(Fx[hr][k],2)+pow((Fy[hr][k]/clat[k]),2)+pow(Fz[hr][k],2));
+			}
+		}
+	}
+
+}
@@ -27,7 +27,7 @@ void MedianAvailableReceiverPower(struct PathData *path) {
 	 			path->Ep - The path field strength at the given path->distance.
 	 
 			SUBROUTINE
-				AntennaGain()
+				AntennaPlanGain()
 				DominantMode()
 				AntennaGain08()
 	 
@@ -68,7 +68,7 @@ void MedianAvailableReceiverPower(struct PathData *path) {
 				   ((i != path->n0_E) && (path->Md_E[i].BMUF != 0.0))) {
 
 					// Find the receiver gain for this mode.
-					path->Md_E[i].Grw = AntennaGain(*path, path->A_rx, path->Md_E[i].ele, RXTOTX);
+					path->Md_E[i].Grw = AntennaPlanGain(&path->AP_rx, path->Md_E[i].ele);
 
 					path->Md_E[i].Prw = path->Md_E[i].Ew + path->Md_E[i].Grw 
 										- 20.0*log10(path->frequency) - 107.2;
@@ -86,7 +86,7 @@ void MedianAvailableReceiverPower(struct PathData *path) {
 					}
 
                     // Add this mode to the sum.
-					SumPr += pow(10.0, path->Md_E[i].Prw/10.0); 
+					SumPr += DB2RATIO(path->Md_E[i].Prw); 
 				}
             }
         }
@@ -98,7 +98,7 @@ void MedianAvailableReceiverPower(struct PathData *path) {
 													   ||
 				   ((i != path->n0_F2) && (path->Md_F2[i].BMUF != 0.0) && (path->Md_F2[i].fs < path->frequency))) {
 					// Find the receiver gain for this mode.
-					path->Md_F2[i].Grw = AntennaGain(*path, path->A_rx, path->Md_F2[i].ele, RXTOTX);
+					path->Md_F2[i].Grw = AntennaPlanGain(&path->AP_rx, path->Md_F2[i].ele);
 
 					path->Md_F2[i].Prw = path->Md_F2[i].Ew + path->Md_F2[i].Grw 
 										- 20.0*log10(path->frequency) - 107.2;
@@ -116,7 +116,7 @@ void MedianAvailableReceiverPower(struct PathData *path) {
 					}
 
                     // Add this mode to the sum.
-					SumPr += pow(10.0, path->Md_F2[i].Prw/10.0); 
+					SumPr += DB2RATIO(path->Md_F2[i].Prw); 
 				}
             }
         }
@@ -125,7 +125,7 @@ void MedianAvailableReceiverPower(struct PathData *path) {
 		// Find the total received power. 
 		// If the SumPr is 0 then set the path->Pr to something small
 		if((SumPr != 0.0) && (path->DMptr != NULL)) {
-			path->Pr = 10.0*log10(SumPr);
+			path->Pr = RATIO2DB(SumPr);
 			// The dominant mode is known so set any values in the path structure that are relevant.
 			DominantMode(path);
 		}
@@ -140,7 +140,7 @@ void MedianAvailableReceiverPower(struct PathData *path) {
 	}
 	else if((7000.0 < path->distance) && (path->distance < 9000.0)) {
 		// Determine the receiver gain.
-		Grw = AntennaGain08(*path, path->A_rx, RXTOTX, &elevation);
+		Grw = AntennaGain08(&path->AP_rx, &elevation);
 
 		// Use the interpolated power, Ei.
 		path->Pr = path->Ei + Grw - 20.0*log10(path->frequency) - 107.2;
@@ -157,7 +157,7 @@ void MedianAvailableReceiverPower(struct PathData *path) {
 	}
 	else { // path->distance >= 9000.0)
 		// Determine the receiver gain.
-		Grw = AntennaGain08(*path, path->A_rx, RXTOTX, &elevation);
+		Grw = AntennaGain08(&path->AP_rx, &elevation);
 
 		// Use the combined mode power, El, and the antenna gain between 0 and 8 degrees, Grw.
 		path->Pr = path->El + Grw - 20.0*log10(path->frequency) - 107.2;
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <assert.h>
 
 // Local includes
 #include "Common.h"
@@ -29,7 +30,29 @@
 #define SOUTH	1
 #define NORTH	0
 
+// Local structures
+// The 24-hour control point grid depends only on the transmitter, the receiver, the path distance, the month, the SSN,
+// the magnetic field flag and the ionospheric maps. It hangs off the path (path->LPgrid) between calls so that the hour and
+// frequency loops on a long path calculate it once.
+struct LongPathGrid {
+	struct PathData const *owner;	// The path the grid was allocated for (See AllocateLongPathGrid())
+	int valid;						// TRUE when the grid below is for the key below
+	// Key
+	struct Location L_tx;
+	struct Location L_rx;
+	double distance;
+	int month;
+	int SSN;
+	int MagField;
+	float const *ionmap;
+	// Grid
+	struct ControlPt CP[MAXCP][24];
+};
+// End local structures
+
 // Local prototypes
+int LongPathGridIsCurrent(struct PathData *path, struct LongPathGrid *grid);
+void FillLongPathGrid(struct PathData *path, struct LongPathGrid *grid, int nL, double dL, double dh90, int nM);
 void FindMUFsandfM(struct PathData *path, struct ControlPt CP[MAXCP][24], int hops, double dh);
 void FindfL(struct PathData *path, struct ControlPt CP[MAXCP][24], int hops, double dh, double ptick, double fH, double i90);
 double WinterAnomaly(double lat, int month);
@@ -66,17 +89,15 @@ void MedianSkywaveFieldStrengthLong(struct PathData *path) {
 	 
 	 		SUBROUTINES
 				ElevationAngle()
-				ZeroCP()
-				GreatCirclePoint()
-				CalculateCPParameters()
+				LongPathGridIsCurrent()
+				FillLongPathGrid()
 				AntennaGain08()
 				findfM()
 				findfL()
 
 	 */
 
-	int n, i, j;	// Temp
-	int hour;		// Temp
+	int n, i;		// Temp
 
 	// fL Calculation
 	int nL;				// Number of hops 
@@ -96,14 +117,16 @@ void MedianSkywaveFieldStrengthLong(struct PathData *path) {
 	double phi;			// 90 km penetration angle
 	double dh90;		// 90 km penetration distance
 
-	double fracd;		// fractional distance
 	double f;			// path->frequency
 	double Etl;			// Resultant median field strength
 	double D;			// Path distance for focus gain term
 
 	double elevation;	// Antenna elevation
 
-	struct ControlPt CP[MAXCP][24]; // Temp
+	struct LongPathGrid *grid;	// The 24-hour control point grid for the path
+	struct LongPathGrid local;	// The grid when the path doesn't own path->LPgrid
+
+	struct ControlPt (*CP)[24]; // The control points in grid
 
 	// Initialize variables
 	elevation = 2.0*PI;
@@ -185,61 +208,19 @@ void MedianSkywaveFieldStrengthLong(struct PathData *path) {
 	
 		dh90 = R0*phi;
 
-		// The path structure is used to determine the data at the control points 
-		// Store the path->hour
-		hour = path->hour;
-
-		for(j=0; j<24; j++) { // hours		
-
-			path->hour = j;
-
-			for(i=0; i <= nL; i++) { // 90-km penetration points 
-
-				// Zero the elements of the two control points
-				ZeroCP(&CP[2*i][j]);
-				ZeroCP(&CP[(2*i)+1][j]);
-
-				// There are two control points per hop.
-				// First the end nearest the tx for this hop.
-				fracd = (i*dL + dh90)/path->distance;
-				GreatCirclePoint(path->L_tx, path->L_rx, &CP[2*i][j], path->distance, fracd);
-				CalculateCPParameters(path, &CP[2*i][j]);
-
-				CP[2*i][j].hr = 90.0;
-			
-				// Next the end nearest to the receiver for this hop
-				fracd = ((i+1)*dL  - dh90)/path->distance;
-				GreatCirclePoint(path->L_tx, path->L_rx, &CP[(2*i)+1][j], path->distance, fracd);
-				CalculateCPParameters(path, &CP[(2*i)+1][j]);
-
-				CP[(2*i)+1][j].hr = 90.0;
-
-				} // (i=0; i < n; i++)
-
-			// Initialize control points (T + d0/2 & R - d0/2) from Table 1a) as the last two control points in the array.
-			// First determine the fractional distances and then find the point on the great circle between tx and rx.
-			fracd = (1.0/(2.0*(nM+1))); // T + d0/2 as a fraction of the total path length
-			GreatCirclePoint(path->L_tx, path->L_rx, &(CP[TdM2][j]), path->distance, fracd);
-			fracd = (1.0 - (1.0/(2.0*(nM+1)))); // R - d0/2 as a fraction of the total path length
-			GreatCirclePoint(path->L_tx, path->L_rx, &(CP[RdM2][j]), path->distance, fracd);
-			// All distances for the control points are relative to the tx.
-	
-			// Find foF2, M(3000)F2 and foE these control points.
-			CalculateCPParameters(path, &CP[TdM2][j]);
-			CalculateCPParameters(path, &CP[RdM2][j]);
-			
-			CP[TdM2][j].x = 0.0;
-			CP[TdM2][j].foE = 0.0;
-			CP[TdM2][j].hr = 300.0; // For this calculation the reflection height is fixed at 300 km.
-
-			CP[RdM2][j].x = 0.0;
-			CP[RdM2][j].foE = 0.0;
-			CP[RdM2][j].hr = 300.0; // For this calculation the reflection height is fixed at 300 km.
-		
-		} // (j=0; j<24; j++)
-
-		// Restore the path->hour
-		path->hour = hour;
+		// The grid that the path keeps is only calculated when the one from the last call is for a different path, month, SSN
+		// or maps. A path that doesn't own a grid, such as a copy made by assignment, calculates it every time.
+		if((path->LPgrid != NULL) && (path->LPgrid->owner == path)) {
+			grid = path->LPgrid;
+			if(LongPathGridIsCurrent(path, grid) != TRUE) {
+				FillLongPathGrid(path, grid, nL, dL, dh90, nM);
+			}
+		}
+		else {
+			grid = &local;
+			FillLongPathGrid(path, grid, nL, dL, dh90, nM);
+		}
+		CP = grid->CP;
 	
 	    /**********************************************************************
 		   End control point initialization for the reference frequencies.
@@ -253,7 +234,7 @@ void MedianSkywaveFieldStrengthLong(struct PathData *path) {
 		// Free space field strength
 		path->E0 = 139.6 - 20.0*log10(path->ptick);
 
-		path->Gtl = AntennaGain08(*path, path->A_tx, TXTORX, &elevation);
+		path->Gtl = AntennaGain08(&path->AP_tx, &elevation);
 
 		// Focusing on long distance gain limited to 15 dB
 		D = path->distance;
@@ -324,13 +305,13 @@ void MedianSkywaveFieldStrengthLong(struct PathData *path) {
 	
 			for(i=0; i <= nL; i++) { // 90-km penetration points 
 				printf("\nP533 MSFSL: Hop number (i) %d\n", i);
-				PrintControlPointData(CP[(2*i)][hour], 2*i, hour);
-				PrintControlPointData(CP[(2*i)+1][hour], (2*i)+1, hour);
+				PrintControlPointData(CP[(2*i)][path->hour], 2*i, path->hour);
+				PrintControlPointData(CP[(2*i)+1][path->hour], (2*i)+1, path->hour);
 			}
 
             printf("\nP533 MSFSL: Control Points (T + dM/2 & R - dM/2)\n");
-			PrintControlPointData(CP[TdM2][hour], TdM2, hour);
-			PrintControlPointData(CP[RdM2][hour], RdM2, hour);
+			PrintControlPointData(CP[TdM2][path->hour], TdM2, path->hour);
+			PrintControlPointData(CP[RdM2][path->hour], RdM2, path->hour);
 		
 			printf("\nP533 MSFSL: Incident angle (i90) %f\n", i90);
 			printf(  "P533 MSFSL: 90-km height half-hop angle (phi) %f\n", phi); 
@@ -348,6 +329,268 @@ void MedianSkywaveFieldStrengthLong(struct PathData *path) {
 }
 
 
+void FillLongPathGrid(struct PathData *path, struct LongPathGrid *grid, int nL, double dL, double dh90, int nM) {
+
+	/*
+
+	  FillLongPathGrid() - Determines the 24 hours of data at the 90 km penetration points and at the control points
+			T + dM/2 and R - dM/2 from Table 1a) P.533-12 for MedianSkywaveFieldStrengthLong() and saves the key that the
+			grid was made for.
+
+			INPUT
+				struct PathData *path
+				struct LongPathGrid *grid
+				int nL - Number of hops for the fL calculation
+				double dL - Hop distance for the fL calculation
+				double dh90 - 90-km height half-hop distance
+				int nM - Number of hops for the fM calculation
+
+			OUTPUT
+				grid->CP[MAXCP][24]
+				The key in grid
+
+			SUBROUTINES
+				ZeroCP()
+				SolarTime()
+				GreatCirclePoint()
+				CalculateCPIonosphereBatch()
+				MagfitBatch()
+				MagGridBatch()
+
+	 */
+
+	struct ControlPt *mf[MAXCP];	// The control points for CalculateCPIonosphereBatch() and MagfitBatch()
+
+	int cp[MAXCP];	// Indices of the control points in use
+
+	struct SolarParameters Sun;	// Temp
+
+	int i, j;		// Temp
+	int hour;		// Temp
+	int n;			// Number of control points
+
+	double fracd;	// fractional distance
+
+	struct ControlPt (*CP)[24] = grid->CP;
+
+	grid->valid = FALSE;
+
+	// The path structure is used to determine the data at the control points 
+	// Store the path->hour and the solar terms for it
+	hour = path->hour;
+	Sun = path->Sun;
+
+	// The control points in use. A path of more than 39000 km has 14 hops (nL = 13) and 28 penetration points, so the
+	// last two penetration points share the slots of T + dM/2 and R - dM/2 and are given their data, as they always were.
+	n = 0;
+	for(i=0; i < 2*(nL+1); i++) cp[n++] = i;
+	if(n <= TdM2) {
+		cp[n++] = TdM2;
+		cp[n++] = RdM2;
+	}
+	assert(n <= MAXCP);
+
+	for(j=0; j<24; j++) { // hours		
+
+		path->hour = j;
+		SolarTime(&path->Sun, path->month, (double)path->hour);
+
+		for(i=0; i <= nL; i++) { // 90-km penetration points 
+
+			// Zero the elements of the two control points
+			ZeroCP(&CP[2*i][j]);
+			ZeroCP(&CP[(2*i)+1][j]);
+
+			// There are two control points per hop.
+			// First the end nearest the tx for this hop.
+			fracd = (i*dL + dh90)/path->distance;
+			GreatCirclePoint(path->L_tx, path->L_rx, &CP[2*i][j], path->distance, fracd);
+
+			CP[2*i][j].hr = 90.0;
+		
+			// Next the end nearest to the receiver for this hop
+			fracd = ((i+1)*dL  - dh90)/path->distance;
+			GreatCirclePoint(path->L_tx, path->L_rx, &CP[(2*i)+1][j], path->distance, fracd);
+
+			CP[(2*i)+1][j].hr = 90.0;
+
+			} // (i=0; i < n; i++)
+
+		// Initialize control points (T + d0/2 & R - d0/2) from Table 1a) as the last two control points in the array.
+		// First determine the fractional distances and then find the point on the great circle between tx and rx.
+		fracd = (1.0/(2.0*(nM+1))); // T + d0/2 as a fraction of the total path length
+		GreatCirclePoint(path->L_tx, path->L_rx, &(CP[TdM2][j]), path->distance, fracd);
+		fracd = (1.0 - (1.0/(2.0*(nM+1)))); // R - d0/2 as a fraction of the total path length
+		GreatCirclePoint(path->L_tx, path->L_rx, &(CP[RdM2][j]), path->distance, fracd);
+		// All distances for the control points are relative to the tx.
+
+		// Find foF2, M(3000)F2 and foE at all of the control points for the hour at once.
+		for(i=0; i<n; i++) mf[i] = &CP[cp[i]][j];
+		CalculateCPIonosphereBatch(path, mf, n);
+		
+		CP[TdM2][j].x = 0.0;
+		CP[TdM2][j].foE = 0.0;
+		CP[TdM2][j].hr = 300.0; // For this calculation the reflection height is fixed at 300 km.
+
+		CP[RdM2][j].x = 0.0;
+		CP[RdM2][j].foE = 0.0;
+		CP[RdM2][j].hr = 300.0; // For this calculation the reflection height is fixed at 300 km.
+	
+	} // (j=0; j<24; j++)
+
+	// The control points are in the same place every hour, so the gyrofrequency and magnetic dip are found once for all of
+	// them and copied to the other hours.
+	for(i=0; i<n; i++) mf[i] = &CP[cp[i]][0];
+	if(path->MagField == MAGFIELDGRID) {
+		MagGridBatch(mf, n);
+	}
+	else {
+		MagfitBatch(mf, n);
+	}
+
+	for(i=0; i<n; i++) {
+		for(j=1; j<24; j++) {
+			CP[cp[i]][j].dip[HR100km] = CP[cp[i]][0].dip[HR100km];
+			CP[cp[i]][j].dip[HR300km] = CP[cp[i]][0].dip[HR300km];
+			CP[cp[i]][j].fH[HR100km] = CP[cp[i]][0].fH[HR100km];
+			CP[cp[i]][j].fH[HR300km] = CP[cp[i]][0].fH[HR300km];
+		}
+	}
+
+	// Restore the path->hour and the solar terms
+	path->hour = hour;
+	path->Sun = Sun;
+
+	// Save the key for this grid
+	grid->L_tx = path->L_tx;
+	grid->L_rx = path->L_rx;
+	grid->distance = path->distance;
+	grid->month = path->month;
+	grid->SSN = path->SSN;
+	grid->MagField = path->MagField;
+	grid->ionmap = path->ionmap;
+	grid->valid = TRUE;
+
+	return;
+
+}
+
+int LongPathGridIsCurrent(struct PathData *path, struct LongPathGrid *grid) {
+
+	/*
+
+	  LongPathGridIsCurrent() - Determines if the 24-hour control point grid is for this path, month, SSN and maps
+
+			INPUT
+				struct PathData *path
+				struct LongPathGrid *grid
+
+			OUTPUT
+				returns TRUE if the grid can be used for the path, otherwise FALSE
+
+			SUBROUTINES
+				None
+
+	 */
+
+	if((grid->valid == TRUE) &&
+	   (grid->L_tx.lat == path->L_tx.lat) && (grid->L_tx.lng == path->L_tx.lng) &&
+	   (grid->L_rx.lat == path->L_rx.lat) && (grid->L_rx.lng == path->L_rx.lng) &&
+	   (grid->distance == path->distance) &&
+	   (grid->month == path->month) && (grid->SSN == path->SSN) &&
+	   (grid->MagField == path->MagField) &&
+	   (grid->ionmap == path->ionmap)) {
+		return TRUE;
+	}
+
+	return FALSE;
+
+}
+
+int AllocateLongPathGrid(struct PathData *path) {
+
+	/*
+
+	  AllocateLongPathGrid() - Gives the path a 24-hour control point grid of its own to keep between calls to
+			MedianSkywaveFieldStrengthLong()
+
+			INPUT
+				struct PathData *path
+
+			OUTPUT
+				path->LPgrid
+				returns RTN_ALLOCATEP533OK or RTN_ERRALLOCATELPGRID
+
+			SUBROUTINES
+				None
+
+	 */
+
+	path->LPgrid = (struct LongPathGrid *) malloc(sizeof(struct LongPathGrid));
+	if(path->LPgrid == NULL) return RTN_ERRALLOCATELPGRID;
+
+	path->LPgrid->owner = path;
+	path->LPgrid->valid = FALSE;
+
+	return RTN_ALLOCATEP533OK;
+
+}
+
+void FreeLongPathGrid(struct PathData *path) {
+
+	/*
+
+	  FreeLongPathGrid() - Frees the grid from AllocateLongPathGrid(). A copy of the path that doesn't own the grid leaves
+			it alone.
+
+			INPUT
+				struct PathData *path
+
+			OUTPUT
+				path->LPgrid is NULL
+
+			SUBROUTINES
+				None
+
+	 */
+
+	if((path->LPgrid != NULL) && (path->LPgrid->owner == path)) {
+		free(path->LPgrid);
+	}
+	path->LPgrid = NULL;
+
+	return;
+
+}
+
+DLLEXPORT void ForgetLongPathGrid(struct PathData *path) {
+
+	/*
+
+	  ForgetLongPathGrid() - Makes the next long path calculation on the path find its 24-hour control point grid again.
+			The grid is made again by itself when the transmitter, receiver, month, SSN, magnetic field flag or map block
+			(path->ionmap) changes. Call this when the ionospheric maps in the block have been changed in place for the
+			same month.
+
+			INPUT
+				struct PathData *path
+
+			OUTPUT
+				path->LPgrid
+
+			SUBROUTINES
+				None
+
+	 */
+
+	if((path->LPgrid != NULL) && (path->LPgrid->owner == path)) {
+		path->LPgrid->valid = FALSE;
+	}
+
+	return;
+
+}
+
 void FindMUFsandfM(struct PathData *path, struct ControlPt CP[MAXCP][24], int hops, double dM) {
 
 	(void)hops; // To avoid unused parameter warning
@@ -529,11 +772,11 @@ void FindMUFsandfM(struct PathData *path, struct ControlPt CP[MAXCP][24], int ho
         // Determine the MUF deciles
 		decile = DL; // Lower MUF decile
 		// Find the deltal in the foF2var array
-		deltal = FindfoF2var(*path, CP[smallerCP][path->hour].ltime, CP[smallerCP][path->hour].L.lat, decile);
+		deltal = FindfoF2var(path, CP[smallerCP][path->hour].ltime, CP[smallerCP][path->hour].L.lat, decile);
 				
 		decile = DU; // Upper MUF decile
 		// Find the deltau in the foF2var array
-		deltau = FindfoF2var(*path, CP[smallerCP][path->hour].ltime, CP[smallerCP][path->hour].L.lat, decile);
+		deltau = FindfoF2var(path, CP[smallerCP][path->hour].ltime, CP[smallerCP][path->hour].L.lat, decile);
 
 		// Determine the decile MUFs
 		path->MUF50 = path->BMUF;
@@ -754,7 +997,7 @@ double WinterAnomaly(double lat, int month) {
 	}
 }
 
-double AntennaGain08(struct PathData path, struct Antenna Ant, int direction, double * elevation) {
+double AntennaGain08(struct AntennaPlan const *AP, double * elevation) {
 
 
 	/*
@@ -766,20 +1009,20 @@ double AntennaGain08(struct PathData path, struct Antenna Ant, int direction, do
 			antenna gain determined by the proceedure would be less than 3 degrees. 
 
 			INPUT
-				struct PathData path
-				struct Antenna Ant
-				int direction
+				struct AntennaPlan const *AP - The antenna towards the other end of the path (path->AP_tx or path->AP_rx)
+				double *elevation
 
 			OUTPUT
+				elevation - The elevation of the largest gain
 				largest antenna gain in the range 0 to 8 degrees elevation
 
 			SUBROUTINES
-				AntennaGain()
+				AntennaPlanGain()
 
 	*/
 
 
-	// The structure Antenna Ant is used to tell the subroutine which antenna to calculate.
+	// The plan is used to tell the subroutine which antenna to calculate.
 
 	double G, Gmax;
 	double delta; // Elevation angle
@@ -791,7 +1034,7 @@ double AntennaGain08(struct PathData path, struct Antenna Ant, int direction, do
 	Gmax = TINYDB;
 	for(i=0; i<9; i++) {
 		delta = ((double)i)*D2R;
-		G = AntennaGain(path, Ant, delta, direction);
+		G = AntennaPlanGain(AP, delta);
 		if( G > Gmax) {
 			Gmax = G;
 			*elevation = i*D2R;
@@ -22,14 +22,14 @@
 // End Local Defines
 
 // Local prototypes
-double DiurnalAbsorptionExponent(struct ControlPt CP, int month); 
-double AbsorptionFactor(struct ControlPt CP, int month);
+double DiurnalAbsorptionExponent(struct ControlPt const *CP, int month); 
+double AbsorptionFactor(struct ControlPt const *CP, int month);
 double AbsorptionLayerPenetrationFactor(double T);
-double AbsorptionTerm(struct ControlPt CP, int month, double fv);
-double FindLh(struct ControlPt CP, double dh, int hour, int month);
+double AbsorptionTerm(struct ControlPt const *CP, int month, double fv);
+double FindLh(struct ControlPt const *CP, double dh, int hour, int month);
 double PenetrationPoints(struct PathData * path, double noh, double hr, double fv);
 int WhatSeasonforLh(struct Location L, int month); 
-int SmallestCPfoF2(struct PathData path);
+int SmallestCPfoF2(struct PathData const *path);
 // End local prototypes
  
 void MedianSkywaveFieldStrengthShort(struct PathData *path) {
@@ -61,7 +61,7 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 				IncidenceAngle()
 				AbsorptionTerm()
 				FindLh()
-				AntennaGain()
+				AntennaPlanGain()
 
 	 */
 
@@ -111,7 +111,7 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 	// Use hr_F2 in this routine for readability
 	if(path->distance > path->dmax) { // Note the path->distance is less than 9000 and path->distance is greater than dmax
 		// Find the smallest foF2 amongst the control points  
-		hr_F2 = MIN((1490.0/path->CP[SmallestCPfoF2(*path)].M3kF2) - 176.0, 500.0);
+		hr_F2 = MIN((1490.0/path->CP[SmallestCPfoF2(path)].M3kF2) - 176.0, 500.0);
 	}
 	else { // (path->distance <= path->dmax)
 		// Use the midpoint to determine the mirror reflection height
@@ -167,14 +167,14 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 					else {
 						// Find the loss due to all the absorption terms in Li
 						// The absorption term includes loss from solar zenith angles, ATnoon and phin(fv/foE)
-						AT = AbsorptionTerm(path->CP[MP], path->month, fv);
+						AT = AbsorptionTerm(&path->CP[MP], path->month, fv);
 					}
 
                     // Determine the longitudinal gyrofrequency
 					fL = fabs(path->CP[MP].fH[HR100km]*sin(path->CP[MP].dip[HR100km])); 
 
 					// Determine auroral and other signal losses
-					Lh = FindLh(path->CP[MP], dh, mpltime, path->month);
+					Lh = FindLh(&path->CP[MP], dh, mpltime, path->month);
 				}
 				else { // (path->distance > 2000.0) There are three control points
 
@@ -184,9 +184,9 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 					else {				
 						// Find the loss due to all the absorption terms in Li
 						// The absorption term includes loss from solar zenith angles, ATnoon and phin(fv/foE)
-						AT = (AbsorptionTerm(path->CP[MP], path->month, fv) +
-							  AbsorptionTerm(path->CP[T1k], path->month, fv) +
-							  AbsorptionTerm(path->CP[R1k], path->month, fv))/3.0;
+						AT = (AbsorptionTerm(&path->CP[MP], path->month, fv) +
+							  AbsorptionTerm(&path->CP[T1k], path->month, fv) +
+							  AbsorptionTerm(&path->CP[R1k], path->month, fv))/3.0;
 					}
 
                     // Determine the average longitudinal gyrofrequency
@@ -195,9 +195,9 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 						  fabs(path->CP[R1k].fH[HR100km]*sin(path->CP[R1k].dip[HR100km])))/3.0;
 
 					// Determine auroral and other signal losses
-					Lh = (FindLh(path->CP[MP], dh, mpltime, path->month) +
-						  FindLh(path->CP[T1k], dh, mpltime, path->month) +
-						  FindLh(path->CP[R1k], dh, mpltime, path->month))/3.0;
+					Lh = (FindLh(&path->CP[MP], dh, mpltime, path->month) +
+						  FindLh(&path->CP[T1k], dh, mpltime, path->month) +
+						  FindLh(&path->CP[R1k], dh, mpltime, path->month))/3.0;
 				} // (path->distance <= 2000.0)
 	
 				// All the variable have been calculated to determine
@@ -222,7 +222,7 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 				path->Md_E[n].Lb = 32.45 + 20.0*log10(path->frequency) + 20.0*log10(path->ptick) + Li + Lm + Lg + Lh + path->Lz;
 
 				// Tx antenna gain in the desired direction (dB)
-				Gt = AntennaGain(*path, path->A_tx, delta, TXTORX);
+				Gt = AntennaPlanGain(&path->AP_tx, delta);
 
 				// Transmit power
 				Pt = path->txpower;
@@ -306,14 +306,14 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 					else {
 						// Find the loss due to all the absorption terms in Li
 						// The absorption term includes loss from solar zenith angles, ATnoon and phin(fv/foE)
-						AT = AbsorptionTerm(path->CP[MP], path->month, fv);
+						AT = AbsorptionTerm(&path->CP[MP], path->month, fv);
 					}
 
                     // Determine the longitudinal gyrofrequency
 					fL = fabs(path->CP[MP].fH[HR100km]*sin(path->CP[MP].dip[HR100km])); 
 					
 					// Determine auroral and other signal losses
-					Lh = FindLh(path->CP[MP], dh, mpltime, path->month);
+					Lh = FindLh(&path->CP[MP], dh, mpltime, path->month);
 				}
 				else if((2000.0 < path->distance) && (path->distance <= path->dmax)) { // There are three control points
 
@@ -323,9 +323,9 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 					else {
 						// Find the loss due to all the absorption terms in Li
 						// The absorption term includes loss from solar zenith angles, ATnoon and phin(fv/foE)
-						AT = (AbsorptionTerm(path->CP[MP], path->month, fv) +
-							  AbsorptionTerm(path->CP[T1k], path->month, fv) +
-							  AbsorptionTerm(path->CP[R1k], path->month, fv))/3.0;
+						AT = (AbsorptionTerm(&path->CP[MP], path->month, fv) +
+							  AbsorptionTerm(&path->CP[T1k], path->month, fv) +
+							  AbsorptionTerm(&path->CP[R1k], path->month, fv))/3.0;
 					}
 
                     // Determine the average longitudinal gyrofrequency
@@ -334,9 +334,9 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 						  fabs(path->CP[R1k].fH[HR100km]*sin(path->CP[R1k].dip[HR100km])))/3.0;
 
 					// Determine auroral and other signal losses
-					Lh = (FindLh(path->CP[MP], dh, mpltime, path->month) +
-						  FindLh(path->CP[T1k], dh, mpltime, path->month) +
-						  FindLh(path->CP[R1k], dh, mpltime, path->month))/3.0;
+					Lh = (FindLh(&path->CP[MP], dh, mpltime, path->month) +
+						  FindLh(&path->CP[T1k], dh, mpltime, path->month) +
+						  FindLh(&path->CP[R1k], dh, mpltime, path->month))/3.0;
 				}
 				else { // There are 5 control points.
 
@@ -346,11 +346,11 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 					else {
 						// Find the loss due to all the absorption terms in Li.
 						// The absorption term includes loss from solar zenith angles, ATnoon and phin(fv/foE)
-						AT = (AbsorptionTerm(path->CP[MP], path->month, fv)   +
-							  AbsorptionTerm(path->CP[T1k], path->month, fv)  +
-							  AbsorptionTerm(path->CP[R1k], path->month, fv)  +
-							  AbsorptionTerm(path->CP[Td02], path->month, fv) +
-							  AbsorptionTerm(path->CP[Rd02], path->month, fv))/5.0;
+						AT = (AbsorptionTerm(&path->CP[MP], path->month, fv)   +
+							  AbsorptionTerm(&path->CP[T1k], path->month, fv)  +
+							  AbsorptionTerm(&path->CP[R1k], path->month, fv)  +
+							  AbsorptionTerm(&path->CP[Td02], path->month, fv) +
+							  AbsorptionTerm(&path->CP[Rd02], path->month, fv))/5.0;
 					}
 
                     // Find the average longitudinal gyrofrequency
@@ -361,11 +361,11 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 						  fabs(path->CP[Rd02].fH[HR100km]*sin(path->CP[Rd02].dip[HR100km])))/5.0;
 					
 					// Determine auroral and other signal losses
-					Lh = (FindLh(path->CP[MP], dh, mpltime, path->month)  +
-						  FindLh(path->CP[T1k], dh, mpltime, path->month) +
-						  FindLh(path->CP[R1k], dh, mpltime, path->month) +
-						  FindLh(path->CP[Td02], dh, mpltime, path->month)+
-						  FindLh(path->CP[Rd02], dh, mpltime, path->month))/5.0;
+					Lh = (FindLh(&path->CP[MP], dh, mpltime, path->month)  +
+						  FindLh(&path->CP[T1k], dh, mpltime, path->month) +
+						  FindLh(&path->CP[R1k], dh, mpltime, path->month) +
+						  FindLh(&path->CP[Td02], dh, mpltime, path->month)+
+						  FindLh(&path->CP[Rd02], dh, mpltime, path->month))/5.0;
 				} // (path->distance <= 2000.0)
 
 				// All the variable have been calculated to determine
@@ -395,7 +395,7 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 				path->Md_F2[n].Lb = 32.45 + 20.0*log10(path->frequency) + 20.0*log10(path->ptick) + Li + Lm + Lg + Lh + path->Lz;
 
 				// Tx antenna gain in the desired direction (dB)
-				Gt = AntennaGain(*path, path->A_tx, delta, TXTORX);
+				Gt = AntennaPlanGain(&path->AP_tx, delta);
 
 				Pt = path->txpower;
 
@@ -444,7 +444,7 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 			if(((n == path->n0_E) && (path->distance/(path->n0_E+1) <= 2000.0))
 					                            ||
 				((n != path->n0_E) && (path->Md_E[n].BMUF != 0.0))) { 
-				Etw += pow(10.0, (path->Md_E[n].Ew/10.0));
+				Etw += DB2RATIO(path->Md_E[n].Ew);
 				path->Md_E[n].MC = TRUE;
 			}
         }
@@ -459,7 +459,7 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 			if(((n == path->n0_F2) && (path->distance/(path->n0_F2+1) <= path->dmax) && (path->Md_F2[n].fs < path->frequency)) 
 				                                ||
 				((n != path->n0_F2) && (path->Md_F2[n].BMUF != 0.0) && (path->Md_F2[n].fs < path->frequency))) {
-			Etw += pow(10.0, (path->Md_F2[n].Ew/10.0));
+			Etw += DB2RATIO(path->Md_F2[n].Ew);
 			path->Md_F2[n].MC = TRUE;
 			}
 			// Testing
@@ -489,7 +489,7 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
     // Find the field strength if there are any modes to consider
 	// If there are no modes than path->Es will remain equal to TINYDB 
 	if(Etw != 0.0) {
-		path->Es = 10.0*log10(Etw); // Field strength with E layer screening
+		path->Es = RATIO2DB(Etw); // Field strength with E layer screening
 	}
 	else { // All the modes have been screened 
 		// Testing
@@ -509,7 +509,7 @@ void MedianSkywaveFieldStrengthShort(struct PathData *path) {
 } // End Median Sky-wave Field Strength 
 
 
-double AbsorptionTerm(struct ControlPt CP, int month, double fv) {
+double AbsorptionTerm(struct ControlPt const *CP, int month, double fv) {
 
 	/*
 
@@ -522,7 +522,7 @@ double AbsorptionTerm(struct ControlPt CP, int month, double fv) {
 	 		three factors
 	 
 	 		INPUT
-	 			struct ControlPt CP - the Control point of interest
+	 			struct ControlPt const *CP - the Control point of interest
 	 			int month - The month index
 	 			double fv - Vertical-incidence wave frequency
 	 
@@ -556,21 +556,21 @@ double AbsorptionTerm(struct ControlPt CP, int month, double fv) {
 
 	// The solar zenith angle for the control point
 	// Make sure that it doesn't exceed 102 degrees
-	chij = min(CP.Sun.sza, 102.0*D2R);
+	chij = min(CP->Sun.sza, 102.0*D2R);
 
 	Fchij = max(pow(cos(0.881*chij), p), 0.02);
 
 	// Determine when noon is local time, then find the solar zenith angle.
 	// To make this calculation, a temporary control point must be used 
 	// where the only variable necessary to initialize is the longitude.
-	CP_0 = CP;
+	CP_0 = *CP;
 	// The hour that gets passed to SolarParameters() is a UTC fractional hour 
 	// The local noon in UTC has already been calculated and stored by execution 
 	// CalculateCPParameters()
 	// The month is in the path structure thus: 
 	// The hour for this calculation is CP[].Sun.lsn and
 	// the month for this calculation is path->month.
-	SolarParameters(&CP_0, month, CP.Sun.lsn);
+	SolarParameters(&CP_0, month, CP->Sun.lsn);
 
 	// The solar zenith angle for the control point at noon local time.
 	chijnoon = CP_0.Sun.sza;
@@ -580,11 +580,11 @@ double AbsorptionTerm(struct ControlPt CP, int month, double fv) {
 	// Find the remaining absorption parameters.
 	ATnoon = AbsorptionFactor(CP, month);
 
-	phin = AbsorptionLayerPenetrationFactor(fv/CP.foE);
+	phin = AbsorptionLayerPenetrationFactor(fv/CP->foE);
 
 	// Testing
 	if(BARF) {
-		printf("\nMSFSS: Control Point CP.L.lat %f CP.L.lng %f\n", CP.L.lat, CP.L.lng);
+		printf("\nMSFSS: Control Point CP.L.lat %f CP.L.lng %f\n", CP->L.lat, CP->L.lng);
 		printf("MSFSS: Absorption term (ATnoon*phin*Fchij/Fchijnoon) %f\n", ATnoon*phin*Fchij/Fchijnoon);
 		printf("MSFSS: ATnoon %f\n", ATnoon);
 		printf("MSFSS: phin %f\n", phin);
@@ -597,7 +597,7 @@ double AbsorptionTerm(struct ControlPt CP, int month, double fv) {
 }
 
 
-double DiurnalAbsorptionExponent(struct ControlPt CP, int month) {
+double DiurnalAbsorptionExponent(struct ControlPt const *CP, int month) {
 
 	/*
 
@@ -606,7 +606,7 @@ double DiurnalAbsorptionExponent(struct ControlPt CP, int month) {
 	 		The p vs magnetic dip angle graph is shown as Figure 3 ITU-R P.533-12.
 	 
 	 		INPUT
-	 			struct ControlPt CP - control point of interest
+	 			struct ControlPt const *CP - control point of interest
 	 			int month - month index	
 	 
 	 		OUTPUT
@@ -691,13 +691,13 @@ double DiurnalAbsorptionExponent(struct ControlPt CP, int month) {
     p = 0.0;
 
 	// Initialize the modified magnetic dip angle (degrees)
-	moddip = fabs(atan2(CP.dip[HR100km], sqrt(cos(CP.L.lat))));
+	moddip = fabs(atan2(CP->dip[HR100km], sqrt(cos(CP->L.lat))));
     
 	if(moddip > 70.0*D2R) { 
 		moddip = 70.0*D2R;
 	}
     
-	if(CP.L.lat < 0.0) {
+	if(CP->L.lat < 0.0) {
 		month = month + 6;
 		if(month > 11) month = month - 12;
 	}
@@ -729,7 +729,7 @@ double DiurnalAbsorptionExponent(struct ControlPt CP, int month) {
 
     // Testing
 	if(BARF) {
-		printf("\nMSFSS: p %f CP.L.lat %f CP.L.lng %f \n", p, CP.L.lat, CP.L.lng);
+		printf("\nMSFSS: p %f CP->L.lat %f CP->L.lng %f \n", p, CP->L.lat, CP->L.lng);
 	}
     // Testing
 
@@ -737,14 +737,14 @@ double DiurnalAbsorptionExponent(struct ControlPt CP, int month) {
 		
 	}
 
-double AbsorptionFactor(struct ControlPt CP, int month) {
+double AbsorptionFactor(struct ControlPt const *CP, int month) {
 
 	/*
 
 	  AbsorptionFactor() Calculates the absorption factor ATnoon as shown Figure 1 ITU-R P.533-12 
 	 
 	 		INPUT
-	 			struct ControlPt CP - Control point of interest
+	 			struct ControlPt const *CP - Control point of interest
 	 			int month - month index	
 	 
 	 		OUTPUT
@@ -839,7 +839,7 @@ double AbsorptionFactor(struct ControlPt CP, int month) {
 			break;	
 	}
 
-    X = fabs(CP.L.lat*R2D);
+    X = fabs(CP->L.lat*R2D);
 	if(X >= 70.0) X = 69.99; // This is for the (int) casting of X so that j is not >= 28.
 	X = X/2.5; 
 	j = (int)X;
@@ -906,13 +906,13 @@ double AbsorptionLayerPenetrationFactor(double T) {
 }
 
 
-double FindLh(struct ControlPt CP, double dh, int hour, int month) {
+double FindLh(struct ControlPt const *CP, double dh, int hour, int month) {
 
 	/*	
 	 *	FindLh() - Finds the value of Lh from Table 2 ITU-R P.533-12 "Values of Lh giving auroral and other signal losses".
 	 *
 	 *		INPUT
-	 *			struct ControlPt CP
+	 *			struct ControlPt const *CP
 	 *			double dh - hop distance
 	 *			int hour - hour index
 	 *			int month - month index
@@ -1024,10 +1024,10 @@ double FindLh(struct ControlPt CP, double dh, int hour, int month) {
 	Gn.lng = 0.0;
 
 	// Find the geomagnetic coordinates for location of the control point.
-	GeomagneticCoords(CP.L, &Gn);
+	GeomagneticCoords(CP->L, &Gn);
 
 	// Determine the season index for the Lh array.
-	season = WhatSeasonforLh(CP.L, month);
+	season = WhatSeasonforLh(CP->L, month);
 
 	// Lh[Transmission range][season][geomagnetic latitude][mid-path local time]
 	// Determine the indices
@@ -1098,7 +1098,7 @@ double FindLh(struct ControlPt CP, double dh, int hour, int month) {
 	
 	// Testing
 	if(BARF) {
-		printf(  "\nMSFSS: Lh[%d][%d][%d][%d] %f CP.L.lat %f CP.L.lng %f \n", txrange, season, gmlat, mplt, Lh[txrange][season][gmlat][mplt], CP.L.lat, CP.L.lng);
+		printf(  "\nMSFSS: Lh[%d][%d][%d][%d] %f CP.L.lat %f CP.L.lng %f \n", txrange, season, gmlat, mplt, Lh[txrange][season][gmlat][mplt], CP->L.lat, CP->L.lng);
 		printf("MSFSS: Geomag Lat %f (deg)\n", Gn.lat*R2D);
 		printf("MSFSS: MidPath hour %d\n", hour);
 	}
@@ -1156,14 +1156,14 @@ int WhatSeasonforLh(struct Location L, int month) {
 	
 }
 
-int SmallestCPfoF2(struct PathData path) {
+int SmallestCPfoF2(struct PathData const *path) {
 
 	/*
 	 
 	 	SmallestCPfoF2() - Determines the smallest Control point foF2
 	 
 	 		INPUT
-	 			struct PathData path
+	 			struct PathData const *path
 	 
 	 		OUTPUT
 				returns the index to the control point with the smallest foF2
@@ -1181,7 +1181,7 @@ int SmallestCPfoF2(struct PathData path) {
 	// Sort by brute force
 	for(i=0; i<5; i++) {
 		for(j=0; j<5; j++) {
-			if(path.CP[idx[i]].foF2 > path.CP[idx[j]].foF2) { 
+			if(path->CP[idx[i]].foF2 > path->CP[idx[j]].foF2) { 
 				temp = idx[i]; 
 				idx[i] = idx[j]; 
 				idx[j] = temp; 
@@ -1198,35 +1198,90 @@ int SmallestCPfoF2(struct PathData path) {
 
 }
 
-double AntennaGain(struct PathData path, struct Antenna Ant, double delta, int direction) {
+double AntennaGain(struct PathData const *path, struct Antenna const *Ant, double delta, int direction) {
 
 	/*
-		AntennaGain() - Finds the antenna gain at the desired elevation, delta
+		AntennaGain() - Finds the antenna gain at the desired elevation, delta. This works out the bearing and the pattern
+			columns for each call. P533() uses the plans path->AP_tx and path->AP_rx with AntennaPlanGain() instead.
 
 	 		INPUT
-	 			struct PathData path
-				struct Antenna Ant
+	 			struct PathData const *path
+				struct Antenna const *Ant
 				double delta
+				int direction - TXTORX or RXTOTX
 
 	 		OUTPUT
 				returns the interpolated antenna gain at the desired elevation, delta
 
 			SUBROUTINES
 				Bearing()
-				BilinearInterpolation()
+				PlanAntenna()
+				AntennaPlanGain()
 
 	*/
 
+	struct AntennaPlan AP;
 
-	// The structure Antenna Ant is used to tell the subroutine which antenna to calculate.
-	//Initialise to prevent warning C4701: potentially uninitialized local variable 'B' used
-	double B = 0.0;			// Bearing from transmitter to receiver
-	double c;				// fractional column (azimuth)
-	double r;				// fractional row (elevation)
-	double LL, LR, UR, UL;	// Neighboring gain values
-	double G;				// Interpolated gain
+	// Determine the bearing
+	// From the tx to rx.
+	AP.B = 0.0;
+	if (direction == TXTORX) {
+		AP.B = Bearing(path->L_tx, path->L_rx, path->SorL)*R2D; // degrees
+	}
+	else if (direction == RXTOTX) {
+		AP.B = Bearing(path->L_rx, path->L_tx, path->SorL)*R2D; // degrees
+	}
+
+	PlanAntenna(&AP, Ant, path->frequency);
+
+	return AntennaPlanGain(&AP, delta);
+
+}
+
+void PlanAntennas(struct PathData *path) {
+
+	/*
+		PlanAntennas() - Resolves the pattern columns of the transmitter and receiver antennas for path->frequency. The
+			bearings path->AP_tx.B and path->AP_rx.B must have been found by InitializePath().
+
+	 		INPUT
+	 			struct PathData *path
+
+	 		OUTPUT
+				path->AP_tx
+				path->AP_rx
+
+			SUBROUTINES
+				PlanAntenna()
+
+	*/
+
+	PlanAntenna(&path->AP_tx, &path->A_tx, path->frequency);
+	PlanAntenna(&path->AP_rx, &path->A_rx, path->frequency);
+
+}
+
+void PlanAntenna(struct AntennaPlan *AP, struct Antenna const *Ant, double frequency) {
+
+	/*
+		PlanAntenna() - Finds the pattern for the frequency closest to the operating frequency and the two azimuth columns
+			either side of the bearing AP->B, so that AntennaPlanGain() only has to interpolate in elevation
+
+	 		INPUT
+	 			struct AntennaPlan *AP - With the bearing AP->B (degrees)
+				struct Antenna const *Ant
+				double frequency - Operating frequency (MHz)
+
+	 		OUTPUT
+				AP->c
+				AP->L
+				AP->R
+
+			SUBROUTINES
+				None
+
+	*/
 
-	int deltaL, deltaU;		// Upper and lower elevation indices
 	int BL, BR;				// Left and right bearing indices
 
   int i, freqIndex;
@@ -1234,63 +1289,73 @@ double AntennaGain(struct PathData path, struct Antenna Ant, double delta, int d
   
   freqIndex = 0;
   /* If we have pattern data for multiple frequencies, find the index of the
-   * frequency closest to the path.frequency.
+   * frequency closest to the path->frequency.
    */
-  if (Ant.freqn > 1) {
+  if (Ant->freqn > 1) {
     minFreqDelta = DBL_MAX;
-    for (i=0; i<Ant.freqn; i++) {
-      freqDelta = fabs(Ant.freqs[i] - path.frequency);
+    for (i=0; i<Ant->freqn; i++) {
+      freqDelta = fabs(Ant->freqs[i] - frequency);
       if (freqDelta < minFreqDelta) {
         minFreqDelta = freqDelta;
         freqIndex = i;
       }
     }
   }
-  
-	// The elevations and azimuths have to be in degrees because the antenna pattern is indexed in degrees.
 
-	// delta is in radians convert to degrees
-	delta = delta*R2D;
+	// The bearing might wrap around. The pattern is stored unrotated so offset the bearing by the main beam azimuth.
+	BR = ((int)ceil(AP->B) - Ant->rotation + 360)%360;
+	BL = ((int)floor(AP->B) - Ant->rotation + 360)%360;
 
-	// Determine the bearing
-	// From the tx to rx.
-	if (direction == TXTORX) {
-		B = Bearing(path.L_tx, path.L_rx, path.SorL)*R2D; // degrees
-	}
-	else if (direction == RXTOTX) {
-		B = Bearing(path.L_rx, path.L_tx, path.SorL)*R2D; // degrees
+	// The distance between azimuth indices is fixed at 1 degree.
+	AP->c = AP->B - (int)AP->B;	// The fractional part of the column
+
+	// An antenna that hasn't been read has no pattern
+	if (Ant->pattern == NULL) {
+		AP->L = NULL;
+		AP->R = NULL;
+		return;
 	}
 
-	// Now determine the gain at the elevation, delta
+	AP->L = Ant->pattern[freqIndex][BL];
+	AP->R = Ant->pattern[freqIndex][BR];
+
+}
+
+double AntennaPlanGain(struct AntennaPlan const *AP, double delta) {
+
+	/*
+		AntennaPlanGain() - Finds the antenna gain at the desired elevation, delta, from the columns resolved by PlanAntenna()
+
+	 		INPUT
+	 			struct AntennaPlan const *AP
+				double delta - Elevation (radians)
+
+	 		OUTPUT
+				returns the interpolated antenna gain at the desired elevation, delta
+
+			SUBROUTINES
+				BilinearInterpolation()
+
+	*/
+
+	double r;				// fractional row (elevation)
+
+	int deltaL, deltaU;		// Upper and lower elevation indices
+
+	// The elevations have to be in degrees because the antenna pattern is indexed in degrees.
+
+	// delta is in radians convert to degrees
+	delta = delta*R2D;
+
 	// Find the indices to determine the neighbors for the gain interpolation.
 	deltaU = (int)ceil(delta);
 	deltaL = (int)floor(delta);
 
-	// The bearing might wrap around.
-	BR = (int)ceil(B)%360;
-	BL = (int)floor(B)%360;
-
-	// Identify the neighbors.
-	LL = Ant.pattern[freqIndex][BL][deltaL];
-	LR = Ant.pattern[freqIndex][BR][deltaL];
-	UL = Ant.pattern[freqIndex][BL][deltaU];
-	UR = Ant.pattern[freqIndex][BR][deltaU];
-
-	// Determine the fractional column and row.
 	// The distance between indices is fixed at 1 degree.
 	r = delta - (int)delta; // The fractional part of the row
-	c = B - (int)B;			// The fractional part of the column
 
-	G = BilinearInterpolation(LL, LR, UL, UR, r, c);
-
-	/*
-	printf("\nPath freq: %.3fMHz Pattern.freq: %.3fMHz (Index = %d)\n", path.frequency, Ant.freqs[freqIndex], freqIndex);
-	printf("Bearing: %.3f deg Elevation: %.3fdeg\n", B, delta);
-	printf("LL:%.3f LR: %.3f UL: %.3f UR: %.3f\n", LL, LR, UL, UR);
-	printf("Gain:%.3f\n", G);
-	*/
-	
-	return G;
+	// Interpolate between the neighbors LL, LR, UL and UR.
+	return BilinearInterpolation(AP->L[deltaL], AP->R[deltaL], AP->L[deltaU], AP->R[deltaU], r, AP->c);
 
 }
 
@@ -1393,7 +1458,7 @@ double PenetrationPoints(struct PathData * path, double noh, double hr, double f
  
  		// Calculate the absortion term for the ith hop penetration point
  		// closest to the transmitter and add it to the running absoption term sum	
- 		ATSum += AbsorptionTerm(PP[TXEND], path->month, fv);
+ 		ATSum += AbsorptionTerm(&PP[TXEND], path->month, fv);
  			
  		// Next the end nearest to the receiver for this hop
  		fracd = ((i+1)*dh  - dh90)/path->distance;
@@ -1404,7 +1469,7 @@ double PenetrationPoints(struct PathData * path, double noh, double hr, double f
  
  		// Calculate the absortion term for the ith hop penetration point
  		// closest to the receiver and add it to the running absoption term sum	
- 		ATSum += AbsorptionTerm(PP[RXEND], path->month, fv);
+ 		ATSum += AbsorptionTerm(&PP[RXEND], path->month, fv);
 
 
  		}
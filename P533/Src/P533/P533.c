@@ -84,8 +84,10 @@
 				struct PathData *path
 
 			SUBROUTINES
+				BindP372()
 				ValidatePath()
-				InitializePath()
+				InitializeCircuit()
+				P533Engine()
 				MUFBasic()
 				MUFVariability()
 				MUFOperational()
@@ -158,42 +160,11 @@
 
 	int retval; // return value
 
-	// Load the Noise routines in P372.dll ******************************
-	#ifdef _WIN32
-		// Get the handle to the P372 DLL.
-		hLib = LoadLibrary("P372.dll");
-		if (hLib == NULL) {
-			printf("P533: Error %d P372.DLL Not Found\n", RTN_ERRP372DLL);
-			return RTN_ERRP372DLL;
-		}
-		int mod[512];
-		// Get the handle to the DLL library, hLib.
-		GetModuleFileName((HMODULE)hLib, (LPTSTR)mod, 512);
-		// Get the P372Version() process from the DLL.
-		dllP372Version = (cP372Info)GetProcAddress((HMODULE)hLib, "P372Version");
-		// Get the P372CompileTime() process from the DLL.
-		dllP372CompileTime = (cP372Info)GetProcAddress((HMODULE)hLib, "P372CompileTime");
-
-		dllNoise = (iNoise)GetProcAddress((HMODULE)hLib, "Noise");
-		dllAllocateNoiseMemory = (iNoiseMemory)GetProcAddress((HMODULE)hLib, "AllocateNoiseMemory");
-		dllFreeNoiseMemory = (iNoiseMemory)GetProcAddress((HMODULE)hLib, "FreeNoiseMemory");
-		dllInitializeNoise = (vInitializeNoise)GetProcAddress((HMODULE)hLib, "InitializeNoise");
-	#elif __linux__ || __APPLE__
-		void * hLib;
-		hLib = dlopen("libp372.so", RTLD_NOW);
-		if (!hLib) {
-			printf("Couldn't load libp372.so, exiting.\n");
-			exit(1);
-		}
-		dllP372Version = dlsym(hLib, "P372Version");
-		dllP372CompileTime = dlsym(hLib, "P372CompileTime");
-		dllNoise = dlsym(hLib, "Noise");
-		dllAllocateNoiseMemory = dlsym(hLib, "AllocateNoiseMemory");
-		dllFreeNoiseMemory = dlsym(hLib, "FreeNoiseMemory");
-		dllInitializeNoise = dlsym(hLib, "InitializeNoise");
-	#endif	
-		
-	// End P372.DLL Load ************************************************
+	// Bind the Noise routines in P372.dll *****************************
+	// This is only done on the first call to P533() in this process
+	retval = BindP372();
+	if (retval != RTN_P372BOUNDOK) return retval;
+	// End P372.DLL Bind ************************************************
 	
 	// Before moving on load the version and compile time of the P372.DLL
 	path->P372ver = dllP372Version();
@@ -203,6 +174,60 @@
 	retval = ValidatePath(path);
 	if(retval != RTN_VALIDDATAOK) return retval; // check that the input parameters are correct
 
+	InitializeCircuit(path);
+
+	return P533Engine(path);
+
+}
+
+int P533Engine(struct PathData *path) {
+
+	/*
+
+		P533Engine() - Does the calculation for P533() once the P372 routines are bound, the input data has been validated
+			and InitializeCircuit() has been run. P533() and P533Batch() both call it.
+
+			INPUT
+				struct PathData *path
+
+			OUTPUT
+				struct PathData *path
+				returns RTN_P533OK or the error from dllNoise()
+
+			SUBROUTINES
+				FrequencyIndependent()
+				FrequencyDependent()
+
+	*/
+
+	FrequencyIndependent(path);
+
+	return FrequencyDependent(path);
+
+}
+
+void FrequencyIndependent(struct PathData *path) {
+
+	/*
+
+		FrequencyIndependent() - The part of the P533() calculation that depends only on the geometry, month, hour and SSN.
+			It finds the control points and their ionospheric parameters, and the MUFs of the modes. P533Prepare() saves the
+			result so that FrequencyDependent() can be run for any number of frequencies without repeating this part.
+
+			INPUT
+				struct PathData *path
+
+			OUTPUT
+				struct PathData *path
+
+			SUBROUTINES
+				InitializePath()
+				MUFBasic()
+				MUFVariability()
+				MUFOperational()
+
+	*/
+
 	// Calculate the distances between rx and tx, find the midpoint of the path, find the midpoint distance and initialize the path 
 	// This will aso determine the ionospheric parameters for 3 of the potential 5 control points.
 	InitializePath(path);
@@ -227,12 +252,51 @@
 	// Control points if necessary. 
 	MUFBasic(path);
 
-	// Determine Fprob for each mode and the path the 50% MUF (MUF50), 90% MUF (MUF90) and the 10% MUF (MUF10)
+	// Determine for each mode and the path the 50% MUF (MUF50), 90% MUF (MUF90) and the 10% MUF (MUF10)
 	MUFVariability(path);
 
 	// Determine the for each mode and the path the operational MUF (OPMUF), 90% OPMUF (OPMUF90) and the 10% OPOMUF (OPMUF10)
 	MUFOperational(path);
 
+	return;
+
+}
+
+int FrequencyDependent(struct PathData *path) {
+
+	/*
+
+		FrequencyDependent() - The part of the P533() calculation that depends on path->frequency. FrequencyIndependent() must
+			have been run on the path first.
+
+			INPUT
+				struct PathData *path
+
+			OUTPUT
+				struct PathData *path
+				returns RTN_P533OK or the error from dllNoise()
+
+			SUBROUTINES
+				PlanAntennas()
+				MUFProbability()
+				ELayerScreeningFrequency()
+				MedianSkywaveFieldStrengthShort()
+				MedianSkywaveFieldStrengthLong()
+				Between7000kmand9000km()
+				MedianAvaiableReceiverPower()
+				dllNoise()
+				CircuitReliability()
+
+	*/
+
+	int retval; // return value
+
+	// Resolve the antenna pattern columns for the frequency
+	PlanAntennas(path);
+
+	// Determine Fprob for each mode
+	MUFProbability(path);
+
 	// E Layer Screening Frequency is determine contingent on the path length
 	ELayerScreeningFrequency(path);
 
@@ -268,6 +332,188 @@
 	return RTN_P533OK;  // Return no errors
 }
 
+DLLEXPORT int P533Prepare(struct PathData *path) {
+
+	/*
+
+		P533Prepare() - Validates the path and does the part of the P533() calculation that does not depend on the frequency.
+			Use this with P533Frequency() to sweep a path over many frequencies. The control points, their ionospheric
+			parameters and the MUFs are found once here instead of once for each frequency. The path must be set up as it would
+			be for P533(), including a valid path->frequency, which is used for the validation and for the noise.
+
+			The noise at the receiver is found here for path->frequency. This fills path->noiseP.famcache with the atmospheric
+			noise at 1 MHz, which does not depend on the frequency. P533Frequency() copies the cache with the rest of the
+			prepared path, so the Fam1MHz series are summed once for the receiver rather than once for each frequency.
+
+			INPUT
+				struct PathData *path
+
+			OUTPUT
+				struct PathData *path - Ready to be passed to P533Frequency() as prepared
+				returns RTN_P533OK or the error from BindP372(), ValidatePath() or dllNoise()
+
+			SUBROUTINES
+				BindP372()
+				ValidatePath()
+				InitializeCircuit()
+				FrequencyIndependent()
+				dllNoise()
+
+	*/
+
+	int retval; // return value
+
+	// Bind the Noise routines in P372.dll *****************************
+	retval = BindP372();
+	if (retval != RTN_P372BOUNDOK) return retval;
+	// End P372.DLL Bind ************************************************
+
+	path->P372ver = dllP372Version();
+	path->P372compt = dllP372CompileTime();
+
+	// Validate the input data
+	retval = ValidatePath(path);
+	if (retval != RTN_VALIDDATAOK) return retval;
+
+	InitializeCircuit(path);
+
+	FrequencyIndependent(path);
+
+	// Fill the Fam cache for the receiver and the hour
+	retval = dllNoise(&path->noiseP, path->hour, path->L_rx.lng, path->L_rx.lat, path->frequency);
+	if (retval != RTN_NOISEOK) return retval;
+
+	return RTN_P533OK;
+
+}
+
+DLLEXPORT int P533Frequency(struct PathData *path, struct PathData const *prepared, double frequency) {
+
+	/*
+
+		P533Frequency() - Finishes the P533() calculation for one frequency from a path that has been through P533Prepare().
+			The prepared path is copied to path and is not changed, so it can be used for any number of frequencies. The
+			result in path is the same as P533() would give for the prepared path at this frequency. If path and prepared
+			are the same structure the calculation is done in place and the path has to be prepared again for the next frequency.
+
+			INPUT
+				struct PathData const *prepared - The path from P533Prepare()
+				double frequency - Operating frequency (MHz)
+
+			OUTPUT
+				struct PathData *path
+				returns RTN_P533OK, RTN_ERRFREQUENCY or the error from dllNoise()
+
+			SUBROUTINES
+				FrequencyDependent()
+
+	*/
+
+	if ((1.0 > frequency) || frequency > 30.0)	return RTN_ERRFREQUENCY;
+
+	if (path != prepared) *path = *prepared;
+	path->frequency = frequency;
+
+	return FrequencyDependent(path);
+
+}
+
+DLLEXPORT int P533Batch(struct PathData *path, struct Location const *L_rx, int n, struct BatchResults *res) {
+
+	/*
+
+		P533Batch() - Runs P533() for one transmitter and an array of receivers. Everything in the path other than the receiver
+			location is the same for every receiver: the month, hour, SSN, frequency, transmitter, antennas, system parameters and data.
+			The results are written to the arrays in the structure BatchResults, one element for each receiver.
+
+			The P372 version lookup, the validation of the inputs common to all of the receivers and InitializeCircuit() are done
+			once, and the one path is reused as the workspace for every receiver. Only the receiver location is validated for each
+			receiver. Everything else, from the control points on, depends on the receiver location, so the time saved is small
+			and P533Batch() takes about as long as calling P533() for each receiver.
+
+			The caller allocates the arrays in res, each with at least n elements. Any array pointer in res that is NULL is not filled,
+			so the caller only needs to allocate the parameters it wants. For a receiver that fails, every array other than res->rtn
+			is set to TOOBIG.
+
+			INPUT
+				struct PathData *path - Set up as it would be for P533() except for path->L_rx
+				struct Location const *L_rx - The n receiver locations (radians)
+				int n - Number of receivers
+				struct BatchResults *res
+
+			OUTPUT
+				res->rtn[i] - RTN_P533OK or the error for receiver i
+				The calculated parameters for receiver i in res, or TOOBIG if res->rtn[i] isn't RTN_P533OK
+				path - Is left as the calculated path for the last receiver
+				returns RTN_P533OK or the error for the inputs that are common to all of the receivers
+
+			SUBROUTINES
+				BindP372()
+				ValidateCircuit()
+				InitializeCircuit()
+				ValidateReceiver()
+				P533Engine()
+
+	*/
+
+	int retval; // return value
+	int i;
+
+	// Bind the Noise routines in P372.dll *****************************
+	retval = BindP372();
+	if (retval != RTN_P372BOUNDOK) return retval;
+	// End P372.DLL Bind ************************************************
+
+	path->P372ver = dllP372Version();
+	path->P372compt = dllP372CompileTime();
+
+	// Validate the input data that is common to all of the receivers
+	retval = ValidateCircuit(path);
+	if (retval != RTN_VALIDDATAOK) return retval;
+
+	// The setup that doesn't depend on the receiver
+	InitializeCircuit(path);
+
+	for (i = 0; i < n; i++) {
+		retval = ValidateReceiver(L_rx[i]);
+		if (retval == RTN_VALIDDATAOK) {
+			path->L_rx = L_rx[i];
+			retval = P533Engine(path);
+		}
+
+		if (res->rtn != NULL)		res->rtn[i] = retval;
+
+		if (retval == RTN_P533OK) {
+			if (res->distance != NULL)	res->distance[i] = path->distance;
+			if (res->BMUF != NULL)		res->BMUF[i] = path->BMUF;
+			if (res->MUF50 != NULL)		res->MUF50[i] = path->MUF50;
+			if (res->OPMUF != NULL)		res->OPMUF[i] = path->OPMUF;
+			if (res->Ep != NULL)		res->Ep[i] = path->Ep;
+			if (res->Pr != NULL)		res->Pr[i] = path->Pr;
+			if (res->SNR != NULL)		res->SNR[i] = path->SNR;
+			if (res->SNRXX != NULL)		res->SNRXX[i] = path->SNRXX;
+			if (res->BCR != NULL)		res->BCR[i] = path->BCR;
+			if (res->OCR != NULL)		res->OCR[i] = path->OCR;
+		}
+		else {
+			// There is no result for this receiver
+			if (res->distance != NULL)	res->distance[i] = TOOBIG;
+			if (res->BMUF != NULL)		res->BMUF[i] = TOOBIG;
+			if (res->MUF50 != NULL)		res->MUF50[i] = TOOBIG;
+			if (res->OPMUF != NULL)		res->OPMUF[i] = TOOBIG;
+			if (res->Ep != NULL)		res->Ep[i] = TOOBIG;
+			if (res->Pr != NULL)		res->Pr[i] = TOOBIG;
+			if (res->SNR != NULL)		res->SNR[i] = TOOBIG;
+			if (res->SNRXX != NULL)		res->SNRXX[i] = TOOBIG;
+			if (res->BCR != NULL)		res->BCR[i] = TOOBIG;
+			if (res->OCR != NULL)		res->OCR[i] = TOOBIG;
+		}
+	}
+
+	return RTN_P533OK;
+
+}
+
 DLLEXPORT char const * P533Version(void) {
 
 	/*
@@ -310,6 +556,27 @@ DLLEXPORT char const * P533CompileTime(void) {
 
 }
 
+DLLEXPORT int P533DataLayout(void) {
+
+	/*
+
+	  P533DataLayout() - Returns the version of the layout of the data arrays in struct PathData (See P533DATALAYOUT)
+	 
+	 		INPUT
+	 			None
+	 
+	 		OUTPUT
+	 			returns P533DATALAYOUT
+
+			SUBROUTINES
+				None
+	 
+	 */
+
+	return P533DATALAYOUT;
+
+}
+
 DLLEXPORT int sizeofPathDataStruct(void) {
 	/*
 		sizeofPathStruct() - Returns the sizeof(pathdata) for testing.
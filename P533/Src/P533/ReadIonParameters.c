@@ -8,6 +8,27 @@
 #include "P533.h"
 // End local includes
 
+// Local defines
+#define IONTXTBUFFER	(1 << 20)	// Bytes read from a text map file at a time
+#define IONTXTFIELD		64			// A field in a text map file must be shorter than this
+// End local defines
+
+// Local structures
+struct IonTxtStream {
+	FILE *fp;
+	char *buf;		// IONTXTBUFFER bytes and a terminator
+	size_t pos;		// Next unread byte in buf
+	size_t len;		// Bytes in buf
+	int eof;		// TRUE once the whole file is in buf
+	long line;		// Line number of the byte at pos for messages
+};
+// End local structures
+
+// Local prototypes
+char const *NextIonField(struct IonTxtStream *ts, size_t *len);
+int ParseIonFloat(char const *s, size_t len, float *value);
+// End local prototypes
+
 /*
  * These routines use the ionospheric data from the monthly median parameter maps that are generated internally to the REC533() 
  * program. It is hoped that the routines in this program which use ionospheric maps can then take advantage of more contemporary 
@@ -45,33 +66,14 @@ int ReadIonParametersTxt(struct PathData *path, char DataFilePath[256], int sile
 	 *		OUTPUT
 	 *			Data is read into the arrays foF2 and M3kF2
 	 *
+	 *		SUBROUTINES
+	 *			ReadIonParametersTxtFile()
+	 *
 	 */
 
-	#ifdef __GNUC__
-	#pragma GCC diagnostic push
-	#pragma GCC diagnostic ignored "-Wunused-result"
-	#endif
-
-	int		j, k, m;
-	int		/*hrs,*/ lng, lat, ssn; // Temp gridmap maxima
-
-	int linelen = 300;
-	char line[300];
-
 	char InFilePath[256];
 	char MapFile[32];
-	
-	FILE *fp;
-	
-	// At present the path structure is not used but is passed in so that it can select the correct map file based on month
 
-	// The dimensions of the array are fixed by Suessman's file generating program "iongrid"
-	// Eventually it would be nice if these were not fixed values so that other resolutions could be used. 
-	//hrs = 24;	// 24 hours
-	lng = 241;	// 241 longitudes at 1.5-degree increments
-	lat = 121;	// 121 latitudes at 1.5-degree increments
-	ssn = 2;	// 2 SSN (12-month smoothed sun spot numbers) high and low
-	
 	// This may require error handling at some point.
 	// Eventually you want the file that is indicated by GUIConfig to be opened.
 	strcpy(InFilePath, DataFilePath);
@@ -79,79 +81,375 @@ int ReadIonParametersTxt(struct PathData *path, char DataFilePath[256], int sile
 	//strcat(InFilePath, "ionmap/TXT/");
 	sprintf(MapFile, "ionos%02d.txt", path->month+1);
 	strcat(InFilePath, MapFile);
-	fp = fopen(InFilePath, "r"); 
-	//fp = fopen("..\\..\\ionmap\\ionos04.txt", "r"); 
-	if(fp == NULL) {
+
+	return ReadIonParametersTxtFile(InFilePath, path->foF2, path->M3kF2, silent);
+}
+
+int ReadIonParametersTxtFile(char const *InFilePath, float ****foF2, float ****M3kF2, int silent) {
+	/*
+	 * ReadIonParametersTxtFile() reads the text ionospheric parameter file InFilePath into the arrays foF2 and M3kF2 (See
+	 *		ReadIonParametersTxt()). The file can have any name so updated maps from elsewhere can be read as well.
+	 *
+	 *	The file is all of foF2 followed by all of M3kF2. Each is ordered by SSN, then longitude, then latitude with the 24
+	 *	hours for each grid point over six lines. The numbers are read as a stream of fields separated by white space, so
+	 *	the way the fields are split over lines does not matter. The file is read through a large buffer and the fields are
+	 *	converted by ParseIonFloat() rather than by sscanf(). This is many times faster, does not depend on the locale and
+	 *	gives exactly the float that sscanf() "%f" would.
+	 *
+	 *		INPUT
+	 *			char const *InFilePath - The text file
+	 *			int silent
+	 *
+	 *		OUTPUT
+	 *			Data is read into the arrays foF2 and M3kF2
+	 *			returns RTN_READIONPARAOK, RTN_ERRREADIONPARAMETERS or RTN_ERRPARSEIONPARAMETERS
+	 *
+	 *		SUBROUTINES
+	 *			NextIonField()
+	 *			ParseIonFloat()
+	 *
+	 */
+
+	struct IonTxtStream ts;
+
+	float ****map;
+
+	int		i, j, k, m, n;
+	int		hrs, lng, lat, ssn; // Temp gridmap maxima
+
+	char const *field;
+	size_t len;
+
+	// The dimensions of the array are fixed by Suessman's file generating program "iongrid"
+	hrs = 24;	// 24 hours
+	lng = 241;	// 241 longitudes at 1.5-degree increments
+	lat = 121;	// 121 latitudes at 1.5-degree increments
+	ssn = 2;	// 2 SSN (12-month smoothed sun spot numbers) high and low
+
+	ts.fp = fopen(InFilePath, "rb");
+	if(ts.fp == NULL) {
 		printf("ReadIonParameters: ERROR Can't find input file %s\n", InFilePath);
 		return RTN_ERRREADIONPARAMETERS;
 	}
 
-    if(silent != TRUE) {
-		printf("ReadIonParameters: Reading file ionos%02d.txt for ionospheric parameters\n", path->month+1);
-		printf("ReadIonParameters: Reading foF2 into array\n");
+	ts.buf = (char *) malloc(IONTXTBUFFER + 1);
+	if(ts.buf == NULL) {
+		fclose(ts.fp);
+		return RTN_ERRREADIONPARAMETERS;
 	}
+	ts.pos = 0;
+	ts.len = 0;
+	ts.eof = FALSE;
+	ts.line = 1;
 
-    // Read in foF2
-	for(m = 0; m < ssn; m++) { // SSN
-		for(j = 0; j < lng; j++) { // Longitude
-			for(k = 0; k < lat; k++) { // Latitude
-				// Read 24 hours of data from the Dambolt/Seussman ionospheric atlas file.
-				// There are six lines for 24 hours.
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->foF2[0][j][k][m], &path->foF2[1][j][k][m], &path->foF2[2][j][k][m],                 
-					                                 &path->foF2[3][j][k][m], &path->foF2[4][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->foF2[5][j][k][m], &path->foF2[6][j][k][m],&path->foF2[7][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->foF2[8][j][k][m], &path->foF2[9][j][k][m], &path->foF2[10][j][k][m],
-					                                 &path->foF2[11][j][k][m], &path->foF2[12][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->foF2[13][j][k][m], &path->foF2[14][j][k][m], &path->foF2[15][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->foF2[16][j][k][m], &path->foF2[17][j][k][m], &path->foF2[18][j][k][m],
-					                                 &path->foF2[19][j][k][m], &path->foF2[20][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->foF2[21][j][k][m],&path->foF2[22][j][k][m],&path->foF2[23][j][k][m]);
+	if(silent != TRUE) {
+		printf("ReadIonParameters: Reading file %s for ionospheric parameters\n", InFilePath);
+	}
+
+	// foF2 then M3kF2
+	for(n = 0; n < 2; n++) {
+		map = (n == 0) ? foF2 : M3kF2;
+		for(m = 0; m < ssn; m++) { // SSN
+			for(j = 0; j < lng; j++) { // Longitude
+				for(k = 0; k < lat; k++) { // Latitude
+					// 24 hours of data from the Dambolt/Seussman ionospheric atlas file
+					for(i = 0; i < hrs; i++) { // Hour
+						field = NextIonField(&ts, &len);
+						if((field == NULL) || (ParseIonFloat(field, len, &map[i][j][k][m]) != TRUE)) {
+							printf("ReadIonParameters: ERROR %s line %ld: %s\n", InFilePath, ts.line,
+								(field == NULL) ? "Too few values" : "Invalid value");
+							free(ts.buf);
+							fclose(ts.fp);
+							return RTN_ERRPARSEIONPARAMETERS;
+						}
+					}
+				}
 			}
-        }
-    }
+		}
+	}
 
-    if(silent != TRUE) {
-		printf("ReadIonParameters: Reading M3kF2 into array\n");
+	// Close the file and return.
+	free(ts.buf);
+	fclose(ts.fp);
+
+	return RTN_READIONPARAOK;
+}
+
+char const *NextIonField(struct IonTxtStream *ts, size_t *len) {
+	/*
+	 * NextIonField() returns the next white space delimited field of the text stream. The buffer is refilled whenever
+	 *		less than IONTXTFIELD bytes are left in it, so a field is never split across two reads. The field is
+	 *		followed in the buffer by at least one character that is not part of it.
+	 *
+	 *		INPUT
+	 *			struct IonTxtStream *ts
+	 *
+	 *		OUTPUT
+	 *			len - Length of the field
+	 *			returns a pointer to the field in the buffer or NULL at the end of the file
+	 *
+	 */
+
+	char *p, *end;
+
+	for(;;) {
+		// Top up the buffer so the next field is complete
+		if(((ts->len - ts->pos) < IONTXTFIELD) && (ts->eof != TRUE)) {
+			memmove(ts->buf, ts->buf + ts->pos, ts->len - ts->pos);
+			ts->len -= ts->pos;
+			ts->pos = 0;
+			ts->len += fread(ts->buf + ts->len, 1, IONTXTBUFFER - ts->len, ts->fp);
+			if(ts->len < IONTXTBUFFER) ts->eof = TRUE;
+			ts->buf[ts->len] = '\0';
+		}
+
+		p = ts->buf + ts->pos;
+		end = ts->buf + ts->len;
+
+		// Skip the white space
+		while((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\n') || (*p == '\r'))) {
+			if(*p == '\n') ts->line++;
+			p++;
+		}
+		ts->pos = (size_t)(p - ts->buf);
+
+		if(p == end) {
+			if(ts->eof == TRUE) return NULL;
+			continue;
+		}
+		// A field that starts close to the end of the buffer may not be complete
+		if(((size_t)(end - p) < IONTXTFIELD) && (ts->eof != TRUE)) continue;
+
+		break;
 	}
 
-    // Read in M3kF2
-	for(m = 0; m < ssn; m++) { // SSN
-		for(j = 0; j < lng; j++) { // Longitude
-			for(k = 0; k < lat; k++) { // Latitude
-				// Read 24 hours of data from the Dambolt/Seussman ionospheric atlas file.
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->M3kF2[0][j][k][m], &path->M3kF2[1][j][k][m], &path->M3kF2[2][j][k][m],
-					                                 &path->M3kF2[3][j][k][m], &path->M3kF2[4][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->M3kF2[5][j][k][m], &path->M3kF2[6][j][k][m], &path->M3kF2[7][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->M3kF2[8][j][k][m],  &path->M3kF2[9][j][k][m], &path->M3kF2[10][j][k][m],
-					                                 &path->M3kF2[11][j][k][m], &path->M3kF2[12][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->M3kF2[13][j][k][m], &path->M3kF2[14][j][k][m], &path->M3kF2[15][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->M3kF2[16][j][k][m], &path->M3kF2[17][j][k][m], &path->M3kF2[18][j][k][m], 
-					                                 &path->M3kF2[19][j][k][m], &path->M3kF2[20][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->M3kF2[21][j][k][m], &path->M3kF2[22][j][k][m], &path->M3kF2[23][j][k][m]);
+	while((p < end) && (*p != ' ') && (*p != '\t') && (*p != '\n') && (*p != '\r')) p++;
+
+	*len = (size_t)(p - (ts->buf + ts->pos));
+	ts->pos = (size_t)(p - ts->buf);
+
+	return ts->buf + ts->pos - *len;
+}
+
+int ParseIonFloat(char const *s, size_t len, float *value) {
+	/*
+	 * ParseIonFloat() converts a decimal field such as "-12.345" or "1.5E+01" to a float without sscanf() or the locale.
+	 *		The digits are gathered into an integer mantissa and the power of ten is applied in double. With at most 15
+	 *		significant digits the mantissa is exact in double. If the number has no more than 8 digits after the point, or
+	 *		is an exact integer in double, rounding that double to float gives the correctly rounded float, which is what
+	 *		sscanf() "%f" gives. Anything else, which iongrid never writes, is converted with strtod() and strtof().
+	 *
+	 *		INPUT
+	 *			char const *s - The field, which must be followed by a character that is not part of a number
+	 *			size_t len - Length of the field
+	 *
+	 *		OUTPUT
+	 *			value - The number
+	 *			returns TRUE or FALSE if the field is not a number
+	 *
+	 */
+
+	// Exact powers of ten in double
+	static double const pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+	char const *p, *end;
+	char tmp[IONTXTFIELD];
+
+	unsigned long long mant;	// Mantissa digits
+	int digits;					// Significant digits in mant
+	int scale;					// Power of ten to apply to mant
+	int expo, esign;			// Exponent field
+	int neg;
+	int any;					// There was a digit in the mantissa
+	int exact;					// mant and scale give the correctly rounded float
+
+	double x;
+
+	// A field this long may have been split by NextIonField()
+	if(len >= IONTXTFIELD) return FALSE;
+
+	p = s;
+	end = s + len;
+	mant = 0;
+	digits = 0;
+	scale = 0;
+	any = FALSE;
+	exact = TRUE;
+
+	neg = FALSE;
+	if((*p == '-') || (*p == '+')) {
+		neg = (*p == '-');
+		p++;
+	}
+
+	// Integer part
+	while((*p >= '0') && (*p <= '9')) {
+		any = TRUE;
+		if(digits < 15) {
+			mant = mant*10 + (unsigned long long)(*p - '0');
+			if(mant != 0) digits++;
+		}
+		else {
+			scale++;
+			if(*p != '0') exact = FALSE;
+		}
+		p++;
+	}
+
+	// Fractional part
+	if(*p == '.') {
+		p++;
+		while((*p >= '0') && (*p <= '9')) {
+			any = TRUE;
+			if(digits < 15) {
+				mant = mant*10 + (unsigned long long)(*p - '0');
+				if(mant != 0) digits++;
+				scale--;
 			}
-        }
-    }
+			else if(*p != '0') {
+				exact = FALSE;
+			}
+			p++;
+		}
+	}
 
-    // Close the file and return.
-	fclose(fp);
+	if(any != TRUE) return FALSE;
+
+	// Exponent
+	if((*p == 'e') || (*p == 'E')) {
+		p++;
+		esign = 1;
+		if((*p == '-') || (*p == '+')) {
+			if(*p == '-') esign = -1;
+			p++;
+		}
+		if((*p < '0') || (*p > '9')) return FALSE;
+		expo = 0;
+		while((*p >= '0') && (*p <= '9')) {
+			if(expo < 10000) expo = expo*10 + (*p - '0');
+			p++;
+		}
+		scale += esign*expo;
+	}
 
-	return RTN_READIONPARAOK;
+	if(p != end) return FALSE;
+
+	if(exact == TRUE) {
+		if(mant == 0) {
+			x = 0.0;
+		}
+		else if((scale < 0) && (scale >= -8)) {
+			x = (double)mant/pow10[-scale];
+		}
+		else if((scale >= 0) && (scale <= 22) && ((double)mant*pow10[scale] < 9007199254740992.0)) { // 2^53
+			x = (double)mant*pow10[scale];
+		}
+		else {
+			exact = FALSE;
+		}
+	}
 
-	#ifdef __GNUC__
-	#pragma GCC diagnostic pop
-	#endif
+	if(exact != TRUE) {
+		// Not a case that the fast path gets right so let the C library do it
+		memcpy(tmp, s, len);
+		tmp[len] = '\0';
+		*value = strtof(tmp, NULL);
+		return TRUE;
+	}
+
+	*value = (float)(neg ? -x : x);
+
+	return TRUE;
+}
+
+int WriteIonParametersBin(int month, float ****foF2, float ****M3kF2, char DataFilePath[256], int silent) {
+	/*
+	 * WriteIonParametersBin() writes the arrays foF2 and M3kF2 to the binary file ionosXX.bin in the layout that
+	 *		ReadIonParametersBin() reads. This is the FORTRAN unformatted record layout of the files from iongrid, so the
+	 *		maps from a text file can be used wherever the distributed binary files are.
+	 *
+	 *		INPUT
+	 *			int month - 0 to 11
+	 *			float ****foF2
+	 *			float ****M3kF2
+	 *			char DataFilePath[256] - Directory of the data files
+	 *			int silent
+	 *
+	 *		OUTPUT
+	 *			Writes DataFilePath/ionosXX.bin
+	 *			returns RTN_READIONPARAOK or RTN_ERRWRITEIONPARAMETERS
+	 *
+	 */
+
+	static char const overhead[10] = {0};
+
+	float ****map;
+	float * writeBuffer;
+
+	int	i, j, k, m, n;
+	int	hrs, lng, lat, ssn; // Temp gridmap maxima
+	int numfoF2;
+	int ok;
+
+	char OutFilePath[256];
+	char MapFile[32];
+
+	FILE *fp;
+
+	hrs = 24;	// 24 hours
+	lng = 241;	// 241 longitudes at 1.5-degree increments
+	lat = 121;	// 121 latitudes at 1.5-degree increments
+	ssn = 2;	// 2 SSN (12-month smoothed sun spot numbers) high and low
+	numfoF2 = hrs * lng * lat * ssn;
+
+	strcpy(OutFilePath, DataFilePath);
+	sprintf(MapFile, "ionos%02d.bin", month+1);
+	strcat(OutFilePath, MapFile);
+
+	writeBuffer = (float *) malloc(sizeof(float) * numfoF2);
+	if(writeBuffer == NULL) return RTN_ERRWRITEIONPARAMETERS;
+
+	fp = fopen(OutFilePath, "wb");
+	if(fp == NULL) {
+		printf("WriteIonParametersBin: ERROR Can't create %s\n", OutFilePath);
+		free(writeBuffer);
+		return RTN_ERRWRITEIONPARAMETERS;
+	}
+
+	if(silent != TRUE) {
+		printf("WriteIonParametersBin: Writing file ionos%02d.bin\n", month+1);
+	}
+
+	// The first 5 bytes of the file are overhead that FORTRAN puts in
+	ok = (fwrite(overhead, sizeof(char), 5, fp) == 5);
+
+	for(n = 0; n < 2; n++) {
+		map = (n == 0) ? foF2 : M3kF2;
+		// The transpose of the loops in ReadIonParametersBin()
+		for(m = 0; m < ssn; m++) { // SSN
+			for(j = 0; j < lng; j++) { // Longitude
+				for(k = 0; k < lat; k++) { // Latitude
+					for(i = 0; i < hrs; i++) { // Hour
+						writeBuffer[(m * (lng * lat * hrs)) + (j * (lat * hrs)) + (k * (hrs)) + i] = map[i][j][k][m];
+					}
+				}
+			}
+		}
+		ok = ok && (fwrite(writeBuffer, sizeof(float), numfoF2, fp) == (size_t)numfoF2);
+		// The tail of the foF2 record and the header of the M(3000)F2 record, then the tail of the M(3000)F2 record
+		ok = ok && (fwrite(overhead, sizeof(char), (n == 0) ? 10 : 5, fp) == (size_t)((n == 0) ? 10 : 5));
+	}
+
+	free(writeBuffer);
+	ok = (fclose(fp) == 0) && ok;
+	if(!ok) {
+		printf("WriteIonParametersBin: ERROR Can't write %s\n", OutFilePath);
+		remove(OutFilePath);
+		return RTN_ERRWRITEIONPARAMETERS;
+	}
+
+	return RTN_READIONPARAOK;
 }
 
 int ReadIonParametersBin(int month, float ****foF2, float ****M3kF2, char DataFilePath[256], int silent) {
@@ -223,7 +521,9 @@ int ReadIonParametersBin(int month, float ****foF2, float ****M3kF2, char DataFi
 	sprintf(MapFile, "ionos%02d.bin", month+1);
 	// Glue on the filenake of the coefficient file
 	strcat(InFilePath, MapFile);
-	fp = fopen(InFilePath, "rb"); 
+	// Use the map compiled into the library if there is one (See EmbeddedData.c)
+	fp = OpenEmbeddedData(MapFile);
+	if(fp == NULL) fp = fopen(InFilePath, "rb"); 
 	if(fp == NULL) {
 		printf("ReadIonParameters: ERROR Can't find input file %s\n", InFilePath);
 		return RTN_ERRREADIONPARAMETERS;
@@ -36,7 +36,9 @@ int ReadP1239(struct PathData *path, const char * DataFilePath) {
 	strcpy(InFilePath, DataFilePath);
 	strcat(InFilePath, "P1239-3 Decile Factors.txt");   
 
-	fp = fopen (InFilePath, "r");  // Open the file. Home
+	// Use the file compiled into the library if there is one (See EmbeddedData.c)
+	fp = OpenEmbeddedData("P1239-3 Decile Factors.txt");
+	if(fp == NULL) fp = fopen (InFilePath, "r");  // Open the file. Home
 	if(fp == NULL) {
 		printf("ReadP1239: ERROR Can't find input file 'P1239-3 Decile Factors.txt'\n");
 		printf("\t\t<%s>\n", InFilePath);
@@ -161,7 +161,6 @@ int ReadType13(struct Antenna *Ant, FILE * fp, double bearing, int silent) {
 
 	int i, j;					// Loop counters
 	int freqn, azin, elen;		// Number of freqs, elevations and azimuths
-	int iazi;					// Offset azimuth counter
 	int iMBOS;				// Integer offset of the main beam azimuth
 	int iI = 0;				// Temp
 
@@ -178,7 +177,10 @@ int ReadType13(struct Antenna *Ant, FILE * fp, double bearing, int silent) {
 	// pattern would be interpolated. In this implementation the pattern will be rotated to the nearest
 	// integer azimuth degree. This approximate method was chosen because of the error of having the
 	// pattern off by maximally +- 1/2 degree is considered to be minimal.
+	// The pattern is stored as it is in the file and AntennaGain() applies the rotation, so that the
+	// pattern can be shared by paths with different bearings (See RegisterAntenna()).
 	iMBOS = (int)(bearing*R2D);
+	Ant->rotation = ((iMBOS%360) + 360)%360;
 
 	// Read a VOACAP antenna pattern Type 13 file
 	/*
@@ -236,21 +238,18 @@ int ReadType13(struct Antenna *Ant, FILE * fp, double bearing, int silent) {
 	 */
 
 	for(i=0; i<azin; i++) {
-		// Advance to the next azimuth and roll it over if necessary.
-		iazi = (iMBOS+i)%360;
-
 		fgets(line, sizeof(line), fp);
 		sscanf(line, " %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf",
-			&iI, &Ant->pattern[0][iazi][0], &Ant->pattern[0][iazi][1], &Ant->pattern[0][iazi][2], &Ant->pattern[0][iazi][3], &Ant->pattern[0][iazi][4],
-			     &Ant->pattern[0][iazi][5], &Ant->pattern[0][iazi][6], &Ant->pattern[0][iazi][7], &Ant->pattern[0][iazi][8], &Ant->pattern[0][iazi][9]);
+			&iI, &Ant->pattern[0][i][0], &Ant->pattern[0][i][1], &Ant->pattern[0][i][2], &Ant->pattern[0][i][3], &Ant->pattern[0][i][4],
+			     &Ant->pattern[0][i][5], &Ant->pattern[0][i][6], &Ant->pattern[0][i][7], &Ant->pattern[0][i][8], &Ant->pattern[0][i][9]);
 		for(j=10; j<90; j += 10) {
 			fgets(line, sizeof(line), fp);
 			sscanf(line, " %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf",
-				&Ant->pattern[0][iazi][j],   &Ant->pattern[0][iazi][j+1], &Ant->pattern[0][iazi][j+2], &Ant->pattern[0][iazi][j+3], &Ant->pattern[0][iazi][j+4],
-				&Ant->pattern[0][iazi][j+5], &Ant->pattern[0][iazi][j+6], &Ant->pattern[0][iazi][j+7], &Ant->pattern[0][iazi][j+8], &Ant->pattern[0][iazi][j+9]);
+				&Ant->pattern[0][i][j],   &Ant->pattern[0][i][j+1], &Ant->pattern[0][i][j+2], &Ant->pattern[0][i][j+3], &Ant->pattern[0][i][j+4],
+				&Ant->pattern[0][i][j+5], &Ant->pattern[0][i][j+6], &Ant->pattern[0][i][j+7], &Ant->pattern[0][i][j+8], &Ant->pattern[0][i][j+9]);
 		}
         fgets(line, sizeof(line), fp);
-		sscanf(line, " %lf\n", &Ant->pattern[0][iazi][90]);
+		sscanf(line, " %lf\n", &Ant->pattern[0][i][90]);
 	}
 
     return RTN_READANTENNAPATTERNSOK;
@@ -19,6 +19,34 @@ int ValidatePath(struct PathData *path) {
 		OUTPUT
 		returns an integer representing the validity of the data
 
+		SUBROUTINES
+		ValidateCircuit()
+		ValidateReceiver()
+
+		*/
+
+	int retval;
+
+	retval = ValidateCircuit(path);
+	if (retval != RTN_VALIDDATAOK) return retval;
+
+	return ValidateReceiver(path->L_rx);
+
+}
+
+int ValidateCircuit(struct PathData *path) {
+
+	/*
+
+		ValidateCircuit() - Checks all of the data in the path for correct input except the receiver location.
+			P533Batch() uses this to check the inputs that are common to all of the receivers once.
+
+		INPUT
+		struct PathData *path
+
+		OUTPUT
+		returns an integer representing the validity of the data
+
 		SUBROUTINES
 		None
 
@@ -42,6 +70,7 @@ int ValidatePath(struct PathData *path) {
 
 	if (path->foF2 == NULL)												return RTN_ERRNOFOF2DATA;
 	if (path->M3kF2 == NULL)											return RTN_ERRNOM3KF2DATA;
+	if (path->ionmap == NULL)											return RTN_ERRNOFOF2DATA;
 	if (path->noiseP.dud == NULL)										return RTN_ERRNODUDDATA;
 	if (path->noiseP.fam == NULL)										return RTN_ERRNOFAMDATA;
 	if (path->foF2var == NULL)											return RTN_ERRNOFOF2VARDATA;
@@ -58,7 +87,6 @@ int ValidatePath(struct PathData *path) {
 	if ((0.0 > path->TW) || (path->TW > 50.0))							return RTN_ERRTW;
 	if ((0.0 > path->FW) || (path->FW > 1000))							return RTN_ERRFW;
 	if ((fabs(path->L_tx.lat) > PI / 2.0) || (fabs(path->L_tx.lng) > PI))	return RTN_ERRLTX;
-	if ((fabs(path->L_rx.lat) > PI / 2.0) || (fabs(path->L_rx.lng) > PI))	return RTN_ERRLRX;
 	if (path->A_rx.pattern == NULL)										return RTN_ERRRXANTENNAPATTERN;
 	if (path->A_tx.pattern == NULL)										return RTN_ERRTXANTENNAPATTERN;
 	if ((1 > path->SNRXXp) || (path->SNRXXp > 99))					 	return RTN_ERRSNRXXP;
@@ -67,3 +95,26 @@ int ValidatePath(struct PathData *path) {
 	return RTN_VALIDDATAOK;
 
 }
+
+int ValidateReceiver(struct Location L_rx) {
+
+	/*
+
+		ValidateReceiver() - Checks the receiver location.
+
+		INPUT
+		struct Location L_rx
+
+		OUTPUT
+		returns RTN_VALIDDATAOK or RTN_ERRLRX
+
+		SUBROUTINES
+		None
+
+		*/
+
+	if ((fabs(L_rx.lat) > PI / 2.0) || (fabs(L_rx.lng) > PI))			return RTN_ERRLRX;
+
+	return RTN_VALIDDATAOK;
+
+}